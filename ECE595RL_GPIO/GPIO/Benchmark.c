@@ -0,0 +1,257 @@
+/**
+ * @file Benchmark.c
+ * @brief Source code for the Benchmark driver.
+ *
+ * This file contains the function definitions for measuring the input-to-output latency.
+ * TA3_0_IRQHandler and TA3_N_IRQHandler override the weak definitions found in startup_msp432p401r_ccs.c.
+ *
+ * Timer_A3 runs in continuous mode. CCR0 and CCR1 capture the strobe and the frame marker,
+ * and CCR2 is a compare channel that schedules the next step of the measurement every BENCHMARK_PERIOD counts:
+ *
+ *  SETTLE  --(BENCHMARK_SETTLE_PERIODS)-->  ARMED  --(random delay)-->  WAIT  --(marker edge or timeout)-->  SETTLE
+ *
+ * When all samples of a pattern are measured, the state machine stops in DONE until Benchmark_Poll
+ * has computed the statistics.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/GPIO_Pins.h"
+#include "../inc/Benchmark.h"
+#include "../inc/RamFunc.h"
+
+#ifdef BENCHMARK_ENABLE
+
+// Loopback pins
+#define BENCHMARK_STIMULUS_PINS     0x0F    // P4.0 - P4.3
+#define BENCHMARK_STROBE_PIN        0x10    // P4.4
+#define BENCHMARK_CAPTURE_PINS      0x30    // P10.4 (TA3.CCI0A) and P10.5 (TA3.CCI1A)
+
+// Timer_A3 counts SMCLK/8 = 1.5 MHz, so one count is 2000 / 3 ns
+#define BENCHMARK_COUNTS_TO_NS(counts)  (((counts) * 2000) / 3)
+
+// Scheduling period of CCR2 (10 ms), time on the base pattern before each stimulus (200 ms),
+// and time without an output change after which the stimulus is counted as a timeout (40 ms).
+// The timeout must be shorter than the 16-bit timer period (43.7 ms).
+#define BENCHMARK_PERIOD            15000
+#define BENCHMARK_SETTLE_PERIODS    20
+#define BENCHMARK_TIMEOUT_PERIODS   4
+
+// Largest pseudo-random delay of the stimulus (1.37 ms, more than one tick)
+#define BENCHMARK_DELAY_MASK        0x07FF
+
+// States of the measurement
+#define BENCHMARK_STATE_SETTLE      0
+#define BENCHMARK_STATE_ARMED       1
+#define BENCHMARK_STATE_WAIT        2
+#define BENCHMARK_STATE_DONE        3
+
+// Switch status of every measured pattern, and the base pattern (LED_Pattern_1, held)
+static const uint8_t Benchmark_Targets[BENCHMARK_PATTERN_COUNT] = { 0x01, 0x02, 0x04, 0x08 };
+#define BENCHMARK_BASE              0x00
+
+static const GPIO_Pin Benchmark_Pins[] =
+{
+    GPIO_PIN(4,     BENCHMARK_STIMULUS_PINS | BENCHMARK_STROBE_PIN,   GPIO_PINS_OUTPUT,   GPIO_PINS_PULL_NONE,    GPIO_PINS_DRIVE_REGULAR,    0x00),  // Stimulus and strobe
+    GPIO_PIN(5,     0x01,   GPIO_PINS_OUTPUT,   GPIO_PINS_PULL_NONE,    GPIO_PINS_DRIVE_REGULAR,    0x00),  // Frame marker
+    GPIO_PIN(10,    0x30,   GPIO_PINS_INPUT,    GPIO_PINS_PULL_NONE,    GPIO_PINS_DRIVE_REGULAR,    0x00)   // Capture inputs
+};
+
+Benchmark_Result Benchmark_Results[BENCHMARK_PATTERN_COUNT];
+
+// Latencies of the pattern being measured, in timer counts
+static uint16_t Benchmark_Samples[BENCHMARK_SAMPLE_COUNT];
+static volatile uint16_t Benchmark_Sample_Count;
+static volatile uint16_t Benchmark_Timeouts;
+static uint32_t Benchmark_Target;
+
+static volatile uint8_t Benchmark_State;
+static uint8_t Benchmark_Periods;
+static uint16_t Benchmark_Random = 0xACE1;
+
+// Timer count captured on the rising edge of the strobe
+static volatile uint16_t Benchmark_Stimulus_Time;
+static volatile uint8_t Benchmark_Stimulus_Captured;
+
+/**
+ * @brief The Benchmark_Return function restores the base pattern and waits before the next stimulus.
+ *
+ * @param None
+ *
+ * @return None
+ */
+RAMFUNC static void Benchmark_Return(void)
+{
+    P4->OUT = BENCHMARK_BASE;
+    Benchmark_Periods = BENCHMARK_SETTLE_PERIODS;
+    Benchmark_State = (Benchmark_Sample_Count < BENCHMARK_SAMPLE_COUNT) ? BENCHMARK_STATE_SETTLE : BENCHMARK_STATE_DONE;
+}
+
+void Benchmark_Init(uint32_t priority)
+{
+    GPIO_Pins_Init(Benchmark_Pins, GPIO_PINS_COUNT(Benchmark_Pins));
+
+    // Select the Timer_A3 capture function of P10.4 and P10.5
+    P10->SEL0 |= BENCHMARK_CAPTURE_PINS;
+    P10->SEL1 &= ~BENCHMARK_CAPTURE_PINS;
+
+    for (uint32_t index = 0; index < BENCHMARK_PATTERN_COUNT; index++)
+    {
+        Benchmark_Results[index].switch_status = Benchmark_Targets[index];
+        Benchmark_Results[index].samples = 0;
+        Benchmark_Results[index].timeouts = 0;
+    }
+    Benchmark_Target = 0;
+    Benchmark_Sample_Count = 0;
+    Benchmark_Timeouts = 0;
+    Benchmark_Return();
+
+    // CCR0: capture on the rising edge of CCI0A, synchronous, interrupt enabled
+    // CCR1: capture on both edges of CCI1A, synchronous, interrupt enabled
+    // CCR2: compare, interrupt enabled
+    TIMER_A3->CTL = 0x02C4;                 // SMCLK, /8, stop mode, TACLR
+    TIMER_A3->CCTL[0] = 0x4910;
+    TIMER_A3->CCTL[1] = 0xC910;
+    TIMER_A3->CCR[2] = BENCHMARK_PERIOD;
+    TIMER_A3->CCTL[2] = 0x0010;
+
+    NVIC_SetPriority(TA3_0_IRQn, priority);
+    NVIC_SetPriority(TA3_N_IRQn, priority);
+    NVIC_EnableIRQ(TA3_0_IRQn);
+    NVIC_EnableIRQ(TA3_N_IRQn);
+
+    TIMER_A3->CTL = 0x02E4;                 // SMCLK, /8, continuous mode, TACLR
+}
+
+void Benchmark_Poll(void)
+{
+    if ((Benchmark_State != BENCHMARK_STATE_DONE) || (Benchmark_Target >= BENCHMARK_PATTERN_COUNT))
+    {
+        return;
+    }
+
+    // Sort the samples (insertion sort, the samples are nearly uniform), then take the nearest-rank percentile
+    uint32_t total = 0;
+    for (uint32_t index = 0; index < BENCHMARK_SAMPLE_COUNT; index++)
+    {
+        uint16_t sample = Benchmark_Samples[index];
+        uint32_t position = index;
+        while ((position > 0) && (Benchmark_Samples[position - 1] > sample))
+        {
+            Benchmark_Samples[position] = Benchmark_Samples[position - 1];
+            position = position - 1;
+        }
+        Benchmark_Samples[position] = sample;
+        total = total + sample;
+    }
+
+    Benchmark_Result *result = &Benchmark_Results[Benchmark_Target];
+    result->timeouts = Benchmark_Timeouts;
+    result->min_ns = BENCHMARK_COUNTS_TO_NS((uint32_t)Benchmark_Samples[0]);
+    result->mean_ns = BENCHMARK_COUNTS_TO_NS(total / BENCHMARK_SAMPLE_COUNT);
+    result->max_ns = BENCHMARK_COUNTS_TO_NS((uint32_t)Benchmark_Samples[BENCHMARK_SAMPLE_COUNT - 1]);
+    result->p99_ns = BENCHMARK_COUNTS_TO_NS((uint32_t)Benchmark_Samples[((BENCHMARK_SAMPLE_COUNT * 99) + 99) / 100 - 1]);
+    result->samples = BENCHMARK_SAMPLE_COUNT;
+
+    // Start the next pattern. The base pattern is already displayed.
+    Benchmark_Target = Benchmark_Target + 1;
+    if (Benchmark_Target < BENCHMARK_PATTERN_COUNT)
+    {
+        Benchmark_Sample_Count = 0;
+        Benchmark_Timeouts = 0;
+        Benchmark_Periods = BENCHMARK_SETTLE_PERIODS;
+        Benchmark_State = BENCHMARK_STATE_SETTLE;
+    }
+}
+
+uint8_t Benchmark_Get_Result(uint32_t index, Benchmark_Result *result)
+{
+    if ((index >= BENCHMARK_PATTERN_COUNT) || (Benchmark_Results[index].samples != BENCHMARK_SAMPLE_COUNT))
+    {
+        return 0;
+    }
+    *result = Benchmark_Results[index];
+    return 1;
+}
+
+RAMFUNC void TA3_0_IRQHandler(void)
+{
+    TIMER_A3->CCTL[0] &= ~0x0001;           // clear CCIFG
+    if (Benchmark_State == BENCHMARK_STATE_WAIT)
+    {
+        Benchmark_Stimulus_Time = TIMER_A3->CCR[0];
+        Benchmark_Stimulus_Captured = 1;
+    }
+}
+
+RAMFUNC void TA3_N_IRQHandler(void)
+{
+    // Reading TA3IV clears the flag of the highest pending interrupt
+    uint16_t vector = TIMER_A3->IV;
+
+    if (vector == 0x02)
+    {
+        // Frame marker edge: the first one after the stimulus ends the sample
+        uint16_t response_time = TIMER_A3->CCR[1];
+        if ((Benchmark_State == BENCHMARK_STATE_WAIT) && Benchmark_Stimulus_Captured)
+        {
+            Benchmark_Samples[Benchmark_Sample_Count] = response_time - Benchmark_Stimulus_Time;
+            Benchmark_Sample_Count = Benchmark_Sample_Count + 1;
+            Benchmark_Return();
+        }
+    }
+    else if (vector == 0x04)
+    {
+        uint16_t next = TIMER_A3->CCR[2] + BENCHMARK_PERIOD;
+
+        if (Benchmark_State == BENCHMARK_STATE_SETTLE)
+        {
+            Benchmark_Periods = Benchmark_Periods - 1;
+            if (Benchmark_Periods == 0)
+            {
+                // Galois LFSR (x^16 + x^14 + x^13 + x^11 + 1) for the delay of the stimulus
+                Benchmark_Random = (Benchmark_Random >> 1) ^ ((0 - (Benchmark_Random & 0x0001)) & 0xB400);
+                next = TIMER_A3->CCR[2] + 1 + (Benchmark_Random & BENCHMARK_DELAY_MASK);
+                Benchmark_State = BENCHMARK_STATE_ARMED;
+            }
+        }
+        else if (Benchmark_State == BENCHMARK_STATE_ARMED)
+        {
+            // The stimulus and the strobe change in the same store
+            Benchmark_Stimulus_Captured = 0;
+            Benchmark_Periods = BENCHMARK_TIMEOUT_PERIODS;
+            Benchmark_State = BENCHMARK_STATE_WAIT;
+            P4->OUT = Benchmark_Targets[Benchmark_Target] | BENCHMARK_STROBE_PIN;
+        }
+        else if (Benchmark_State == BENCHMARK_STATE_WAIT)
+        {
+            Benchmark_Periods = Benchmark_Periods - 1;
+            if (Benchmark_Periods == 0)
+            {
+                Benchmark_Timeouts = Benchmark_Timeouts + 1;
+                Benchmark_Return();
+            }
+        }
+
+        TIMER_A3->CCR[2] = next;
+    }
+}
+
+#else
+
+void Benchmark_Init(uint32_t priority)
+{
+}
+
+void Benchmark_Poll(void)
+{
+}
+
+uint8_t Benchmark_Get_Result(uint32_t index, Benchmark_Result *result)
+{
+    return 0;
+}
+
+#endif /* BENCHMARK_ENABLE */
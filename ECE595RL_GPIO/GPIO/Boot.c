@@ -0,0 +1,118 @@
+/**
+ * @file Boot.c
+ * @brief Source code for the Boot driver.
+ *
+ * This file contains the function definitions for measuring the boot time of the GPIO program.
+ * The elapsed time is accumulated in ns at the MCLK frequency of every interval, because
+ * CYCCNT counts 3 MHz cycles before Clock_Init48MHz_Finish and 48 MHz cycles afterwards.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Boot.h"
+#include "../inc/Clock.h"
+#include "../inc/RamFunc.h"
+
+uint32_t Boot_Times_us[BOOT_STAGE_COUNT];
+
+// Time accumulated up to Boot_Last_Cycles in ns
+static uint64_t Boot_Elapsed_ns = 0;
+
+// Value of the cycle counter at the end of the last interval
+static uint32_t Boot_Last_Cycles = 0;
+
+// MCLK frequency of the current interval in MHz
+static uint32_t Boot_Clock_MHz = 3;
+
+// Bit n is set once stage n has been recorded
+static volatile uint32_t Boot_Recorded = 0;
+
+/**
+ * @brief The Boot_Accumulate function adds the cycles since the last interval to the elapsed time.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Boot_Accumulate(void)
+{
+    uint32_t cycles = DWT->CYCCNT;
+    Boot_Elapsed_ns = Boot_Elapsed_ns + (((uint64_t)(cycles - Boot_Last_Cycles) * 1000) / Boot_Clock_MHz);
+    Boot_Last_Cycles = cycles;
+}
+
+void Boot_Init(void)
+{
+    // Enable the trace block and the cycle counter, which is shared with the Profile and Trace drivers
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint32_t stage = 0; stage < BOOT_STAGE_COUNT; stage++)
+    {
+        Boot_Times_us[stage] = 0;
+    }
+    Boot_Elapsed_ns = 0;
+    Boot_Last_Cycles = DWT->CYCCNT;
+    Boot_Clock_MHz = Clock_GetFreq() / 1000000;
+    Boot_Recorded = 0;
+}
+
+void Boot_Mark(uint32_t stage)
+{
+    if ((stage >= BOOT_STAGE_COUNT) || (Boot_Recorded & (1 << stage)))
+    {
+        return;
+    }
+
+    // The stages are recorded by main, SysTick_Handler, and CS_IRQHandler, and the clock listeners
+    // can be called with interrupts disabled (Clock_SetProfile), so PRIMASK is restored instead of cleared
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Boot_Accumulate();
+    Boot_Times_us[stage] = (uint32_t)(Boot_Elapsed_ns / 1000);
+    Boot_Recorded = Boot_Recorded | (1 << stage);
+    Boot_Clock_MHz = Clock_GetFreq() / 1000000;
+    __set_PRIMASK(primask);
+}
+
+void Boot_Clock_Changed(uint32_t frequency)
+{
+    if (Boot_Recorded & (1 << BOOT_STAGE_FIRST_OUTPUT))
+    {
+        return;
+    }
+
+    // The first change is the switch from the DCO to the 48 MHz crystal
+    if (!(Boot_Recorded & (1 << BOOT_STAGE_CLOCK_READY)))
+    {
+        Boot_Mark(BOOT_STAGE_CLOCK_READY);
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Boot_Accumulate();
+    Boot_Clock_MHz = frequency / 1000000;
+    __set_PRIMASK(primask);
+}
+
+RAMFUNC void Boot_Output_Changed(void)
+{
+    if (Boot_Recorded & (1 << BOOT_STAGE_FIRST_OUTPUT))
+    {
+        return;
+    }
+
+    Boot_Mark(BOOT_STAGE_FIRST_OUTPUT);
+}
+
+uint32_t Boot_Get_Time(uint32_t stage)
+{
+    if (stage >= BOOT_STAGE_COUNT)
+    {
+        return 0;
+    }
+    return Boot_Times_us[stage];
+}
@@ -44,30 +44,57 @@ policies, either expressed or implied, of the FreeBSD Project.
 #include <stdint.h>
 #include "msp.h"
 #include "../inc/Clock.h"
+#include "../inc/RamFunc.h"
 
 uint32_t ClockFrequency = 3000000; // cycles/second
 //static uint32_t SubsystemFrequency = 3000000; // cycles/second
 
-// ------------Clock_InitFastest------------
-// Configure the system clock to run at the fastest
-// and most accurate settings.  For example, if the
-// LaunchPad has a crystal, it should be used here.
-// Call BSP_Clock_GetFreq() to get the current system
-// clock frequency for the LaunchPad.
-// Input: none
-// Output: none
+static void Clock_Notify(uint32_t frequency);
+
+static volatile Clock_Status ClockStatus = {CLOCK_STATE_DCO, CLOCK_ERROR_NONE, 0, 0};
+static volatile uint32_t ClockRequested = 0;  // frequency requested by Clock_SetProfile while starting, 0 if none
+
+// Time after which Clock_Init48MHz_Async gives up on the crystal
+#define CLOCK_ASYNC_TIMEOUT_MS  50
+
 uint32_t Prewait = 0;                   // loops between BSP_Clock_InitFastest() called and PCM idle (expect 0)
 uint32_t CPMwait = 0;                   // loops between Power Active Mode Request and Current Power Mode matching requested mode (expect small)
 uint32_t Postwait = 0;                  // loops between Current Power Mode matching requested mode and PCM module idle (expect about 0)
 uint32_t IFlags = 0;                    // non-zero if transition is invalid
 uint32_t Crystalstable = 0;             // loops before the crystal stabilizes (expect small)
-void Clock_Init48MHz(void){
+
+// ------------Clock_Fail------------
+// Record a failed switch to 48 MHz.  The crystal and
+// the interrupts of Clock_Init48MHz_Async are turned off,
+// and MCLK stays at 3 MHz (ClockFrequency is unchanged).
+// Input: error, one of the CLOCK_ERROR_ constants
+// Output: none
+static void Clock_Fail(uint32_t error){
+  TIMER32_2->CONTROL = 0;               // stop the time out
+  NVIC_DisableIRQ(T32_INT2_IRQn);
+  PCM->IE &= ~0x00000004;
+  CS->KEY = 0x695A;                     // unlock CS module for register access
+  CS->IE &= ~0x00000200;                // disable the HFXT start fault counter interrupt
+  CS->CTL3 &= ~0x00000080;              // disable the HFXT start fault counter
+  CS->CTL2 &= ~0x01000000;              // disable HFXT
+  CS->KEY = 0;                          // lock CS module from unintended access
+  ClockStatus.error = error;
+  ClockStatus.state = CLOCK_STATE_FAILED;
+}
+
+// ------------Clock_RequestVcore1------------
+// Wait for the PCM to be idle, then request power active
+// mode LDO VCORE1 to support the 48 MHz frequency.
+// Input: none
+// Output: 1 if requested, 0 on failure (recorded with Clock_Fail)
+static uint32_t Clock_RequestVcore1(void){
   // wait for the PCMCTL0 and Clock System to be write-able by waiting for Power Control Manager to be idle
   while(PCM->CTL1&0x00000100){
 //  while(PCMCTL1&0x00000100){
     Prewait = Prewait + 1;
     if(Prewait >= 100000){
-      return;                           // time out error
+      Clock_Fail(CLOCK_ERROR_PCM_BUSY);
+      return 0;                         // time out error
     }
   }
   // request power active mode LDO VCORE1 to support the 48 MHz frequency
@@ -75,28 +102,35 @@ void Clock_Init48MHz(void){
 //  PCMCTL0 = (PCMCTL0&~0xFFFF000F) |     // clear PCMKEY bit field and AMR bit field
             0x695A0000 |                // write the proper PCM key to unlock write access
             0x00000001;                 // request power active mode LDO VCORE1
-  // check if the transition is invalid (see Figure 7-3 on p344 of datasheet)
+  return 1;
+}
+
+// ------------Clock_CheckTransition------------
+// Check if the active mode transition is invalid (see
+// Figure 7-3 on p344 of datasheet).
+// Input: none
+// Output: 1 if valid, 0 if invalid (recorded with Clock_Fail)
+static uint32_t Clock_CheckTransition(void){
   if(PCM->IFG&0x00000004){
     IFlags = PCM->IFG;                    // bit 2 set on active mode transition invalid; bits 1-0 are for LPM-related errors; bit 6 is for DC-DC-related error
     PCM->CLRIFG = 0x00000004;             // clear the transition invalid flag
     // to do: look at CPM bit field in PCMCTL0, figure out what mode you're in, and step through the chart to transition to the mode you want
     // or be lazy and do nothing; this should work out of reset at least, but it WILL NOT work if Clock_Int32kHz() or Clock_InitLowPower() has been called
-    return;
-  }
-  // wait for the CPM (Current Power Mode) bit field to reflect a change to active mode LDO VCORE1
-  while((PCM->CTL0&0x00003F00) != 0x00000100){
-    CPMwait = CPMwait + 1;
-    if(CPMwait >= 500000){
-      return;                           // time out error
-    }
-  }
-  // wait for the PCMCTL0 and Clock System to be write-able by waiting for Power Control Manager to be idle
-  while(PCM->CTL1&0x00000100){
-    Postwait = Postwait + 1;
-    if(Postwait >= 100000){
-      return;                           // time out error
-    }
+    ClockStatus.pcm_flags = IFlags;
+    Clock_Fail(CLOCK_ERROR_PCM_INVALID);
+    return 0;
   }
+  return 1;
+}
+
+// ------------Clock_StartHFXT------------
+// Initialize PJ.3 and PJ.2 and enable the built-in 48 MHz
+// crystal (HFXT).  The crystal only clocks MCLK once
+// VCORE1 is reached, so it can start during the VCORE
+// transition.
+// Input: none
+// Output: none
+static void Clock_StartHFXT(void){
   // initialize PJ.3 and PJ.2 and make them HFXT (PJ.3 built-in 48 MHz crystal out; PJ.2 built-in 48 MHz crystal in)
   PJ->SEL0 |= 0x0C;
   PJ->SEL1 &= ~0x0C;                    // configure built-in 48 MHz crystal for HFXT operation
@@ -108,26 +142,254 @@ void Clock_Init48MHz(void){
            0x00010000 |                 // HFXT oscillator drive selection for crystals >4 MHz
            0x01000000;                  // enable HFXT
   CS->CTL2 &= ~0x02000000;              // disable high-frequency crystal bypass
-  // wait for the HFXT clock to stabilize
-  while(CS->IFG&0x00000002){
-    CS->CLRIFG = 0x00000002;              // clear the HFXT oscillator interrupt flag
-    Crystalstable = Crystalstable + 1;
-    if(Crystalstable > 100000){
-      return;                           // time out error
+  CS->KEY = 0;                          // lock CS module from unintended access
+}
+
+// ------------Clock_WaitVcore1------------
+// Wait for the CPM (Current Power Mode) bit field to
+// reflect the change to active mode LDO VCORE1, and for
+// the PCM to be idle again.
+// Input: none
+// Output: 1 if VCORE1 is reached, 0 on time out (recorded with Clock_Fail)
+static uint32_t Clock_WaitVcore1(void){
+  // wait for the CPM (Current Power Mode) bit field to reflect a change to active mode LDO VCORE1
+  while((PCM->CTL0&0x00003F00) != 0x00000100){
+    CPMwait = CPMwait + 1;
+    if(CPMwait >= 500000){
+      Clock_Fail(CLOCK_ERROR_VCORE_TIMEOUT);
+      return 0;                         // time out error
     }
   }
+  // wait for the PCMCTL0 and Clock System to be write-able by waiting for Power Control Manager to be idle
+  while(PCM->CTL1&0x00000100){
+    Postwait = Postwait + 1;
+    if(Postwait >= 100000){
+      Clock_Fail(CLOCK_ERROR_VCORE_TIMEOUT);
+      return 0;                         // time out error
+    }
+  }
+  return 1;
+}
+
+// ------------Clock_SelectHFXT------------
+// Set 2 flash wait states and source MCLK, HSMCLK, and
+// SMCLK from the stable crystal.  ClockFrequency and
+// SystemCoreClock are updated, and the functions
+// registered with Clock_AddListener are called.  Then,
+// the frequency requested by Clock_SetProfile() during
+// the switch is applied.
+// Input: none
+// Output: none
+static void Clock_SelectHFXT(void){
+  uint32_t frequency;
   // configure for 2 wait states (minimum for 48 MHz operation) for flash Bank 0
   FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL&~0x0000F000)|FLCTL_BANK0_RDCTL_WAIT_2;
   // configure for 2 wait states (minimum for 48 MHz operation) for flash Bank 1
   FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL&~0x0000F000)|FLCTL_BANK1_RDCTL_WAIT_2;
-  CS->CTL1 = 0x20000000 |               // configure for SMCLK divider /4
+  CS->KEY = 0x695A;                     // unlock CS module for register access
+  // only SELM, SELS, SELA, DIVHS, and DIVS change, so the BCLK source (SELB) set by LowPower_Init is kept
+  CS->CTL1 = (CS->CTL1&~0x70700777) |   // clear DIVS, DIVHS, SELA, SELS, and SELM bit fields
+           0x20000000 |                 // configure for SMCLK divider /4
            0x00100000 |                 // configure for HSMCLK divider /2
            0x00000200 |                 // configure for ACLK sourced from REFOCLK
            0x00000050 |                 // configure for SMCLK and HSMCLK sourced from HFXTCLK
            0x00000005;                  // configure for MCLK sourced from HFXTCLK
   CS->KEY = 0;                          // lock CS module from unintended access
   ClockFrequency = 48000000;
+  SystemCoreClock = 48000000;
 //  SubsystemFrequency = 12000000;
+  ClockStatus.state = CLOCK_STATE_READY;
+  Clock_Notify(48000000);
+  frequency = ClockRequested;
+  ClockRequested = 0;
+  if(frequency != 0){
+    Clock_SetProfile(frequency);        // requested while the switch was in progress
+  }
+}
+
+// ------------Clock_Init48MHz_Start------------
+// Begin the switch to 48 MHz without waiting for it:
+// request power active mode LDO VCORE1 and start the
+// built-in 48 MHz crystal (HFXT). MCLK keeps running
+// from the 3 MHz DCO, so the program can initialize
+// the peripherals while VCORE rises and the crystal
+// settles, then call Clock_Init48MHz_Finish().
+// Input: none
+// Output: none
+void Clock_Init48MHz_Start(void){
+  if(ClockStatus.state != CLOCK_STATE_DCO){
+    return;                             // already started
+  }
+  ClockStatus.state = CLOCK_STATE_STARTING;
+  if(Clock_RequestVcore1() == 0){
+    return;
+  }
+  if(Clock_CheckTransition() == 0){
+    return;
+  }
+  Clock_StartHFXT();
+}
+
+// ------------Clock_Init48MHz_Finish------------
+// Complete the switch started by Clock_Init48MHz_Start():
+// wait for VCORE1 and for the crystal to stabilize, set
+// the flash wait states, and source MCLK, HSMCLK, and
+// SMCLK from HFXT. The waits are short or empty if the
+// program did enough work since Clock_Init48MHz_Start().
+// On a failure, the clock stays at 3 MHz and the error
+// is reported by Clock_GetStatus().
+// Input: none
+// Output: none
+void Clock_Init48MHz_Finish(void){
+  if(ClockStatus.state != CLOCK_STATE_STARTING){
+    return;                             // Clock_Init48MHz_Start() failed or was not called
+  }
+  if(Clock_WaitVcore1() == 0){
+    return;
+  }
+  CS->KEY = 0x695A;                     // unlock CS module for register access
+  // wait for the HFXT clock to stabilize
+  while(CS->IFG&0x00000002){
+    CS->CLRIFG = 0x00000002;              // clear the HFXT oscillator interrupt flag
+    Crystalstable = Crystalstable + 1;
+    if(Crystalstable > 100000){
+      CS->KEY = 0;
+      Clock_Fail(CLOCK_ERROR_HFXT_TIMEOUT);
+      return;                           // time out error
+    }
+  }
+  CS->KEY = 0;                          // lock CS module from unintended access
+  Clock_SelectHFXT();
+}
+
+// ------------Clock_InitFastest------------
+// Configure the system clock to run at the fastest
+// and most accurate settings.  For example, if the
+// LaunchPad has a crystal, it should be used here.
+// Call BSP_Clock_GetFreq() to get the current system
+// clock frequency for the LaunchPad.
+// Input: none
+// Output: none
+void Clock_Init48MHz(void){
+  Clock_Init48MHz_Start();
+  Clock_Init48MHz_Finish();
+}
+
+// ------------Clock_Init48MHz_Async------------
+// Begin the switch to 48 MHz and return immediately.
+// The switch is completed by CS_IRQHandler once the HFXT
+// start fault counter has counted 16384 crystal cycles
+// without a fault.  An invalid VCORE1 request is reported
+// by PCM_IRQHandler, and T32_INT2_IRQHandler gives up
+// after CLOCK_ASYNC_TIMEOUT_MS.  Until then, MCLK keeps
+// running from the 3 MHz DCO and ClockFrequency is 3 MHz.
+// Input: priority, interrupt priority of the CS, PCM,
+//        and Timer32 module 2 interrupts (0 to 7)
+// Output: none
+void Clock_Init48MHz_Async(uint32_t priority){
+  if(ClockStatus.state != CLOCK_STATE_DCO){
+    return;                             // already started
+  }
+  ClockStatus.state = CLOCK_STATE_STARTING;
+  // report an invalid transition with the PCM interrupt
+  PCM->CLRIFG = 0x00000004;
+  PCM->IE |= 0x00000004;                // AM_INVALID_TR_IE
+  NVIC_SetPriority(PCM_IRQn, priority);
+  NVIC_EnableIRQ(PCM_IRQn);
+  if(Clock_RequestVcore1() == 0){
+    return;
+  }
+  if(ClockStatus.state != CLOCK_STATE_STARTING){
+    return;                             // PCM_IRQHandler found the transition invalid
+  }
+  Clock_StartHFXT();
+  // count 16384 HFXT cycles without a fault, then interrupt
+  CS->KEY = 0x695A;                     // unlock CS module for register access
+  CS->CLRIFG = 0x00000202;              // clear FCNTHFIFG and HFXTIFG
+  CS->CTL3 = (CS->CTL3&~0x000000F0) |
+           0x00000030 |                 // FCNTHF: 16384 cycles
+           0x00000080;                  // FCNTHF_EN: enable the HFXT start fault counter
+  CS->IE |= 0x00000200;                 // FCNTHFIE
+  CS->KEY = 0;                          // lock CS module from unintended access
+  NVIC_SetPriority(CS_IRQn, priority);
+  NVIC_EnableIRQ(CS_IRQn);
+  // time out in case the crystal does not oscillate, counted by Timer32 module 2 at 3 MHz
+  TIMER32_2->CONTROL = 0;               // disable during setup
+  TIMER32_2->LOAD = (ClockFrequency/1000)*CLOCK_ASYNC_TIMEOUT_MS;
+  TIMER32_2->INTCLR = 0;                // clear the interrupt flag
+  TIMER32_2->CONTROL = 0x000000A3;      // enable, free-running mode, interrupt, prescale /1, 32-bit counter, one-shot
+  NVIC_SetPriority(T32_INT2_IRQn, priority);
+  NVIC_EnableIRQ(T32_INT2_IRQn);
+}
+
+// ------------CS_IRQHandler------------
+// The HFXT start fault counter has expired.  If the
+// crystal faulted in the meantime, the counter is
+// restarted.  Otherwise, the switch to 48 MHz is
+// completed.
+// Input: none
+// Output: none
+void CS_IRQHandler(void){
+  CS->KEY = 0x695A;                     // unlock CS module for register access
+  CS->CLRIFG = 0x00000202;              // clear FCNTHFIFG and HFXTIFG
+  if(CS->IFG&0x00000002){               // HFXTIFG is set again while the crystal faults
+    ClockStatus.hfxt_restarts = ClockStatus.hfxt_restarts + 1;
+    CS->CTL3 |= 0x00000040;             // RFCNTHF: restart the HFXT start fault counter
+    CS->KEY = 0;
+    return;
+  }
+  CS->IE &= ~0x00000200;
+  CS->CTL3 &= ~0x00000080;
+  CS->KEY = 0;                          // lock CS module from unintended access
+  if(ClockStatus.state != CLOCK_STATE_STARTING){
+    return;
+  }
+  TIMER32_2->CONTROL = 0;               // stop the time out
+  NVIC_DisableIRQ(T32_INT2_IRQn);
+  if(Clock_CheckTransition() == 0){     // PCM_IRQHandler has not run yet
+    return;
+  }
+  if(Clock_WaitVcore1() == 0){          // VCORE1 normally takes much less time than the crystal
+    return;
+  }
+  Clock_SelectHFXT();
+}
+
+// ------------PCM_IRQHandler------------
+// Report an invalid VCORE1 request of
+// Clock_Init48MHz_Async().
+// Input: none
+// Output: none
+void PCM_IRQHandler(void){
+  PCM->IE &= ~0x00000004;
+  if(ClockStatus.state == CLOCK_STATE_STARTING){
+    Clock_CheckTransition();
+  }else{
+    PCM->CLRIFG = 0x00000004;
+  }
+}
+
+// ------------T32_INT2_IRQHandler------------
+// Give up on a crystal that did not stabilize within
+// CLOCK_ASYNC_TIMEOUT_MS of Clock_Init48MHz_Async().
+// Input: none
+// Output: none
+void T32_INT2_IRQHandler(void){
+  TIMER32_2->INTCLR = 0;                // clear the interrupt flag
+  if(ClockStatus.state == CLOCK_STATE_STARTING){
+    Clock_Fail(CLOCK_ERROR_HFXT_TIMEOUT);
+  }
+}
+
+// ------------Clock_GetStatus------------
+// Copy the progress of the switch to 48 MHz.
+// Input: status, structure that receives the status
+// Output: none
+void Clock_GetStatus(Clock_Status *status){
+  status->state = ClockStatus.state;
+  status->error = ClockStatus.error;
+  status->pcm_flags = ClockStatus.pcm_flags;
+  status->hfxt_restarts = ClockStatus.hfxt_restarts;
 }
 
 // ------------Clock_GetFreq------------
@@ -139,7 +401,173 @@ uint32_t Clock_GetFreq(void){
   return ClockFrequency;
 }
 
+#define CLOCK_MAX_LISTENERS 4
+static void (*ClockListeners[CLOCK_MAX_LISTENERS])(uint32_t frequency);
+static uint32_t ClockListenerCount = 0;
+
+// ------------Clock_AddListener------------
+// Register a function that is called by Clock_SetProfile
+// after the MCLK frequency has changed, so that modules
+// that count MCLK cycles (such as SysTick) can recompute
+// their periods.
+// Input: listener, function called with the new frequency in Hz
+// Output: 1 if registered, 0 if the listener table is full
+uint32_t Clock_AddListener(void(*listener)(uint32_t frequency)){
+  if(ClockListenerCount >= CLOCK_MAX_LISTENERS){
+    return 0;
+  }
+  ClockListeners[ClockListenerCount] = listener;
+  ClockListenerCount = ClockListenerCount + 1;
+  return 1;
+}
+
+// ------------Clock_Notify------------
+// Call the functions registered with Clock_AddListener
+// after the MCLK frequency has changed.
+// Input: frequency, new MCLK frequency in Hz
+// Output: none
+static void Clock_Notify(uint32_t frequency){
+  uint32_t i;
+  for(i=0; i<ClockListenerCount; i=i+1){
+    (*ClockListeners[i])(frequency);
+  }
+}
 
+// ------------Clock_RequestPowerMode------------
+// Request one active mode of the PCM and wait for the
+// transition to complete.  The request must be a single
+// valid step of the PCM transition chart (Figure 7-3 of
+// the datasheet).
+// Input: amr, requested active mode (0 = AM_LDO_VCORE0,
+//        1 = AM_LDO_VCORE1)
+// Output: 1 if the transition completed, 0 if it was
+//         invalid or timed out
+static uint32_t Clock_RequestPowerMode(uint32_t amr){
+  uint32_t wait = 0;
+  while(PCM->CTL1&0x00000100){          // wait for the PCM to be idle
+    wait = wait + 1;
+    if(wait >= 100000){
+      return 0;                         // time out error
+    }
+  }
+  PCM->CTL0 = (PCM->CTL0&~0xFFFF000F) | 0x695A0000 | amr;
+  if(PCM->IFG&0x00000004){
+    IFlags = PCM->IFG;
+    PCM->CLRIFG = 0x00000004;           // clear the transition invalid flag
+    return 0;
+  }
+  wait = 0;
+  while(((PCM->CTL0&0x00003F00)>>8) != amr){
+    wait = wait + 1;
+    if(wait >= 500000){
+      return 0;                         // time out error
+    }
+  }
+  wait = 0;
+  while(PCM->CTL1&0x00000100){
+    wait = wait + 1;
+    if(wait >= 100000){
+      return 0;                         // time out error
+    }
+  }
+  return 1;
+}
+
+// ------------Clock_SetVcore------------
+// Walk the PCM transition chart to the LDO active mode
+// with the requested core voltage.  The DC-DC and
+// low-frequency active modes can only change VCORE by
+// going through the LDO mode with the same VCORE first.
+// Input: vcore, 0 for VCORE0 (up to 24 MHz) or 1 for
+//        VCORE1 (up to 48 MHz)
+// Output: 1 on success, 0 on failure
+static uint32_t Clock_SetVcore(uint32_t vcore){
+  uint32_t cpm = (PCM->CTL0&0x00003F00)>>8;
+  if(cpm == vcore){
+    return 1;
+  }
+  if(cpm > 1){                          // AM_DCDC_VCOREx or AM_LF_VCOREx
+    if(Clock_RequestPowerMode(cpm&0x01) == 0){
+      return 0;
+    }
+  }
+  return Clock_RequestPowerMode(vcore);
+}
+
+// ------------Clock_SetWaitStates------------
+// Set the number of flash read wait states of both banks.
+// Input: wait, number of wait states (0 to 15)
+// Output: none
+static void Clock_SetWaitStates(uint32_t wait){
+  FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL&~0x0000F000)|(wait<<12);
+  FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL&~0x0000F000)|(wait<<12);
+}
+
+// ------------Clock_SetProfile------------
+// Change the MCLK frequency at run time by dividing the
+// 48 MHz HFXT clock.  VCORE and the flash wait states are
+// raised before the frequency goes up and lowered after
+// it goes down, so every intermediate setting is valid.
+// SMCLK, HSMCLK, and ACLK keep their frequencies.
+//
+//  Frequency  MCLK divider  VCORE  Flash wait states
+//  48 MHz     /1            1      2
+//  24 MHz     /2            0      1
+//  12 MHz     /4            0      0
+//   3 MHz     /16           0      0
+//
+// ClockFrequency and SystemCoreClock are updated, and the
+// functions registered with Clock_AddListener are called.
+// Clock_Init48MHz must have been called first.  While a
+// switch to 48 MHz is in progress (Clock_Init48MHz_Start
+// or Clock_Init48MHz_Async), the frequency is stored and
+// applied once the switch completes.
+// Input: frequency, 48000000, 24000000, 12000000, or 3000000
+// Output: 1 on success, 0 if the frequency is not supported,
+//         MCLK is not sourced from HFXT, or a PCM transition failed
+uint32_t Clock_SetProfile(uint32_t frequency){
+  uint32_t divm, vcore, wait, ok;
+  switch(frequency){
+    case 48000000: divm = 0; vcore = 1; wait = 2; break;
+    case 24000000: divm = 1; vcore = 0; wait = 1; break;
+    case 12000000: divm = 2; vcore = 0; wait = 0; break;
+    case 3000000:  divm = 4; vcore = 0; wait = 0; break;
+    default: return 0;
+  }
+  if(ClockStatus.state == CLOCK_STATE_STARTING){
+    ClockRequested = frequency;
+    if(ClockStatus.state == CLOCK_STATE_STARTING){
+      return 1;                         // applied by CS_IRQHandler once the crystal is stable
+    }
+  }
+  if((CS->CTL1&0x00000007) != 0x00000005){
+    return 0;                           // MCLK is not sourced from HFXTCLK
+  }
+  if(frequency == ClockFrequency){
+    return 1;
+  }
+  ok = 1;
+  if(frequency > ClockFrequency){
+    if(vcore && (Clock_SetVcore(1) == 0)){
+      return 0;                         // VCORE1 is required before MCLK exceeds 24 MHz
+    }
+    Clock_SetWaitStates(wait);
+  }
+  CS->KEY = 0x695A;                     // unlock CS module for register access
+  CS->CTL1 = (CS->CTL1&~0x00070000)|(divm<<16);
+  CS->KEY = 0;                          // lock CS module from unintended access
+  if(frequency < ClockFrequency){
+    Clock_SetWaitStates(wait);
+    ok = Clock_SetVcore(vcore);         // the new frequency is valid at either VCORE
+  }
+  ClockFrequency = frequency;
+  SystemCoreClock = frequency;
+  Clock_Notify(frequency);
+  return ok;
+}
+
+
+#ifdef CLOCK_DELAY_SOFTWARE
 // delay function
 // which delays about 6*ulCount cycles
 // ulCount=8000 => 1ms = (8000 loops)*(6 cycles/loop)*(20.83 ns/cycle)
@@ -170,3 +598,74 @@ void Clock_Delay1ms(uint32_t n){
     n--;
   }
 }
+
+#else
+// ------------Clock_DelayTimerInit------------
+// Start Timer32 module 1 as a free-running 32-bit down
+// counter clocked by MCLK with no prescale. The delay
+// functions measure elapsed time as the difference of
+// two counter values, so the result does not depend on
+// the compiler optimization level, the flash wait states,
+// or whether the code runs from flash or SRAM.
+// Input: none
+// Output: none
+static void Clock_DelayTimerInit(void){
+  TIMER32_1->CONTROL = 0;               // disable during setup
+  TIMER32_1->LOAD = 0xFFFFFFFF;         // count the full 32-bit range
+  TIMER32_1->CONTROL = 0x00000082;      // enable, free-running mode, no interrupt, prescale /1, 32-bit counter
+}
+
+// ------------Clock_DelayCycles------------
+// Wait until the counter has moved "cycles" counts past
+// *start, then advance *start by the same amount so that
+// consecutive waits do not accumulate error.
+// Inputs: start, pointer to the reference counter value
+//         cycles, number of MCLK cycles to wait (< 2^32)
+// Outputs: none
+RAMFUNC static void Clock_DelayCycles(uint32_t *start, uint32_t cycles){
+#ifdef SIMULATION
+  uint32_t elapsed = *start - TIMER32_1->VALUE;
+  if(elapsed < cycles){
+    Sim_Advance(cycles - elapsed);      // host simulation: advance the virtual clock instead of spinning
+  }
+#endif
+  while((*start - TIMER32_1->VALUE) < cycles){};  // down counter; unsigned math handles the wrap
+  *start = *start - cycles;
+}
+
+// ------------Clock_Delay1us------------
+// Delay function which delays n microseconds, measured
+// with Timer32 at the current ClockFrequency. The call
+// overhead (a few tens of cycles) is not compensated.
+// Inputs: n, number of us to wait
+// Outputs: none
+void Clock_Delay1us(uint32_t n){
+  uint32_t start;
+  if((TIMER32_1->CONTROL&0x00000080) == 0){
+    Clock_DelayTimerInit();
+  }
+  start = TIMER32_1->VALUE;
+  while(n >= 1000){                     // wait in 1 ms chunks so n*cycles cannot overflow
+    Clock_DelayCycles(&start, ClockFrequency/1000);
+    n = n - 1000;
+  }
+  Clock_DelayCycles(&start, n*(ClockFrequency/1000000));
+}
+
+// ------------Clock_Delay1ms------------
+// Delay function which delays n milliseconds, measured
+// with Timer32 at the current ClockFrequency.
+// Inputs: n, number of msec to wait
+// Outputs: none
+void Clock_Delay1ms(uint32_t n){
+  uint32_t start;
+  if((TIMER32_1->CONTROL&0x00000080) == 0){
+    Clock_DelayTimerInit();
+  }
+  start = TIMER32_1->VALUE;
+  while(n){
+    Clock_DelayCycles(&start, ClockFrequency/1000);
+    n--;
+  }
+}
+#endif
@@ -0,0 +1,410 @@
+/**
+ * @file ConfigStore.c
+ * @brief Source code for the ConfigStore driver.
+ *
+ * This file contains the function definitions for the configuration store in INFO flash.
+ * The flash words are programmed in full word mode with the post-program verification of the
+ * flash controller, and the sector erase is checked by reading the sector back.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/ConfigStore.h"
+#include "../inc/Debounce.h"
+#include "../inc/RamFunc.h"
+
+// Address used to read the sector, which is an array in SRAM in the host simulation
+#ifdef SIMULATION
+#define CONFIG_STORE_BASE           ((uintptr_t)Sim_INFO_Flash)
+#else
+#define CONFIG_STORE_BASE           ((uintptr_t)CONFIG_STORE_ADDRESS)
+#endif
+
+// First word of a record ("CFG1"), and the value of an erased flash word
+#define CONFIG_STORE_MAGIC          0x31474643
+#define CONFIG_STORE_ERASED         0xFFFFFFFF
+
+/**
+ * @brief ConfigStore_Record describes the header and commit flash words of a record, which are followed by the data.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t length;
+    uint16_t sequence;
+    uint32_t erase_count;
+    uint32_t reserved0;
+    uint32_t crc;
+    uint32_t crc_inverse;
+    uint32_t reserved1[2];
+} ConfigStore_Record;
+
+// Record at an offset of the sector, its data, and its size in the sector
+#define CONFIG_STORE_RECORD(offset)         ((const ConfigStore_Record *)(CONFIG_STORE_BASE + (offset)))
+#define CONFIG_STORE_DATA(record)           ((const Config_Data *)((const uint8_t *)(record) + sizeof(ConfigStore_Record)))
+#define CONFIG_STORE_RECORD_SIZE(length)    (sizeof(ConfigStore_Record) + (((uint32_t)(length) + CONFIG_STORE_CHUNK - 1) & ~(CONFIG_STORE_CHUNK - 1)))
+
+// A record is committed once its commit word has been programmed
+#define CONFIG_STORE_COMMITTED(record)      ((record)->crc_inverse == ~(record)->crc)
+
+// Configuration found at boot, or 0 once the sector has been erased
+static const Config_Data *ConfigStore_Config = 0;
+
+// Last committed record, offset of the next record, and sequence number and erase count of the last header
+static const ConfigStore_Record *ConfigStore_Last = 0;
+static uint16_t ConfigStore_Free = 0;
+static uint16_t ConfigStore_Sequence = 0;
+static uint32_t ConfigStore_Erases = 0;
+
+// Record of the update in progress (0 if none), and the number of data bytes programmed
+static const ConfigStore_Record *ConfigStore_Update = 0;
+static uint16_t ConfigStore_Written = 0;
+
+/**
+ * @brief The ConfigStore_CRC32 function computes the CRC32 signature of data with the CRC32 hardware module.
+ *
+ * @param data      A pointer to the data, aligned to 16 bits.
+ * @param length    The length of the data in bytes (a multiple of 2).
+ *
+ * @return The CRC32 signature.
+ */
+static uint32_t ConfigStore_CRC32(const void *data, uint32_t length)
+{
+    const uint16_t *halfwords = (const uint16_t *)data;
+
+    CRC32->INIRES32_LO = 0xFFFF;
+    CRC32->INIRES32_HI = 0xFFFF;
+    for (uint32_t index = 0; index < (length / 2); index++)
+    {
+        CRC32->DI32 = halfwords[index];
+    }
+    return ((uint32_t)CRC32->INIRES32_HI << 16) | CRC32->INIRES32_LO;
+}
+
+/**
+ * @brief The ConfigStore_Check_Data function checks the fields of a configuration against the limits of Config_Data.
+ *
+ * @param config    A pointer to the configuration.
+ * @param length    The length of the data of the record in bytes.
+ *
+ * @return 1 if the configuration is valid, 0 otherwise.
+ */
+static uint8_t ConfigStore_Check_Data(const Config_Data *config, uint16_t length)
+{
+    if ((length < sizeof(Config_Data)) || (config->pattern_count > CONFIG_STORE_MAX_PATTERNS) ||
+        (length != (sizeof(Config_Data) + (config->step_count * sizeof(LED_Step)))))
+    {
+        return 0;
+    }
+
+    uint32_t frequency = config->idle_clock_hz;
+    if ((frequency != 0) && (frequency != 3000000) && (frequency != 12000000) && (frequency != 24000000) && (frequency != 48000000))
+    {
+        return 0;
+    }
+
+    uint8_t samples = config->debounce_samples;
+    if ((samples != 0) && ((samples < DEBOUNCE_MIN_SAMPLES) || (samples > DEBOUNCE_MAX_SAMPLES)))
+    {
+        return 0;
+    }
+
+    uint32_t step_count = 0;
+    for (uint32_t index = 0; index < config->pattern_count; index++)
+    {
+        const Config_Pattern *pattern = &config->patterns[index];
+        if ((pattern->switch_status > 0x0F) || (pattern->step_count == 0))
+        {
+            return 0;
+        }
+        step_count = step_count + pattern->step_count;
+    }
+    return (step_count == config->step_count) ? 1 : 0;
+}
+
+/**
+ * @brief The ConfigStore_Check_Record function validates the data of a committed record.
+ *
+ * @param record A pointer to the record.
+ *
+ * @return 1 if the CRC32 signature and the fields of the data are valid, 0 otherwise.
+ */
+static uint8_t ConfigStore_Check_Record(const ConfigStore_Record *record)
+{
+    const Config_Data *config = CONFIG_STORE_DATA(record);
+    if (ConfigStore_CRC32(config, record->length) != record->crc)
+    {
+        return 0;
+    }
+    return ConfigStore_Check_Data(config, record->length);
+}
+
+/**
+ * @brief The ConfigStore_Program function programs one 16-byte flash word of the sector.
+ *
+ * @param address   A pointer to the flash word, aligned to 16 bytes.
+ * @param words     The four 32-bit words to program.
+ *
+ * @return 1 if the flash word was programmed and verified, 0 otherwise.
+ */
+RAMFUNC static uint8_t ConfigStore_Program(const void *address, const uint32_t *words)
+{
+    volatile uint32_t *flash = (volatile uint32_t *)(uintptr_t)address;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    FLCTL->BANK0_INFO_WEPROT = FLCTL->BANK0_INFO_WEPROT & ~FLCTL_BANK0_INFO_WEPROT_PROT0;
+    FLCTL->CLRIFG = FLCTL_IFG_PRG | FLCTL_IFG_AVPST | FLCTL_IFG_PRG_ERR;
+    FLCTL->PRG_CTLSTAT = FLCTL_PRG_CTLSTAT_ENABLE | FLCTL_PRG_CTLSTAT_MODE | FLCTL_PRG_CTLSTAT_VER_PST;
+
+    // The program operation starts once the four words of the flash word have been written
+    flash[0] = words[0];
+    flash[1] = words[1];
+    flash[2] = words[2];
+    flash[3] = words[3];
+
+    uint32_t status;
+    do
+    {
+        status = FLCTL->PRG_CTLSTAT & FLCTL_PRG_CTLSTAT_STATUS_MASK;
+    } while ((status == FLCTL_PRG_CTLSTAT_STATUS_1) || (status == FLCTL_PRG_CTLSTAT_STATUS_2));
+
+    uint32_t flags = FLCTL->IFG;
+    FLCTL->PRG_CTLSTAT = 0;
+    FLCTL->BANK0_INFO_WEPROT = FLCTL->BANK0_INFO_WEPROT | FLCTL_BANK0_INFO_WEPROT_PROT0;
+    __set_PRIMASK(primask);
+
+    return (flags & (FLCTL_IFG_AVPST | FLCTL_IFG_PRG_ERR)) ? 0 : 1;
+}
+
+/**
+ * @brief The ConfigStore_Erase function erases the sector.
+ *
+ * @param None
+ *
+ * @return 1 if every word of the sector reads as erased, 0 otherwise.
+ */
+RAMFUNC static uint8_t ConfigStore_Erase(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    FLCTL->BANK0_INFO_WEPROT = FLCTL->BANK0_INFO_WEPROT & ~FLCTL_BANK0_INFO_WEPROT_PROT0;
+    FLCTL->ERASE_CTLSTAT = FLCTL_ERASE_CTLSTAT_CLR_STAT;
+    FLCTL->ERASE_SECTADDR = CONFIG_STORE_ADDRESS & 0x003FFFFF;
+    FLCTL->ERASE_CTLSTAT = FLCTL_ERASE_CTLSTAT_TYPE_1 | FLCTL_ERASE_CTLSTAT_START;
+
+    uint32_t status;
+    do
+    {
+        status = FLCTL->ERASE_CTLSTAT & FLCTL_ERASE_CTLSTAT_STATUS_MASK;
+    } while ((status == FLCTL_ERASE_CTLSTAT_STATUS_1) || (status == FLCTL_ERASE_CTLSTAT_STATUS_2));
+
+    uint32_t error = FLCTL->ERASE_CTLSTAT & FLCTL_ERASE_CTLSTAT_ADDR_ERR;
+    FLCTL->ERASE_CTLSTAT = FLCTL_ERASE_CTLSTAT_CLR_STAT;
+    FLCTL->BANK0_INFO_WEPROT = FLCTL->BANK0_INFO_WEPROT | FLCTL_BANK0_INFO_WEPROT_PROT0;
+    __set_PRIMASK(primask);
+
+    if (error)
+    {
+        return 0;
+    }
+
+    const uint32_t *words = (const uint32_t *)CONFIG_STORE_BASE;
+    for (uint32_t index = 0; index < (CONFIG_STORE_SIZE / 4); index++)
+    {
+        if (words[index] != CONFIG_STORE_ERASED)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+const Config_Data *ConfigStore_Init(void)
+{
+    ConfigStore_Config = 0;
+    ConfigStore_Last = 0;
+    ConfigStore_Sequence = 0;
+    ConfigStore_Erases = 0;
+    ConfigStore_Update = 0;
+
+    // Walk the headers up to the first erased word. Unknown content is kept until the next update erases the sector,
+    // and the end of the valid records is kept in chain_end.
+    uint32_t offset = 0;
+    uint32_t chain_end = 0;
+    while ((offset + sizeof(ConfigStore_Record)) <= CONFIG_STORE_SIZE)
+    {
+        const ConfigStore_Record *record = CONFIG_STORE_RECORD(offset);
+        if (record->magic == CONFIG_STORE_ERASED)
+        {
+            break;
+        }
+        if ((record->magic != CONFIG_STORE_MAGIC) || (record->length > CONFIG_STORE_MAX_LENGTH) ||
+            ((offset + CONFIG_STORE_RECORD_SIZE(record->length)) > CONFIG_STORE_SIZE))
+        {
+            offset = CONFIG_STORE_SIZE;
+            break;
+        }
+
+        ConfigStore_Sequence = record->sequence;
+        ConfigStore_Erases = record->erase_count;
+        if (CONFIG_STORE_COMMITTED(record))
+        {
+            ConfigStore_Last = record;
+        }
+        offset = offset + CONFIG_STORE_RECORD_SIZE(record->length);
+        chain_end = offset;
+    }
+    ConfigStore_Free = (uint16_t)offset;
+
+    // Only the last committed record is validated, unless it fails
+    if (ConfigStore_Last == 0)
+    {
+        return 0;
+    }
+    if (ConfigStore_Check_Record(ConfigStore_Last))
+    {
+        ConfigStore_Config = CONFIG_STORE_DATA(ConfigStore_Last);
+        return ConfigStore_Config;
+    }
+
+    // The headers are checked again, so the walk never leaves the valid records
+    offset = 0;
+    while (offset < chain_end)
+    {
+        const ConfigStore_Record *record = CONFIG_STORE_RECORD(offset);
+        uint32_t size = CONFIG_STORE_RECORD_SIZE(record->length);
+        if ((record->magic != CONFIG_STORE_MAGIC) || (record->length > CONFIG_STORE_MAX_LENGTH) ||
+            ((offset + size) > chain_end))
+        {
+            break;
+        }
+        if ((record != ConfigStore_Last) && CONFIG_STORE_COMMITTED(record) && ConfigStore_Check_Record(record))
+        {
+            ConfigStore_Config = CONFIG_STORE_DATA(record);
+        }
+        offset = offset + size;
+    }
+    return ConfigStore_Config;
+}
+
+const Config_Data *ConfigStore_Get(void)
+{
+    return ConfigStore_Config;
+}
+
+uint8_t ConfigStore_Begin(uint16_t length)
+{
+    ConfigStore_Update = 0;
+    if ((length == 0) || ((length % 4) != 0) || (length > CONFIG_STORE_MAX_LENGTH))
+    {
+        return CONFIG_STORE_BAD_LENGTH;
+    }
+
+    // Erase the sector only when the record does not fit after the last one
+    uint32_t size = CONFIG_STORE_RECORD_SIZE(length);
+    if ((ConfigStore_Free + size) > CONFIG_STORE_SIZE)
+    {
+        ConfigStore_Config = 0;
+        ConfigStore_Last = 0;
+        ConfigStore_Free = CONFIG_STORE_SIZE;
+        if (!ConfigStore_Erase())
+        {
+            return CONFIG_STORE_FLASH_ERROR;
+        }
+        ConfigStore_Free = 0;
+        ConfigStore_Erases = ConfigStore_Erases + 1;
+    }
+
+    const ConfigStore_Record *record = CONFIG_STORE_RECORD(ConfigStore_Free);
+    uint32_t header[4] =
+    {
+        CONFIG_STORE_MAGIC,
+        (uint32_t)length | ((uint32_t)(uint16_t)(ConfigStore_Sequence + 1) << 16),
+        ConfigStore_Erases,
+        CONFIG_STORE_ERASED
+    };
+
+    // The space is taken even if the header fails, and the next update then erases the sector
+    ConfigStore_Free = ConfigStore_Free + size;
+    if (!ConfigStore_Program(&record->magic, header))
+    {
+        ConfigStore_Free = CONFIG_STORE_SIZE;
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    ConfigStore_Sequence = ConfigStore_Sequence + 1;
+    ConfigStore_Update = record;
+    ConfigStore_Written = 0;
+    return CONFIG_STORE_OK;
+}
+
+uint8_t ConfigStore_Write(uint16_t offset, const uint8_t *data)
+{
+    const ConfigStore_Record *record = ConfigStore_Update;
+    if (record == 0)
+    {
+        return CONFIG_STORE_BAD_STATE;
+    }
+    if ((offset != ConfigStore_Written) || (offset >= record->length))
+    {
+        return CONFIG_STORE_BAD_LENGTH;
+    }
+
+    // The data of a frame is not aligned, so the words are assembled in little-endian order
+    uint32_t words[CONFIG_STORE_CHUNK / 4] = { 0, 0, 0, 0 };
+    for (uint32_t index = 0; index < CONFIG_STORE_CHUNK; index++)
+    {
+        words[index / 4] = words[index / 4] | ((uint32_t)data[index] << ((index % 4) * 8));
+    }
+
+    if (!ConfigStore_Program((const uint8_t *)CONFIG_STORE_DATA(record) + offset, words))
+    {
+        ConfigStore_Update = 0;
+        ConfigStore_Free = CONFIG_STORE_SIZE;
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+    ConfigStore_Written = ConfigStore_Written + CONFIG_STORE_CHUNK;
+    return CONFIG_STORE_OK;
+}
+
+uint8_t ConfigStore_Commit(void)
+{
+    const ConfigStore_Record *record = ConfigStore_Update;
+    if ((record == 0) || (ConfigStore_Written < record->length))
+    {
+        return CONFIG_STORE_BAD_STATE;
+    }
+
+    // A rejected record is left uncommitted, so it is skipped
+    ConfigStore_Update = 0;
+    const Config_Data *config = CONFIG_STORE_DATA(record);
+    if (!ConfigStore_Check_Data(config, record->length))
+    {
+        return CONFIG_STORE_INVALID;
+    }
+
+    uint32_t crc = ConfigStore_CRC32(config, record->length);
+    uint32_t commit[4] = { crc, ~crc, CONFIG_STORE_ERASED, CONFIG_STORE_ERASED };
+    if (!ConfigStore_Program(&record->crc, commit))
+    {
+        ConfigStore_Free = CONFIG_STORE_SIZE;
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+    ConfigStore_Last = record;
+    return CONFIG_STORE_OK;
+}
+
+void ConfigStore_Get_Status(ConfigStore_Status *status)
+{
+    const ConfigStore_Record *record = ConfigStore_Last;
+
+    status->loaded = (ConfigStore_Config != 0) ? 1 : 0;
+    status->sequence = (record != 0) ? record->sequence : 0;
+    status->length = (record != 0) ? record->length : 0;
+    status->crc = (record != 0) ? record->crc : 0;
+    status->free_offset = ConfigStore_Free;
+    status->erase_count = ConfigStore_Erases;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file Debounce.c
+ * @brief Source code for the Debounce driver.
+ *
+ * This file contains the function definitions for debouncing the user buttons and the PMOD SWT switches.
+ *
+ * The counter of each input is reloaded with (samples - 1) while the input matches its stable state.
+ * Every sample that differs decrements the counter, and a sample that differs while the counter is 0
+ * toggles the stable state. The three counter planes are updated with a bit-parallel decrement:
+ *
+ *  Count_0 = ~Count_0
+ *  Count_1 =  Count_1 ^ ~Count_0_old
+ *  Count_2 =  Count_2 ^ (~Count_0_old & ~Count_1_old)
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Debounce.h"
+#include "../inc/InputSnapshot.h"
+#include "../inc/RamFunc.h"
+
+// Inputs that use negative logic (pressed = low)
+#define DEBOUNCE_ACTIVE_LOW     INPUT_SNAPSHOT_BUTTONS
+
+// Stable state and vertical counter planes, in the packed format
+static volatile uint16_t Debounce_State;
+static uint16_t Count_0;
+static uint16_t Count_1;
+static uint16_t Count_2;
+
+// Reload value of the counters, expanded to one mask per plane (0x0000 or 0xFFFF)
+static uint16_t Reload_0;
+static uint16_t Reload_1;
+static uint16_t Reload_2;
+
+// Edges recorded since the last call to Debounce_Get_Edges
+static volatile uint16_t Debounce_Pressed;
+static volatile uint16_t Debounce_Released;
+
+void Debounce_Init(uint8_t samples)
+{
+    if (samples < DEBOUNCE_MIN_SAMPLES)
+    {
+        samples = DEBOUNCE_MIN_SAMPLES;
+    }
+    else if (samples > DEBOUNCE_MAX_SAMPLES)
+    {
+        samples = DEBOUNCE_MAX_SAMPLES;
+    }
+
+    uint8_t reload = samples - 1;
+    Reload_0 = (reload & 0x01) ? 0xFFFF : 0x0000;
+    Reload_1 = (reload & 0x02) ? 0xFFFF : 0x0000;
+    Reload_2 = (reload & 0x04) ? 0xFFFF : 0x0000;
+
+    Count_0 = Reload_0;
+    Count_1 = Reload_1;
+    Count_2 = Reload_2;
+    Debounce_State = InputSnapshot_Take(0);
+    Debounce_Pressed = 0;
+    Debounce_Released = 0;
+}
+
+RAMFUNC uint16_t Debounce_Sample(uint16_t inputs)
+{
+    uint16_t state = Debounce_State;
+    uint16_t delta = (inputs & INPUT_SNAPSHOT_ALL) ^ state;
+
+    // Inputs that differ while their counter is 0 change their stable state
+    uint16_t toggle = delta & ~(Count_0 | Count_1 | Count_2);
+
+    // Decrement every counter, then reload the counters of the inputs that match or just changed
+    uint16_t borrow_0 = ~Count_0;
+    uint16_t borrow_1 = borrow_0 & ~Count_1;
+    uint16_t reload = ~delta | toggle;
+    Count_0 = (~Count_0 & ~reload) | (Reload_0 & reload);
+    Count_1 = ((Count_1 ^ borrow_0) & ~reload) | (Reload_1 & reload);
+    Count_2 = ((Count_2 ^ borrow_1) & ~reload) | (Reload_2 & reload);
+
+    if (toggle)
+    {
+        state = state ^ toggle;
+        Debounce_State = state;
+
+        // Convert to active-high so that a press is a 0 to 1 transition for every input
+        uint16_t active = state ^ DEBOUNCE_ACTIVE_LOW;
+        Debounce_Pressed = Debounce_Pressed | (toggle & active);
+        Debounce_Released = Debounce_Released | (toggle & ~active);
+    }
+    return toggle;
+}
+
+uint16_t Debounce_Get_Inputs(void)
+{
+    return Debounce_State;
+}
+
+uint8_t Debounce_Get_Buttons_Status(void)
+{
+    return INPUT_SNAPSHOT_GET_BUTTONS(Debounce_State);
+}
+
+uint8_t Debounce_Get_Switches_Status(void)
+{
+    return INPUT_SNAPSHOT_GET_SWITCHES(Debounce_State);
+}
+
+void Debounce_Get_Edges(uint16_t *pressed, uint16_t *released)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *pressed = Debounce_Pressed;
+    *released = Debounce_Released;
+    Debounce_Pressed = 0;
+    Debounce_Released = 0;
+    __set_PRIMASK(primask);
+}
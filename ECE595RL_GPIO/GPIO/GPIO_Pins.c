@@ -0,0 +1,71 @@
+/**
+ * @file GPIO_Pins.c
+ * @brief Source code for the GPIO_Pins driver.
+ *
+ * This file contains the function definitions for initializing GPIO pins from a table of descriptors.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/GPIO_Pins.h"
+
+void GPIO_Pins_Init(const GPIO_Pin *pins, uint32_t count)
+{
+    // Register values merged per port (index 0 is P1)
+    uint8_t used[GPIO_PINS_PORT_COUNT] = { 0 };
+    uint8_t out[GPIO_PINS_PORT_COUNT] = { 0 };
+    uint8_t ren[GPIO_PINS_PORT_COUNT] = { 0 };
+    uint8_t ds[GPIO_PINS_PORT_COUNT] = { 0 };
+    uint8_t dir[GPIO_PINS_PORT_COUNT] = { 0 };
+
+    for (uint32_t pin_index = 0; pin_index < count; pin_index++)
+    {
+        const GPIO_Pin *pin = &pins[pin_index];
+        if ((pin->port < 1) || (pin->port > GPIO_PINS_PORT_COUNT))
+        {
+            continue;
+        }
+
+        uint8_t port_index = pin->port - 1;
+        uint8_t mask = pin->mask;
+        used[port_index] |= mask;
+
+        if (pin->direction == GPIO_PINS_OUTPUT)
+        {
+            dir[port_index] |= mask;
+            out[port_index] |= pin->initial & mask;
+            if (pin->drive == GPIO_PINS_DRIVE_HIGH)
+            {
+                ds[port_index] |= mask;
+            }
+        }
+        else if (pin->pull != GPIO_PINS_PULL_NONE)
+        {
+            // The OUT bit of an input pin selects the pull-up (1) or the pull-down (0) resistor
+            ren[port_index] |= mask;
+            if (pin->pull == GPIO_PINS_PULL_UP)
+            {
+                out[port_index] |= mask;
+            }
+        }
+    }
+
+    for (uint8_t port_index = 0; port_index < GPIO_PINS_PORT_COUNT; port_index++)
+    {
+        uint8_t mask = used[port_index];
+        if (mask == 0)
+        {
+            continue;
+        }
+
+        DIO_PORT_Odd_Type *port = GPIO_PINS_REGISTERS(port_index + 1);
+        port->SEL0 = port->SEL0 & ~mask;
+        port->SEL1 = port->SEL1 & ~mask;
+        port->OUT = (port->OUT & ~mask) | out[port_index];
+        port->REN = (port->REN & ~mask) | ren[port_index];
+        port->DS = (port->DS & ~mask) | ds[port_index];
+        port->DIR = (port->DIR & ~mask) | dir[port_index];
+    }
+}
@@ -7,6 +7,7 @@
  *  - User buttons and LEDs of the TI MSP432 LaunchPad
  *  - PMOD SWT (4 Slide Switches)
  *  - PMOD 8LD (8 LEDs)
+ *  - UART0 backchannel to the host through the XDS110 virtual COM port (see Telemetry.h)
  *
  * To verify the pinout of the user buttons and LEDs, refer to the MSP432P401R SimpleLink Microcontroller LaunchPad Development Kit User's Guide
  * Link: https://docs.rs-online.com/3934/A700000006811369.pdf
@@ -26,55 +27,308 @@
 #include <stdint.h>
 #include "msp.h"
 #include "../inc/Clock.h"
+#include "../inc/SysTickInts.h"
+#include "../inc/Debounce.h"
+#include "../inc/InputEvents.h"
+#include "../inc/InputSnapshot.h"
+#include "../inc/LowPower.h"
+#include "../inc/PMOD_8LD_DMA.h"
+#include "../inc/PMOD_8LD_BCM.h"
+#include "../inc/Profile.h"
+#include "../inc/GPIO_Pins.h"
+#include "../inc/PMOD.h"
+#include "../inc/RGB_PWM.h"
+#include "../inc/RamFunc.h"
+#include "../inc/Trace.h"
+#include "../inc/Telemetry.h"
+#include "../inc/Benchmark.h"
+#include "../inc/Microbench.h"
+#include "../inc/Boot.h"
+#include "../inc/LED_Step.h"
+#include "../inc/LED_Output.h"
+#include "../inc/Scheduler.h"
+#include "../inc/Watchdog.h"
+#include "../inc/ConfigStore.h"
 
 // Constant definitions for the built-in red LED
-const uint8_t RED_LED_OFF           =   0x00;
-const uint8_t RED_LED_ON            =   0x01;
+#define RED_LED_OFF             0x00
+#define RED_LED_ON              0x01
 
 // Constant definitions for the RGB LED colors
-const uint8_t RGB_LED_OFF           =   0x00;
-const uint8_t RGB_LED_RED           =   0x01;
-const uint8_t RGB_LED_GREEN         =   0x02;
-const uint8_t RGB_LED_YELLOW        =   0x03;
-const uint8_t RGB_LED_BLUE          =   0x04;
-const uint8_t RGB_LED_PINK          =   0x05;
-const uint8_t RGB_LED_SKY_BLUE      =   0x06;
-const uint8_t RGB_LED_WHITE         =   0x07;
+#define RGB_LED_OFF             0x00
+#define RGB_LED_RED             0x01
+#define RGB_LED_GREEN           0x02
+#define RGB_LED_YELLOW          0x03
+#define RGB_LED_BLUE            0x04
+#define RGB_LED_PINK            0x05
+#define RGB_LED_SKY_BLUE        0x06
+#define RGB_LED_WHITE           0x07
 
 // Constant definitions for the PMOD 8LD module
-const uint8_t PMOD_8LD_ALL_OFF      =   0x00;
-const uint8_t PMOD_8LD_ALL_ON       =   0xFF;
-const uint8_t PMOD_8LD_0_3_ON       =   0x0F;
-const uint8_t PMOD_8LD_4_7_ON       =   0xF0;
-const uint8_t PMOD_8LD_0_2_4_6_ON   =   0x55;
-const uint8_t PMOD_8LD_1_3_5_7_ON   =   0xAA;
+#define PMOD_8LD_ALL_OFF        0x00
+#define PMOD_8LD_ALL_ON         0xFF
+#define PMOD_8LD_0_3_ON         0x0F
+#define PMOD_8LD_4_7_ON         0xF0
+#define PMOD_8LD_0_2_4_6_ON     0x55
+#define PMOD_8LD_1_3_5_7_ON     0xAA
 
+// Period of the pattern engine tick in milliseconds
+#define LED_TICK_MS             1
+
+// Priority of the CS, PCM, and T32_INT2 interrupts that complete the switch to 48 MHz
+#define CLOCK_PRIORITY          1
+
+// Priority of the SysTick interrupt that drives the pattern engine
+#define LED_TICK_PRIORITY       2
+
+// Number of consecutive ticks that an input must be stable before a change is accepted
+#define DEBOUNCE_SAMPLES        5
+
+// Priority of the PORT1 interrupt that records the input events
+#define INPUT_EVENTS_PRIORITY   1
+
+// Priorities of the tasks that apply the input events and advance the pattern engine (see Scheduler.h).
+// Both are below every interrupt handler, and the telemetry runs below them in the main loop.
+#define LED_INPUT_TASK_PRIORITY     4
+#define LED_PATTERN_TASK_PRIORITY   5
+
+// Priority of the RTC_C interrupt that polls the switches in LPM3
+#define LOW_POWER_PRIORITY      2
+
+// Deepest idle mode used between ticks (LOW_POWER_ACTIVE, LOW_POWER_LPM0, or LOW_POWER_LPM3)
+// LPM3 is only entered while the active step is held, and LPM0 is used otherwise
+#ifndef LED_IDLE_MODE
+#define LED_IDLE_MODE           LOW_POWER_LPM0
+#endif
+
+// MCLK frequency while the active pattern is held (duration of 0), and while it is animated
+#ifndef LED_IDLE_CLOCK_HZ
+#define LED_IDLE_CLOCK_HZ       12000000
+#endif
+#define LED_ACTIVE_CLOCK_HZ     48000000
+
+// Set to 1 to drive the RGB LED with hardware PWM and fade between the colors of consecutive steps,
+// or to 0 to switch the colors on and off with LED2_Write
+#ifndef LED_RGB_PWM
+#define LED_RGB_PWM             0
+#endif
+
+// Duration of the fade between two RGB LED colors in PWM mode, in milliseconds
+#define LED_RGB_FADE_MS         100
+
+// Priority of the TA0_0 interrupt that advances the RGB LED fades
+#define RGB_PWM_PRIORITY        3
+
+// Priority of the DMA_INT1 interrupt that restarts the PMOD 8LD frame buffers
+#define PMOD_8LD_DMA_PRIORITY   3
+
+// Priority of the TA2_0 interrupt that displays the PMOD 8LD bit planes. It is the highest priority,
+// so that the next plane is loaded before the shortest plane (4 us) ends.
+#define PMOD_8LD_BCM_PRIORITY   0
+
+// Set to 1 to accept commands and send telemetry over the UART0 backchannel (XDS110 virtual COM port)
+#ifndef LED_TELEMETRY
+#define LED_TELEMETRY           1
+#endif
+
+// Priority of the EUSCIA0 interrupt that moves the UART0 bytes
+#define TELEMETRY_PRIORITY      3
+
+// Priority of the TA3_0 and TA3_N interrupts that measure the input-to-output latency (Benchmark build configuration only)
+#define BENCHMARK_PRIORITY      3
+
+// Set to 1 to drive the outputs to their off level and start the 48 MHz crystal at the entry of main,
+// and initialize the drivers that do not depend on MCLK or SMCLK while the crystal settles (Clock_Init48MHz_Async, see Boot.h),
+// or to 0 to wait for the 48 MHz clock before initializing the pins
+#ifndef LED_FAST_BOOT
+#define LED_FAST_BOOT           1
+#endif
+
+// Set to 1 to stream the PMOD 8LD frames of the counter patterns with the DMA controller,
+// or to 0 to write them from the pattern engine at every step
+#ifndef LED_PMOD_8LD_STREAMING
+#define LED_PMOD_8LD_STREAMING  1
+#endif
+
+// Set to 1 to display LED_Pattern_6 for the switch status 0x03, which sets the brightness of every PMOD 8LD LED
+// with binary code modulation (see PMOD_8LD_BCM.h), or to 0 to display LED_Pattern_1 for that switch status
+#ifndef LED_PMOD_8LD_BCM
+#define LED_PMOD_8LD_BCM        1
+#endif
+
+// Set to 1 to supervise the main loop with the watchdog timer and count its deadline misses (see Watchdog.h),
+// or to 0 to keep the watchdog timer halted, for example while stepping through the program with the debugger
+#ifndef LED_WATCHDOG
+#define LED_WATCHDOG            1
+#endif
+
+// Longest iteration of the main loop that is not counted as a deadline miss, in us (one tick)
+#define LED_LOOP_BUDGET_US      (LED_TICK_MS * 1000)
 
 /**
- * @brief The LED1_Init function initializes the built-in red LED (P1.0).
+ * @brief LED_Pattern is a step table that the pattern engine plays in a loop.
  *
- * This function initializes the built-in red LED located at pin P1.0
- * and configures it as a GPIO pin. It sets the direction of the pin as output.
+ * Every step is packed into one LED_Step word (see LED_Step.h) and held for its duration before the pattern engine
+ * advances to the next step. The step tables are constant, so they are stored in flash and not copied to SRAM.
  *
- * @param None
+ * If pmod_8ld_frames is not 0, it holds the PMOD 8LD value of every step and the pattern is streamed:
+ * LED1 and the RGB LED display the first step, and the DMA controller plays the frames on the
+ * PMOD 8LD module with the duration of the first step between frames.
  *
- * @return None
+ * If pmod_8ld_brightness is not 0, it holds the brightness of the eight PMOD 8LD LEDs for every step
+ * (8 values per step, see PMOD_8LD_BCM_Set), which the BCM engine displays instead of the PMOD 8LD value of the step.
+ * The pattern engine advances the steps, and LED1 and the RGB LED display them.
  */
-void LED1_Init()
+typedef struct
 {
-    P1->SEL0 &= ~0x01;
-    P1->SEL1 &= ~0x01;
-    P1->DIR |= 0x01;
-}
+    const LED_Step *steps;
+    uint16_t step_count;
+    const uint8_t *pmod_8ld_frames;
+    const uint8_t *pmod_8ld_brightness;
+} LED_Pattern;
+
+/**
+ * @brief LED_Engine_State keeps track of the active pattern between ticks.
+ */
+typedef struct
+{
+    const LED_Pattern *pattern;
+    uint16_t step_index;
+    uint16_t elapsed_ms;
+    uint8_t streaming;
+    uint8_t brightness;
+} LED_Engine_State;
+
+// State of the pattern engine, advanced by LED_Controller once per tick
+static LED_Engine_State LED_Engine = { 0, 0, 0, 0, 0 };
+
+// Outputs of an LED_Frame
+#define LED_FRAME_LED1          0x01
+#define LED_FRAME_RGB           0x02
+#define LED_FRAME_PMOD_8LD      0x04
+#define LED_FRAME_ALL           0x07
+
+/**
+ * @brief LED_Frame holds the state of every LED output for one tick.
+ *
+ * The pattern engine draws into the back frame, and LED_Frame_Commit displays it at the next tick boundary.
+ * The outputs field selects the outputs owned by the frame. The PMOD 8LD module is not owned while the
+ * DMA controller streams its frames or the BCM engine displays its brightness.
+ */
+typedef struct
+{
+    uint8_t led1_value;
+    uint8_t rgb_value;
+    uint8_t pmod_8ld_value;
+    uint8_t outputs;
+} LED_Frame;
+
+// Front (displayed) and back (drawn) frames, and the index of the front frame
+static LED_Frame LED_Frames[2];
+static volatile uint8_t LED_Frame_Front = 0;
+
+// Set when the back frame is complete and must be displayed at the next tick
+static volatile uint8_t LED_Frame_Ready = 0;
+
+// Values written to the outputs by the last commit, used to skip the outputs that do not change.
+// Its outputs field holds the outputs whose value is known (none after reset).
+static LED_Frame LED_Frame_Displayed = { 0, 0, 0, 0 };
+
+// Number of ticks that have not been processed by the pattern task yet
+static volatile uint32_t Tick_Pending = 0;
+
+// Last status of the physical buttons and switches, updated by the input task from the input events
+static uint8_t LED_Button_Input;
+static uint8_t LED_Switch_Input;
+
+// Input status used by the pattern task, with the host overrides applied, in the packed format of InputSnapshot.h.
+// It is written by the input task as one halfword, so the pattern task never sees a partial update.
+static volatile uint16_t LED_Input_Status;
+
+// Identifiers of the input task and the pattern task
+static uint8_t LED_Input_Task_Id;
+static uint8_t LED_Pattern_Task_Id;
+
+
+/**
+ * @brief Board_Pins lists the pins of every device used by this program.
+ *
+ * GPIO_Pins_Init merges the descriptors of each port, so P1 (LED1 and the user buttons) is configured
+ * with one write per register. A new PMOD is added by appending its descriptors to this table.
+ *
+ *  - LED1 (P1.0):              GPIO output, off
+ *  - RGB LED (P2.0 - P2.2):    GPIO outputs with high drive strength, off
+ *                                  - RGBLED_RED      (P2.0)
+ *                                  - RGBLED_GREEN    (P2.1)
+ *                                  - RGBLED_BLUE     (P2.2)
+ *  - User buttons (P1.1, P1.4): GPIO inputs with pull-up resistors (negative logic)
+ *  - PMOD 8LD (P9.0 - P9.7):   GPIO outputs with high drive strength, off
+ *  - PMOD SWT (P10.0 - P10.3): GPIO inputs
+ *
+ * The following connections must be made for the PMOD 8LD module:
+ *  - PMOD LED0   <-->  MSP432 LaunchPad Pin P9.0
+ *  - PMOD LED1   <-->  MSP432 LaunchPad Pin P9.1
+ *  - PMOD LED2   <-->  MSP432 LaunchPad Pin P9.2
+ *  - PMOD LED3   <-->  MSP432 LaunchPad Pin P9.3
+ *  - PMOD Pin 5  <-->  MSP432 LaunchPad GND
+ *  - PMOD Pin 6  <-->  MSP432 LaunchPad VCC (3.3V)
+ *  - PMOD LED4   <-->  MSP432 LaunchPad Pin P9.4
+ *  - PMOD LED5   <-->  MSP432 LaunchPad Pin P9.5
+ *  - PMOD LED6   <-->  MSP432 LaunchPad Pin P9.6
+ *  - PMOD LED7   <-->  MSP432 LaunchPad Pin P9.7
+ *  - PMOD Pin 11 <-->  MSP432 LaunchPad GND
+ *  - PMOD Pin 12 <-->  MSP432 LaunchPad VCC (3.3V)
+ *
+ * The following connections must be made for the PMOD SWT module:
+ *  - PMOD SWT1   <-->  MSP432 LaunchPad Pin P10.0
+ *  - PMOD SWT2   <-->  MSP432 LaunchPad Pin P10.1
+ *  - PMOD SWT3   <-->  MSP432 LaunchPad Pin P10.2
+ *  - PMOD SWT4   <-->  MSP432 LaunchPad Pin P10.3
+ *  - PMOD Pin 5  <-->  MSP432 LaunchPad GND
+ *  - PMOD Pin 6  <-->  MSP432 LaunchPad VCC (3.3V)
+ */
+static const GPIO_Pin Board_Pins[] =
+{
+    //       Port   Mask    Direction           Pull                    Drive                       Initial
+    GPIO_PIN(1,     0x01,   GPIO_PINS_OUTPUT,   GPIO_PINS_PULL_NONE,    GPIO_PINS_DRIVE_REGULAR,    0x00),  // LED1
+    GPIO_PIN(2,     0x07,   GPIO_PINS_OUTPUT,   GPIO_PINS_PULL_NONE,    GPIO_PINS_DRIVE_HIGH,       0x00),  // RGB LED
+    GPIO_PIN(1,     0x12,   GPIO_PINS_INPUT,    GPIO_PINS_PULL_UP,      GPIO_PINS_DRIVE_REGULAR,    0x00),  // User buttons
+    GPIO_PIN(9,     0xFF,   GPIO_PINS_OUTPUT,   GPIO_PINS_PULL_NONE,    GPIO_PINS_DRIVE_HIGH,       0x00),  // PMOD 8LD
+    GPIO_PIN(10,    0x0F,   GPIO_PINS_INPUT,    GPIO_PINS_PULL_NONE,    GPIO_PINS_DRIVE_REGULAR,    0x00)   // PMOD SWT
+};
+
+// Indexes of the PMOD modules in Board_PMODs
+#define BOARD_PMOD_8LD          0
+#define BOARD_PMOD_SWT          1
+
+/**
+ * @brief Board_PMODs lists the PMOD modules that are read and written through Board_PMOD_Bus.
+ *
+ * The pins of every PMOD are configured by Board_Pins. A new PMOD is added by appending its descriptor
+ * to this table, and its value is then exchanged by the same PMOD_Bus_Write and PMOD_Bus_Read calls.
+ *
+ *  - PMOD 8LD (P9.0 - P9.7):   8-bit output
+ *  - PMOD SWT (P10.0 - P10.3): Low nibble input, read by every input snapshot (SWT1 - SWT4 in bits 0 - 3)
+ */
+static const PMOD_Device Board_PMODs[] =
+{
+    PMOD_DEVICE_8(9, PMOD_OUTPUT),                          // PMOD 8LD
+    PMOD_DEVICE_NIBBLE(10, PMOD_NIBBLE_LOW, PMOD_INPUT)     // PMOD SWT
+};
+
+// Per-port plan and values of the PMOD modules, initialized by main after GPIO_Pins_Init
+static PMOD_Bus Board_PMOD_Bus;
 
 /**
  * @brief The LED1_Output function sets the output of the built-in red LED and returns the status.
  *
  * This function sets the output of the built-in red LED based on the value of the input, led_value.
- * A bitwise AND operation (& 0xFE) is performed to mask the first bit (LSB) of the output register
- * to preserve the state of other pins connected to Port 1 while keeping the LED pin unaffected.
- * Then, a bitwise OR operation is performed with led_value to set the LED pin to the desired state
- * specified by led_value.
+ * The LED pin is written through its Cortex-M4 bit-band alias, so the write is a single store that
+ * only affects P1.0. Unlike a read-modify-write of P1->OUT, it cannot overwrite a change made by an
+ * interrupt handler to the other pins of Port 1 (e.g. the pull-up selection of the user buttons)
+ * and it does not need to disable interrupts.
+ *
+ * The pin is then read back to return the status. Use LED1_Write (LED_Output.h) when the status is not needed.
  *
  * @param led_value An 8-bit unsigned integer that determines the output of the built-in red LED. To turn off
  *                  the LED, set led_value to 0. Otherwise, setting led_value to 1 turns on the LED.
@@ -85,40 +339,17 @@ void LED1_Init()
  */
 uint8_t LED1_Output(uint8_t led_value)
 {
-    P1->OUT = (P1->OUT & 0xFE) | led_value;
-    return ((P1->OUT != 0) ? 1 : 0);
-}
-
-/**
- * @brief The LED2_Init function initializes the RGB LED (P2.0 - P2.2).
- *
- * This function initializes the following RGB LED, configures the pins as GPIO pins with high drive strength,
- * and sets the direction of the pins as output. The RGB LED is off by default upon initialization.
- *  - RGBLED_RED      (P2.0)
- *  - RGBLED_GREEN    (P2.1)
- *  - RGBLED_BLUE     (P2.2)
- *
- * @param None
- *
- * @return None
- */
-void LED2_Init()
-{
-    P2->SEL0 &= ~0x07;
-    P2->SEL1 &= ~0x07;
-    P2->DS |= 0x07;
-    P2->DIR |= 0x07;
-    P2->OUT &= ~0x07;
+    LED1_Write(led_value);
+    return (uint8_t)BITBAND_PERI(P1->OUT, 0);
 }
 
 /**
  * @brief The LED2_Output function sets the output of the RGB LED and returns the status.
  *
  * This function sets the output of the RGB LED based on the value of the input, led_value.
- * A bitwise AND operation (& 0xF8) is performed to mask the lower three bits of the output register
- * to preserve the state of other pins connected to Port 2 while keeping the RGB LED pin unaffected.
- * Then, a bitwise OR operation is performed with led_value to set the RGB LED pin to the desired state
- * specified by led_value.
+ * Each color pin is written through its Cortex-M4 bit-band alias with a single store, so the
+ * other pins of Port 2 are preserved without a read-modify-write of P2->OUT and without disabling interrupts.
+ * P2->OUT is then read back to return the status. Use LED2_Write (LED_Output.h) when the status is not needed.
  *
  * @param led_value An 8-bit unsigned integer that determines the output of the RGB LED. To turn off
  *                  the RGB LED, set led_value to 0. The following values determine the color of the RGB LED:
@@ -139,27 +370,25 @@ void LED2_Init()
  */
 uint8_t LED2_Output(uint8_t led_value)
 {
-    P2->OUT = (P2->OUT & 0xF8) | led_value;
-    return ((P2->OUT != 0) ? 1 : 0);
+    LED2_Write(led_value);
+    return ((P2->OUT & 0x07) != 0) ? 1 : 0;
 }
 
 /**
- * @brief The Buttons_Init function initializes the user buttons (P1.1 and P1.4).
+ * @brief The LED2_Output_Color function turns one color of the RGB LED on or off.
  *
- * This function initializes the user buttons located at pins P1.1 and P1.4.
- * It configures the pins as GPIO input pins with pull-up resistors enabled.
+ * This function writes a single RGB LED pin through its bit-band alias. The write is one store,
+ * so it is safe to call from an interrupt handler while the main loop writes the other colors.
+ * It is the out-of-line version of LED2_Write_Color (LED_Output.h).
  *
- * @param None
+ * @param color_bit The bit number of the color: 0 (red, P2.0), 1 (green, P2.1), or 2 (blue, P2.2).
+ * @param led_value 0 turns the color off. Otherwise, the color is turned on.
  *
  * @return None
  */
-void Buttons_Init()
+RAMFUNC void LED2_Output_Color(uint8_t color_bit, uint8_t led_value)
 {
-    P1->SEL0 &= ~0x12;
-    P1->SEL1 &= ~0x12;
-    P1->DIR &= ~0x12;
-    P1->REN |= 0x12;
-    P1->OUT |= 0x12;
+    LED2_Write_Color(color_bit, led_value);
 }
 
 /**
@@ -183,44 +412,13 @@ uint8_t Get_Buttons_Status()
     return button_status;
 }
 
-/**
- * @brief The PMOD_8LD_Init function initializes the pins (P9.0 - P9.7) used by the Digilent PMOD 8LD module.
- *
- * This function initializes the pins, P9.0 through P9.7, which will be used to drive the eight
- * LEDs on the Digilent PMOD 8LD module. It configures the pins as GPIO output pins with high drive strength.
- *
- * The following connections must be made:
- *  - PMOD LED0   <-->  MSP432 LaunchPad Pin P9.0
- *  - PMOD LED1   <-->  MSP432 LaunchPad Pin P9.1
- *  - PMOD LED2   <-->  MSP432 LaunchPad Pin P9.2
- *  - PMOD LED3   <-->  MSP432 LaunchPad Pin P9.3
- *  - PMOD Pin 5  <-->  MSP432 LaunchPad GND
- *  - PMOD Pin 6  <-->  MSP432 LaunchPad VCC (3.3V)
- *  - PMOD LED4   <-->  MSP432 LaunchPad Pin P9.4
- *  - PMOD LED5   <-->  MSP432 LaunchPad Pin P9.5
- *  - PMOD LED6   <-->  MSP432 LaunchPad Pin P9.6
- *  - PMOD LED7   <-->  MSP432 LaunchPad Pin P9.7
- *  - PMOD Pin 11 <-->  MSP432 LaunchPad GND
- *  - PMOD Pin 12 <-->  MSP432 LaunchPad VCC (3.3V)
- *
- * @param None
- *
- * @return None
- */
-void PMOD_8LD_Init()
-{
-    P9->SEL0 &= ~0xFF;
-    P9->SEL1 &= ~0xFF;
-    P9->DS |= 0xFF;
-    P9->DIR |= 0xFF;
-    P9->OUT &= ~0xFF;
-}
-
 /**
  * @brief The PMOD_8LD_Output function sets the output of the eight LEDs on the PMOD 8LD module.
  *
  * This function sets the output value of the PMOD 8LD module by writing the provided led_value to the
  * corresponding output pins. It then reads back the actual value written to the PMOD 8LD module and returns it.
+ * The value is written with PMOD_Bus_Write, so the other output PMODs that were set are written at the same time.
+ * Use PMOD_8LD_Write (LED_Output.h) when the value read back is not needed.
  *
  * @param led_value An 8-bit unsigned integer representing the desired output value for the PMOD 8LD module.
  *
@@ -230,326 +428,956 @@ void PMOD_8LD_Init()
  */
 uint8_t PMOD_8LD_Output(uint8_t led_value)
 {
-    P9->OUT = led_value;
+    PMOD_8LD_Write(&Board_PMOD_Bus, BOARD_PMOD_8LD, led_value);
     uint8_t PMOD_8LD_value = P9->OUT;
     return PMOD_8LD_value;
 }
 
 /**
- * @brief The PMOD_SWT_Init function initializes the pins (P10.0 - P10.3) used by the Digilent PMOD SWT module.
+ * @brief Step tables for LED_Pattern_1, which sets the output of the user LEDs and the 8 PMOD LEDs based on the status of the user buttons.
  *
- * This function initializes the pins, P10.0 through P10.3, which will be used to receive the inputs
- * from the four slide switches on the PMOD SWT module. It configures the pins as GPIO input pins.
+ * The output of the built-in red LED (P1.0), the RGB LED (P2.0 - P2.2), and the 8 PMOD LEDs (P9.0 - P9.7) depends on
+ * the status of the Button 1 (P1.1) and Button 2 (P1.4).
  *
- * The following connections must be made:
- *  - PMOD SWT1   <-->  MSP432 LaunchPad Pin P10.0
- *  - PMOD SWT2   <-->  MSP432 LaunchPad Pin P10.1
- *  - PMOD SWT3   <-->  MSP432 LaunchPad Pin P10.2
- *  - PMOD SWT4   <-->  MSP432 LaunchPad Pin P10.3
- *  - PMOD Pin 5  <-->  MSP432 LaunchPad GND
- *  - PMOD Pin 6  <-->  MSP432 LaunchPad VCC (3.3V)
+ *  button_status      LED 1 Color          RGB LED Color               PMOD 8 LED
+ *  -------------      -----------        -----------------             --------------
+ *      0x00            1 Hz Flash          1 Hz Blue FLash                 All Off
+ *      0x10               On                    Off                     0, 2, 4, 6 ON
+ *      0x02               Off                   Pink                    1, 3, 5, 7 ON
+ *      0x12               Off                   Green                      All On
+ */
+static const LED_Step LED_Pattern_1_Both_Pressed_Steps[] =
+{
+    LED_STEP(RED_LED_ON,    RGB_LED_BLUE,   PMOD_8LD_ALL_OFF,       500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    PMOD_8LD_ALL_OFF,       500)
+};
+
+static const LED_Step LED_Pattern_1_Button_1_Steps[] =
+{
+    LED_STEP(RED_LED_ON,    RGB_LED_OFF,    PMOD_8LD_0_2_4_6_ON,    0)
+};
+
+static const LED_Step LED_Pattern_1_Button_2_Steps[] =
+{
+    LED_STEP(RED_LED_OFF,   RGB_LED_PINK,   PMOD_8LD_1_3_5_7_ON,    0)
+};
+
+static const LED_Step LED_Pattern_1_Released_Steps[] =
+{
+    LED_STEP(RED_LED_OFF,   RGB_LED_GREEN,  PMOD_8LD_ALL_ON,        0)
+};
+
+// Parameters of the binary counter of LED_Pattern_2 (0x00 up to 0xFF every 100 ms)
+#define LED_PATTERN_2_START     0x00
+#define LED_PATTERN_2_END       0xFF
+#define LED_PATTERN_2_STEP      1
+#define LED_PATTERN_2_PERIOD_MS 100
+
+// Parameters of the binary counter of LED_Pattern_3 (0xFF down to 0x00 every 100 ms)
+#define LED_PATTERN_3_START     0xFF
+#define LED_PATTERN_3_END       0x00
+#define LED_PATTERN_3_STEP      1
+#define LED_PATTERN_3_PERIOD_MS 100
+
+#define LED_PATTERN_2_LENGTH    LED_COUNTER_LENGTH(LED_PATTERN_2_START, LED_PATTERN_2_END, LED_PATTERN_2_STEP)
+#define LED_PATTERN_3_LENGTH    LED_COUNTER_LENGTH(LED_PATTERN_3_START, LED_PATTERN_3_END, LED_PATTERN_3_STEP)
+
+// Number of steps generated by LED_STEPS_N for each counter (16 * blocks + rest), which must match its length
+#define LED_PATTERN_2_BLOCKS    16
+#define LED_PATTERN_2_REST      0
+#define LED_PATTERN_3_BLOCKS    16
+#define LED_PATTERN_3_REST      0
+
+#if ((16 * LED_PATTERN_2_BLOCKS) + LED_PATTERN_2_REST) != LED_PATTERN_2_LENGTH
+#error "LED_PATTERN_2_BLOCKS and LED_PATTERN_2_REST do not match LED_PATTERN_2_LENGTH"
+#endif
+#if ((16 * LED_PATTERN_3_BLOCKS) + LED_PATTERN_3_REST) != LED_PATTERN_3_LENGTH
+#error "LED_PATTERN_3_BLOCKS and LED_PATTERN_3_REST do not match LED_PATTERN_3_LENGTH"
+#endif
+
+/**
+ * @brief Step table for LED_Pattern_2.
  *
- * @param None
+ * LED1 is on, the RGB LED displays a red color, and the PMOD 8LD module displays a
+ * binary counter that starts from 0 and increments up to 255 (0xFF) with 100 ms between each count.
+ * After 0xFF, the pattern engine restarts the counter from 0.
+ * The steps are generated at compile time by LED_STEPS_N.
+ */
+static const LED_Step LED_Pattern_2_Steps[LED_PATTERN_2_LENGTH] =
+{
+    LED_STEPS_N(LED_PATTERN_2_BLOCKS, LED_PATTERN_2_REST, LED_STEP_COUNTER, RED_LED_ON, RGB_LED_RED,
+                LED_PATTERN_2_START, LED_PATTERN_2_END, LED_PATTERN_2_STEP, LED_PATTERN_2_PERIOD_MS)
+};
+
+// PMOD 8LD frames of LED_Pattern_2, streamed by the DMA controller
+#if LED_PMOD_8LD_STREAMING
+static const uint8_t LED_Pattern_2_Frames[LED_PATTERN_2_LENGTH] =
+{
+    LED_STEPS_N(LED_PATTERN_2_BLOCKS, LED_PATTERN_2_REST, LED_STEP_COUNTER_VALUE,
+                LED_PATTERN_2_START, LED_PATTERN_2_END, LED_PATTERN_2_STEP)
+};
+#endif
+
+/**
+ * @brief Step table for LED_Pattern_3.
+ *
+ * LED1 is off, the RGB LED displays a blue color, and the PMOD 8LD module displays a
+ * binary counter that starts from 255 (0xFF) and decrements down to 0 with 100 ms between each count.
+ * After 0x00, the pattern engine restarts the counter from 0xFF until another switch status is detected.
+ * The steps are generated at compile time by LED_STEPS_N.
+ */
+static const LED_Step LED_Pattern_3_Steps[LED_PATTERN_3_LENGTH] =
+{
+    LED_STEPS_N(LED_PATTERN_3_BLOCKS, LED_PATTERN_3_REST, LED_STEP_COUNTER, RED_LED_OFF, RGB_LED_BLUE,
+                LED_PATTERN_3_START, LED_PATTERN_3_END, LED_PATTERN_3_STEP, LED_PATTERN_3_PERIOD_MS)
+};
+
+// PMOD 8LD frames of LED_Pattern_3, streamed by the DMA controller
+#if LED_PMOD_8LD_STREAMING
+static const uint8_t LED_Pattern_3_Frames[LED_PATTERN_3_LENGTH] =
+{
+    LED_STEPS_N(LED_PATTERN_3_BLOCKS, LED_PATTERN_3_REST, LED_STEP_COUNTER_VALUE,
+                LED_PATTERN_3_START, LED_PATTERN_3_END, LED_PATTERN_3_STEP)
+};
+#endif
+
+/**
+ * @brief Step table for LED_Pattern_4.
+ *
+ * LED1, the green RGB LED, and all the LEDs on the PMOD 8LD module toggle at a rate of 1 Hz.
+ */
+static const LED_Step LED_Pattern_4_Steps[] =
+{
+    LED_STEP(RED_LED_ON,    RGB_LED_GREEN,  PMOD_8LD_ALL_ON,        500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    PMOD_8LD_ALL_OFF,       500)
+};
+
+/**
+ * @brief Step table for LED_Pattern_5.
+ *
+ * LED1 and the RGB LED are off, and the PMOD 8LD module displays a ring counter pattern
+ * that shifts a single lit LED from LED0 to LED7 with 500 ms between each shift.
+ */
+static const LED_Step LED_Pattern_5_Steps[] =
+{
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x01,                   500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x02,                   500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x04,                   500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x08,                   500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x10,                   500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x20,                   500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x40,                   500),
+    LED_STEP(RED_LED_OFF,   RGB_LED_OFF,    0x80,                   500)
+};
+
+#if LED_PMOD_8LD_BCM
+/**
+ * @brief Step table and brightness table for LED_Pattern_6.
+ *
+ * LED1 is off, the RGB LED displays a sky blue color, and the PMOD 8LD module displays a comet that moves
+ * from LED0 to LED7 with 125 ms between each move. The brightness halves at each LED of its tail.
+ * The PMOD 8LD values of the steps are not displayed, since the BCM engine drives P9.
+ */
+static const LED_Step LED_Pattern_6_Steps[] =
+{
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125),
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125),
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125),
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125),
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125),
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125),
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125),
+    LED_STEP(RED_LED_OFF,   RGB_LED_SKY_BLUE, 0x00,                 125)
+};
+
+// Brightness of LED0 to LED7 for every step of LED_Pattern_6
+static const uint8_t LED_Pattern_6_Brightness[8][8] =
+{
+    { 255,   2,   4,   8,  16,  32,  64, 128 },
+    { 128, 255,   2,   4,   8,  16,  32,  64 },
+    {  64, 128, 255,   2,   4,   8,  16,  32 },
+    {  32,  64, 128, 255,   2,   4,   8,  16 },
+    {  16,  32,  64, 128, 255,   2,   4,   8 },
+    {   8,  16,  32,  64, 128, 255,   2,   4 },
+    {   4,   8,  16,  32,  64, 128, 255,   2 },
+    {   2,   4,   8,  16,  32,  64, 128, 255 }
+};
+#endif
+
+// Number of steps in a step table
+#define LED_STEP_COUNT(steps)   ((uint16_t)(sizeof(steps) / sizeof(LED_Step)))
+
+// Frame buffer of a streamed pattern, or 0 if streaming is disabled
+#if LED_PMOD_8LD_STREAMING
+#define LED_PATTERN_FRAMES(frames)  (frames)
+#else
+#define LED_PATTERN_FRAMES(frames)  0
+#endif
+
+// Pattern descriptors, stored in flash with the constant step tables
+static const LED_Pattern LED_Pattern_1_Both_Pressed  = { LED_Pattern_1_Both_Pressed_Steps, LED_STEP_COUNT(LED_Pattern_1_Both_Pressed_Steps), 0, 0 };
+static const LED_Pattern LED_Pattern_1_Button_1      = { LED_Pattern_1_Button_1_Steps, LED_STEP_COUNT(LED_Pattern_1_Button_1_Steps), 0, 0 };
+static const LED_Pattern LED_Pattern_1_Button_2      = { LED_Pattern_1_Button_2_Steps, LED_STEP_COUNT(LED_Pattern_1_Button_2_Steps), 0, 0 };
+static const LED_Pattern LED_Pattern_1_Released      = { LED_Pattern_1_Released_Steps, LED_STEP_COUNT(LED_Pattern_1_Released_Steps), 0, 0 };
+static const LED_Pattern LED_Pattern_2               = { LED_Pattern_2_Steps, LED_PATTERN_2_LENGTH, LED_PATTERN_FRAMES(LED_Pattern_2_Frames), 0 };
+static const LED_Pattern LED_Pattern_3               = { LED_Pattern_3_Steps, LED_PATTERN_3_LENGTH, LED_PATTERN_FRAMES(LED_Pattern_3_Frames), 0 };
+static const LED_Pattern LED_Pattern_4               = { LED_Pattern_4_Steps, LED_STEP_COUNT(LED_Pattern_4_Steps), 0, 0 };
+static const LED_Pattern LED_Pattern_5               = { LED_Pattern_5_Steps, LED_STEP_COUNT(LED_Pattern_5_Steps), 0, 0 };
+#if LED_PMOD_8LD_BCM
+static const LED_Pattern LED_Pattern_6               = { LED_Pattern_6_Steps, LED_STEP_COUNT(LED_Pattern_6_Steps), 0, &LED_Pattern_6_Brightness[0][0] };
+#endif
+
+/**
+ * @brief LED_BUTTON_INDEX packs the button status (P1.1 and P1.4) into a 2-bit index.
+ *
+ *  button_status   P1.4    P1.1    Index
+ *  -------------   ----    ----    -----
+ *      0x00         0       0        0      Button 1 and Button 2 are pressed
+ *      0x02         0       1        1      Button 2 is pressed
+ *      0x10         1       0        2      Button 1 is pressed
+ *      0x12         1       1        3      Button 1 and Button 2 are not pressed
+ */
+#define LED_BUTTON_INDEX(button_status) ((((button_status) >> 3) & 0x02) | (((button_status) >> 1) & 0x01))
+
+// A row of LED_Pattern_Table for LED_Pattern_1, which depends on the button index
+#define LED_PATTERN_1_ROW       { &LED_Pattern_1_Both_Pressed, &LED_Pattern_1_Button_2, &LED_Pattern_1_Button_1, &LED_Pattern_1_Released }
+
+// A row of LED_Pattern_Table for a pattern that ignores the buttons
+#define LED_PATTERN_ROW(pattern) { (pattern), (pattern), (pattern), (pattern) }
+
+/**
+ * @brief LED_Pattern_Table maps every switch status and button index to a pattern descriptor.
+ *
+ * The table is indexed directly by the 4-bit switch status and by LED_BUTTON_INDEX,
+ * so selecting a pattern takes the same time for every input and does not branch. Switch
+ * statuses without a dedicated pattern display LED_Pattern_1. A new pattern is added by
+ * defining its step table and descriptor and referencing it in this table.
+ */
+static const LED_Pattern * const LED_Pattern_Table[16][4] =
+{
+    LED_PATTERN_1_ROW,                      // 0x00
+    LED_PATTERN_ROW(&LED_Pattern_2),        // 0x01
+    LED_PATTERN_ROW(&LED_Pattern_3),        // 0x02
+#if LED_PMOD_8LD_BCM
+    LED_PATTERN_ROW(&LED_Pattern_6),        // 0x03
+#else
+    LED_PATTERN_1_ROW,                      // 0x03
+#endif
+    LED_PATTERN_ROW(&LED_Pattern_4),        // 0x04
+    LED_PATTERN_1_ROW,                      // 0x05
+    LED_PATTERN_1_ROW,                      // 0x06
+    LED_PATTERN_1_ROW,                      // 0x07
+    LED_PATTERN_ROW(&LED_Pattern_5),        // 0x08
+    LED_PATTERN_1_ROW,                      // 0x09
+    LED_PATTERN_1_ROW,                      // 0x0A
+    LED_PATTERN_1_ROW,                      // 0x0B
+    LED_PATTERN_1_ROW,                      // 0x0C
+    LED_PATTERN_1_ROW,                      // 0x0D
+    LED_PATTERN_1_ROW,                      // 0x0E
+    LED_PATTERN_1_ROW                       // 0x0F
+};
+
+// Marks a switch status without a pattern from the configuration store in LED_Config_Index
+#define LED_CONFIG_NONE         0xFF
+
+// Descriptors of the patterns of the configuration store, whose steps are read in place from INFO flash,
+// and the descriptor that replaces the row of LED_Pattern_Table of every switch status (see LED_Load_Config)
+static LED_Pattern LED_Config_Patterns[CONFIG_STORE_MAX_PATTERNS];
+static uint8_t LED_Config_Index[16];
+
+// Settings that can be replaced by the configuration store
+static uint32_t LED_Idle_Clock_Hz = LED_IDLE_CLOCK_HZ;
+static uint8_t LED_Debounce_Samples = DEBOUNCE_SAMPLES;
+
+// MCLK frequency requested by LED_Select_Pattern and applied by the main loop (LED_Apply_Clock), or 0 if none is pending
+static volatile uint32_t LED_Clock_Request = 0;
+
+/**
+ * @brief The LED_RGB_Output function displays one of the RGB_LED_ colors on the RGB LED.
+ *
+ * In PWM mode (LED_RGB_PWM = 1), each color bit selects full or zero brightness of its channel, and the RGB LED
+ * fades to the new color in LED_RGB_FADE_MS milliseconds without blocking. Otherwise, the color is written with LED2_Write.
+ *
+ * @param rgb_value The color of the RGB LED (RGB_LED_OFF to RGB_LED_WHITE).
+ *
+ * @return None
+ */
+RAMFUNC void LED_RGB_Output(uint8_t rgb_value)
+{
+    if (LED_RGB_PWM)
+    {
+        RGB_PWM_Fade((rgb_value & 0x01) ? 255 : 0, (rgb_value & 0x02) ? 255 : 0, (rgb_value & 0x04) ? 255 : 0,
+                     LED_RGB_FADE_MS);
+    }
+    else
+    {
+        LED2_Write(rgb_value);
+    }
+}
+
+/**
+ * @brief The LED_Output_Step function decodes one pattern step into the back frame.
+ *
+ * The step is displayed by LED_Frame_Commit at the next tick boundary. Drawing again before the commit
+ * replaces the step, so only the last step drawn within a tick is displayed.
+ *
+ * @param step      The step that will be displayed, in the packed format.
+ * @param outputs   The outputs owned by the frame (LED_FRAME_ALL, or LED_FRAME_LED1 | LED_FRAME_RGB while the DMA controller
+ *                  or the BCM engine drives the PMOD 8LD module).
  *
  * @return None
  */
-void PMOD_SWT_Init()
+RAMFUNC void LED_Output_Step(LED_Step step, uint8_t outputs)
 {
-    P10->SEL0 &= ~0xF;
-    P10->SEL1 &= ~0xF;
-    P10->DIR &= ~0xF;
+    // Cancel a pending commit first, so that the tick cannot display a partially drawn frame
+    LED_Frame_Ready = 0;
+    LED_Frame *frame = &LED_Frames[LED_Frame_Front ^ 1];
+
+    frame->led1_value = LED_STEP_LED1(step);
+    frame->rgb_value = LED_STEP_RGB(step);
+    frame->pmod_8ld_value = LED_STEP_PMOD_8LD(step);
+    frame->outputs = outputs;
+
+    LED_Frame_Ready = 1;
 }
 
 /**
- * @brief The PMOD_SWT_Status function gets the input values of the PMOD SWT.
+ * @brief The LED_Frame_Commit function displays the back frame if a new frame has been drawn.
  *
- * This function reads the values of the four slide switches on the PMOD SWT
- * from the P10 IN register. A bitwise AND operation (& 0xF) is performed to mask
- * the upper four bits of the input register, keeping only the lower four bits
- * that correspond to the switch positions.
+ * This function is called by LED_Tick at the tick boundary. The front and back frames are swapped,
+ * and the outputs that differ from the last commit are written back to back, so all LEDs change together.
  *
  * @param None
  *
- * @return Indicates the status of the switches.
- *
- *  SWT1    SWT2    SWT3    SWT4    switch_status
- *  ----    ----    ----    ----    -------------
- *  OFF     OFF     OFF     OFF         0x00
- *  ON      OFF     OFF     OFF         0x01
- *  OFF     ON      OFF     OFF         0x02
- *  ON      ON      OFF     OFF         0x03
- *  OFF     OFF     ON      OFF         0x04
- *  ON      OFF     ON      OFF         0x05
- *  OFF     ON      ON      OFF         0x06
- *  ON      ON      ON      OFF         0x07
- *  OFF     OFF     OFF     ON          0x08
- *  ON      OFF     OFF     ON          0x09
- *  OFF     ON      OFF     ON          0x0A
- *  ON      ON      OFF     ON          0x0B
- *  OFF     OFF     ON      ON          0x0C
- *  ON      OFF     ON      ON          0x0D
- *  OFF     ON      ON      ON          0x0E
- *  ON      ON      ON      ON          0x0F
- *
- */
-uint8_t PMOD_SWT_Status()
-{
-    uint8_t switch_status = P10->IN & 0xF;
-    return switch_status;
+ * @return None
+ */
+RAMFUNC void LED_Frame_Commit()
+{
+    if (!LED_Frame_Ready)
+    {
+        return;
+    }
+
+    uint8_t front = LED_Frame_Front ^ 1;
+    LED_Frame_Front = front;
+    LED_Frame_Ready = 0;
+
+    const LED_Frame *frame = &LED_Frames[front];
+    uint8_t known = LED_Frame_Displayed.outputs;
+    uint8_t changed = 0;
+    if ((frame->outputs & LED_FRAME_LED1) &&
+        (!(known & LED_FRAME_LED1) || (frame->led1_value != LED_Frame_Displayed.led1_value)))
+    {
+        LED1_Write(frame->led1_value);
+        LED_Frame_Displayed.led1_value = frame->led1_value;
+        changed = 1;
+    }
+    if ((frame->outputs & LED_FRAME_RGB) &&
+        (!(known & LED_FRAME_RGB) || (frame->rgb_value != LED_Frame_Displayed.rgb_value)))
+    {
+        LED_RGB_Output(frame->rgb_value);
+        LED_Frame_Displayed.rgb_value = frame->rgb_value;
+        changed = 1;
+    }
+    if (frame->outputs & LED_FRAME_PMOD_8LD)
+    {
+        if (!(known & LED_FRAME_PMOD_8LD) || (frame->pmod_8ld_value != LED_Frame_Displayed.pmod_8ld_value))
+        {
+            PMOD_Bus_Set(&Board_PMOD_Bus, BOARD_PMOD_8LD, frame->pmod_8ld_value);
+            LED_Frame_Displayed.pmod_8ld_value = frame->pmod_8ld_value;
+            changed = 1;
+        }
+    }
+    else
+    {
+        // The DMA controller or the BCM engine drives P9, so the next frame that owns it must write it
+        known = known & ~LED_FRAME_PMOD_8LD;
+    }
+    LED_Frame_Displayed.outputs = known | (frame->outputs & LED_FRAME_ALL);
+
+    // Write every PMOD that was set with one access per port
+    PROFILE_START(PROFILE_PMOD_8LD_OUTPUT);
+    PMOD_Bus_Write(&Board_PMOD_Bus);
+    PROFILE_STOP(PROFILE_PMOD_8LD_OUTPUT);
+
+    // Signal the output change to the latency measurement (Benchmark build configuration only)
+    // and record the time to the first valid output
+    if (changed)
+    {
+        BENCHMARK_MARK();
+        Boot_Output_Changed();
+    }
 }
 
 /**
- * @brief The LED_Pattern_1 function sets the output of the user LEDs and the 8 PMOD LEDs based on the status of the user buttons.
+ * @brief The LED_Select_Pattern function selects an LED pattern based on button and switch statuses.
  *
- * This function sets the output of both the built-in red LED (P1.0), the RGB LED (P2.0 - P2.2), and the 8 PMOD LEDs (P9.0 - P9.7) based on
- * the status of the Button 1 (P1.1) and Button 2 (P1.4).
+ * This function looks up the LED pattern to display in LED_Pattern_Table based on the given button status and switch status,
+ * unless the configuration store provides a pattern for the switch status.
+ * When a different pattern is selected, the pattern engine restarts from the first step of the new pattern
+ * and draws it, so it is displayed at the next tick boundary. The MCLK frequency is lowered to LED_Idle_Clock_Hz for a held pattern
+ * and raised to LED_ACTIVE_CLOCK_HZ otherwise. The frequency is only requested here and applied by the main loop,
+ * since the PCM transition of a VCORE change can take longer than a tick. The frame buffer of a streamed pattern or the BCM engine of a brightness pattern
+ * is started on the PMOD 8LD module, and the writer of the previous pattern is stopped first, so that only one writer drives P9:
+ * the DMA controller, the BCM engine, or LED_Frame_Commit.
  *
- * @param button_status An 8-bit unsigned integer that indicates the status of Button 1 and Button 2.
+ * @param button_status An 8-bit unsigned integer representing the status of the user buttons. This value is used to determine
+ *                      the LED pattern in some cases.
+ * @param switch_status An 8-bit unsigned integer representing the status of the switches on the PMOD SWT. This value is used
+ *                      to select the LED pattern to display.
  *
- *  button_status      LED 1 Color          RGB LED Color               PMOD 8 LED
- *  -------------      -----------        -----------------             --------------
- *      0x00            1 Hz Flash          1 Hz Blue FLash                 All Off
- *      0x10               On                    Off                     0, 2, 4, 6 ON
- *      0x02               Off                   Pink                    1, 3, 5, 7 ON
- *      0x12               Off                   Green                      All On
+ * @return Indicates whether the pattern has changed.
+ *  - 0: The active pattern is unchanged
+ *  - 1: A different pattern was selected and its first step was drawn
+ */
+uint8_t LED_Select_Pattern(uint8_t button_status, uint8_t switch_status)
+{
+    uint8_t switch_index = switch_status & 0x0F;
+    uint8_t button_index = LED_BUTTON_INDEX(button_status);
+    const LED_Pattern *pattern = LED_Pattern_Table[switch_index][button_index];
+
+    // The patterns of the configuration store are dropped once an update erases their sector
+    uint8_t config_index = LED_Config_Index[switch_index];
+    if ((config_index != LED_CONFIG_NONE) && (ConfigStore_Get() != 0))
+    {
+        pattern = &LED_Config_Patterns[config_index];
+    }
+
+    if (pattern == LED_Engine.pattern)
+    {
+        return 0;
+    }
+
+    if (LED_Engine.pattern != 0)
+    {
+        Trace_Record(TRACE_EVENT_PATTERN_EXIT, LED_Engine.step_index, LED_Engine.elapsed_ms);
+    }
+    Trace_Record(TRACE_EVENT_PATTERN_ENTRY, (switch_index << 2) | button_index, pattern->step_count);
+
+    LED_Engine.pattern = pattern;
+    LED_Engine.step_index = 0;
+    LED_Engine.elapsed_ms = 0;
+    LED_Engine.streaming = 0;
+    PMOD_8LD_DMA_Stop();
+    if (LED_Engine.brightness)
+    {
+        PMOD_8LD_BCM_Stop();
+        LED_Engine.brightness = 0;
+    }
+
+    if (pattern->pmod_8ld_frames != 0)
+    {
+        LED_Engine.streaming = PMOD_8LD_DMA_Start(pattern->pmod_8ld_frames, pattern->step_count,
+                                                  LED_STEP_DURATION_MS(pattern->steps[0]), 1);
+    }
+    else if (LED_PMOD_8LD_BCM && (pattern->pmod_8ld_brightness != 0))
+    {
+        PMOD_8LD_BCM_Set(&pattern->pmod_8ld_brightness[0]);
+        PMOD_8LD_BCM_Start();
+        LED_Engine.brightness = 1;
+    }
+
+    if (LED_Engine.streaming || LED_Engine.brightness)
+    {
+        LED_Output_Step(pattern->steps[0], LED_FRAME_LED1 | LED_FRAME_RGB);
+    }
+    else
+    {
+        LED_Output_Step(pattern->steps[0], LED_FRAME_ALL);
+    }
+
+    // A held pattern only needs a few cycles per tick, so it runs at the lower clock frequency
+    if (!LED_Engine.streaming && (pattern->step_count == 1) && (LED_STEP_DURATION_MS(pattern->steps[0]) == 0))
+    {
+        LED_Clock_Request = LED_Idle_Clock_Hz;
+    }
+    else
+    {
+        LED_Clock_Request = LED_ACTIVE_CLOCK_HZ;
+    }
+    return 1;
+}
+
+/**
+ * @brief The LED_Controller function selects an LED pattern based on button and switch statuses and advances it by one tick.
+ *
+ * This function calls LED_Select_Pattern. If the active pattern is unchanged, the elapsed time of the current step
+ * is advanced by one tick and the next step is drawn once the duration of the current step has expired.
+ *
+ * LED_Controller never blocks. It must be called once per tick (LED_TICK_MS), which limits the delay
+ * between an input change and the corresponding output change to one tick for every pattern.
  *
+ * @param button_status An 8-bit unsigned integer representing the status of the user buttons.
+ * @param switch_status An 8-bit unsigned integer representing the status of the switches on the PMOD SWT.
  *
  * @return None
  */
-void LED_Pattern_1(uint8_t button_status)
+void LED_Controller(uint8_t button_status, uint8_t switch_status)
 {
-    switch(button_status)
+    if (LED_Select_Pattern(button_status, switch_status))
+    {
+        return;
+    }
+
+    // A step with a duration of 0 is held until a different pattern is selected,
+    // and the frames of a streamed pattern are advanced by the DMA controller
+    const LED_Pattern *pattern = LED_Engine.pattern;
+    uint16_t duration_ms = LED_STEP_DURATION_MS(pattern->steps[LED_Engine.step_index]);
+    if ((duration_ms == 0) || LED_Engine.streaming)
+    {
+        return;
+    }
+
+    LED_Engine.elapsed_ms = LED_Engine.elapsed_ms + LED_TICK_MS;
+    if (LED_Engine.elapsed_ms >= duration_ms)
     {
-        // Button 1 and Button 2 are pressed
-        case 0x00:
+        LED_Engine.elapsed_ms = 0;
+        LED_Engine.step_index = LED_Engine.step_index + 1;
+        if (LED_Engine.step_index >= pattern->step_count)
         {
-            PMOD_8LD_Output(PMOD_8LD_ALL_OFF);
-            LED1_Output(RED_LED_ON);
-            LED2_Output(RGB_LED_BLUE);
-            Clock_Delay1ms(500);
-            LED1_Output(RED_LED_OFF);
-            LED2_Output(RGB_LED_OFF);
-            Clock_Delay1ms(500);
-            break;
+            LED_Engine.step_index = 0;
         }
 
-        // Button 1 is pressed
-        // Button 2 is not pressed
-        case 0x10:
+        // The brightness of the step replaces the displayed brightness at the start of the next BCM frame
+        if (LED_Engine.brightness)
         {
-            LED1_Output(RED_LED_ON);
-            LED2_Output(RGB_LED_OFF);
-            PMOD_8LD_Output(PMOD_8LD_0_2_4_6_ON);
-            break;
+            PMOD_8LD_BCM_Set(&pattern->pmod_8ld_brightness[LED_Engine.step_index * 8]);
+            LED_Output_Step(pattern->steps[LED_Engine.step_index], LED_FRAME_LED1 | LED_FRAME_RGB);
         }
-
-        // Button 1 is not pressed
-        // Button 2 is pressed
-        case 0x02:
+        else
         {
-            LED1_Output(RED_LED_OFF);
-            LED2_Output(RGB_LED_PINK);
-            PMOD_8LD_Output(PMOD_8LD_1_3_5_7_ON);
-            break;
+            LED_Output_Step(pattern->steps[LED_Engine.step_index], LED_FRAME_ALL);
         }
+    }
+}
 
-        // Button 1 and Button 2 are not pressed
-        case 0x12:
+/**
+ * @brief The LED_Idle_Mode function selects the idle mode used until the next tick or input event.
+ *
+ * LPM3 stops SysTick, the DMA controller, the RGB LED PWM, the BCM engine, and the UART0 clock, so it is only selected while the active step
+ * is held until the pattern changes, its frame has been committed, and neither the RGB LED PWM nor the UART0 backchannel is used.
+ * Otherwise, LPM0 keeps SysTick and the frame streaming running and wakes the core on the next tick.
+ *
+ * @param None
+ *
+ * @return LOW_POWER_ACTIVE, LOW_POWER_LPM0, or LOW_POWER_LPM3.
+ */
+uint8_t LED_Idle_Mode()
+{
+    if (LED_IDLE_MODE == LOW_POWER_LPM3)
+    {
+        const LED_Pattern *pattern = LED_Engine.pattern;
+        if (!LED_RGB_PWM && !LED_TELEMETRY && !LED_Frame_Ready && (pattern != 0) && !LED_Engine.streaming &&
+            !LED_Engine.brightness &&
+            (LED_STEP_DURATION_MS(pattern->steps[LED_Engine.step_index]) == 0))
         {
-            LED1_Output(RED_LED_OFF);
-            LED2_Output(RGB_LED_GREEN);
-            PMOD_8LD_Output(PMOD_8LD_ALL_ON);
-            break;
+            return LOW_POWER_LPM3;
         }
+        return LOW_POWER_LPM0;
     }
+    return LED_IDLE_MODE;
 }
 
 /**
- * @brief The LED_Pattern_2 function controls the user LEDs and the eight LEDs on the PMOD 8LD module.
- *
- * This function turns on LED1 with a red color, sets the RGB LED to display a red color,
- * and then initiates a binary counter pattern on the PMOD 8LD module. The counter starts from 0
- * and increments up to 255 (0xFF) with a delay of 100 ms between each count. The sequence stops if
- * a specific switch status is detected or if led_count has reached 0xFF.
+ * @brief The LED_Apply_Clock function applies the MCLK frequency requested by LED_Select_Pattern.
  *
+ * This function is called by the main loop, which runs below every task, so the tasks and the interrupt handlers
+ * preempt Clock_SetProfile while it waits for the PCM. A request made during the change is applied by the next call.
  *
  * @param None
  *
  * @return None
  */
-void LED_Pattern_2()
+void LED_Apply_Clock()
 {
-    LED1_Output(RED_LED_ON);
-    LED2_Output(RGB_LED_RED);
+    // The pattern task can replace the request at any time, so it is read and cleared together
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t frequency = LED_Clock_Request;
+    LED_Clock_Request = 0;
+    __set_PRIMASK(primask);
 
-    for (uint8_t led_count = 0; led_count <= 0xFF; led_count++)
+    if (frequency != 0)
     {
-        PMOD_8LD_Output(led_count);
-        Clock_Delay1ms(100);
-        uint8_t switch_status = PMOD_SWT_Status();
-        if (switch_status != 0x01)
-        {
-            break;
-        }
+        Clock_SetProfile(frequency);
     }
 }
 
 /**
- * @brief The LED_Pattern_3 function controls the user LEDs and the eight LEDs on the PMOD 8LD module.
+ * @brief The LED_Clock_Changed function keeps the tick period at LED_TICK_MS after a clock frequency change.
+ *
+ * This function is registered with Clock_AddListener by LED_Init_Clocked, once the switch to 48 MHz is complete,
+ * and called by Clock_SetProfile.
+ *
+ * @param frequency The new MCLK frequency in Hz.
  *
- * This function turns off LED1, sets the RGB LED to display a blue color,
- * and then initiates a binary counter pattern on the PMOD 8LD module. The counter starts from 255 (0xFF)
- * and decrements down to 0 with a delay of 100 ms between each count. The sequence runs infinitely until another switch
- * status is detected.
+ * @return None
+ */
+void LED_Clock_Changed(uint32_t frequency)
+{
+    SysTickInts_Set_Period((frequency / 1000) * LED_TICK_MS);
+    Trace_Record(TRACE_EVENT_CLOCK, 0, frequency / 1000000);
+}
+
+/**
+ * @brief The LED_Tick function is called by SysTick_Handler once per tick.
  *
+ * This function first commits the frame drawn during the previous tick, so the outputs always change
+ * at the tick boundary. Then, it counts the pending ticks, samples the debounced inputs, and posts the input task.
+ * The pattern engine is advanced by the pattern task, so the interrupt handler stays short.
  *
  * @param None
  *
  * @return None
  */
-void LED_Pattern_3()
+RAMFUNC void LED_Tick()
 {
-    LED1_Output(RED_LED_OFF);
-    LED2_Output(RGB_LED_BLUE);
+    LED_Frame_Commit();
+    Tick_Pending = Tick_Pending + 1;
+    InputEvents_Poll();
+    Scheduler_Post(LED_Input_Task_Id);
+}
 
-    for (uint8_t led_count = 0xFF; led_count >= 0; led_count--) // infinite loop but the uint8_t variable led_count will roll back to 0xFF after reaching 0
+/**
+ * @brief The LED_Input_Task function applies the input events and posts the pattern task.
+ *
+ * This task runs at LED_INPUT_TASK_PRIORITY after every tick, and whenever the main loop finds input events
+ * that were recorded while the tick was stopped or the host overrides change. It is the only consumer of the
+ * InputEvents ring buffer. The events are applied in the order they were recorded, and the resulting input status,
+ * with the host overrides applied, is published to the pattern task in LED_Input_Status.
+ *
+ * @param None
+ *
+ * @return None
+ */
+RAMFUNC void LED_Input_Task()
+{
+    Input_Event event;
+    while (InputEvents_Get(&event))
     {
-        PMOD_8LD_Output(led_count);
-        Clock_Delay1ms(100);
-        uint8_t switch_status = PMOD_SWT_Status();
-        if (switch_status != 0x02)
+        if (event.source == INPUT_EVENT_BUTTONS)
+        {
+            LED_Button_Input = event.status;
+        }
+        else
         {
-            break;
+            LED_Switch_Input = event.status;
         }
     }
+
+    uint8_t button_status = LED_Button_Input;
+    uint8_t switch_status = LED_Switch_Input;
+    Telemetry_Apply_Overrides(&button_status, &switch_status);
+    LED_Input_Status = ((uint16_t)switch_status << 8) | button_status;
+    Scheduler_Post(LED_Pattern_Task_Id);
 }
 
 /**
- * @brief The LED_Pattern_4 function controls the user LEDs and the eight LEDs on the PMOD 8LD module.
+ * @brief The LED_Pattern_Task function selects the LED pattern and advances it once for every elapsed tick.
  *
- * This function toggles the red LED1, sets the RGB LED to display a green color and toggle it,
- * and toggles all the LEDs on the PMOD 8LD module. All toggling is done at a rate of 1 Hz.
+ * When a new pattern is selected, the pending ticks are dropped, since its first step is drawn by the next tick.
  *
+ * This task runs at LED_PATTERN_TASK_PRIORITY after the input task. It is the only code that changes the state
+ * of the pattern engine, so it does not need a critical section, and it preempts the telemetry in the main loop,
+ * so the steps are drawn on time however long the host commands take.
  *
  * @param None
  *
  * @return None
  */
-void LED_Pattern_4()
+RAMFUNC void LED_Pattern_Task()
 {
-    LED1_Output(RED_LED_ON);
-    LED2_Output(RGB_LED_GREEN);
-    PMOD_8LD_Output(PMOD_8LD_ALL_ON);
-    Clock_Delay1ms(500);
-    LED1_Output(RED_LED_OFF);
-    LED2_Output(RGB_LED_OFF);
-    PMOD_8LD_Output(PMOD_8LD_ALL_OFF);
-    Clock_Delay1ms(500);
+    uint16_t input_status = LED_Input_Status;
+    uint8_t button_status = INPUT_SNAPSHOT_GET_BUTTONS(input_status);
+    uint8_t switch_status = INPUT_SNAPSHOT_GET_SWITCHES(input_status);
+
+    // More than one pending tick means that the task could not keep up with the tick period
+    uint32_t ticks_pending = Tick_Pending;
+    if (ticks_pending > 1)
+    {
+        Trace_Record(TRACE_EVENT_DELAY_OVERRUN, 0, (ticks_pending > 0xFFFF) ? 0xFFFF : ticks_pending);
+    }
+
+    // The first step of a new pattern is displayed by the next tick, which starts its duration,
+    // so the ticks that elapsed before the change are not counted
+    if (LED_Select_Pattern(button_status, switch_status))
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        Tick_Pending = 0;
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    // Advance the pattern engine once for every tick that has elapsed
+    while (Tick_Pending != 0)
+    {
+        // The tick increments the count, and PRIMASK is restored in case the task is run with interrupts disabled
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        Tick_Pending = Tick_Pending - 1;
+        __set_PRIMASK(primask);
+
+        PROFILE_START(PROFILE_LED_CONTROLLER);
+        LED_Controller(button_status, switch_status);
+        PROFILE_STOP(PROFILE_LED_CONTROLLER);
+    }
+}
+
+/**
+ * @brief The LED_Load_Config function applies the configuration found in INFO flash by ConfigStore_Init.
+ *
+ * The settings of a valid configuration replace LED_IDLE_CLOCK_HZ and DEBOUNCE_SAMPLES, and a descriptor is set up
+ * for each of its patterns. The steps are not copied: the descriptors point to the steps in INFO flash.
+ * Without a valid configuration, the built-in patterns and settings are used.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LED_Load_Config()
+{
+    for (uint32_t index = 0; index < 16; index++)
+    {
+        LED_Config_Index[index] = LED_CONFIG_NONE;
+    }
+
+    const Config_Data *config = ConfigStore_Init();
+    if (config == 0)
+    {
+        return;
+    }
+
+    if (config->idle_clock_hz != 0)
+    {
+        LED_Idle_Clock_Hz = config->idle_clock_hz;
+    }
+    if (config->debounce_samples != 0)
+    {
+        LED_Debounce_Samples = config->debounce_samples;
+    }
+
+    const LED_Step *steps = config->steps;
+    for (uint32_t index = 0; index < config->pattern_count; index++)
+    {
+        const Config_Pattern *entry = &config->patterns[index];
+        LED_Config_Patterns[index].steps = steps;
+        LED_Config_Patterns[index].step_count = entry->step_count;
+        LED_Config_Patterns[index].pmod_8ld_frames = 0;
+        LED_Config_Patterns[index].pmod_8ld_brightness = 0;
+        LED_Config_Index[entry->switch_status] = (uint8_t)index;
+        steps = steps + entry->step_count;
+    }
 }
 
 /**
- * @brief The LED_Pattern_5 function controls the user LEDs and the eight LEDs on the PMOD 8LD module.
+ * @brief The LED_Init_Peripherals function initializes the drivers that do not depend on the MCLK or SMCLK frequency.
  *
- * This function turns off LED1, turns off the RGB LED,
- * and displays a ring counter pattern on the PMOD 8LD module. The counter starts from 255 (0xFF)
- * and decrements down to 0 with a delay of 100 ms between each count. The sequence runs for 7 iterations or until another switch
- * status is detected.
+ * In the fast boot path, this function runs at 3 MHz while VCORE1 is reached and the 48 MHz crystal settles.
+ * The PMOD 8LD frame streaming is clocked by ACLK, and the debouncing is clocked by the tick.
+ * GPIO_Pins_Init must be called first.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void LED_Init_Peripherals()
+{
+    // Load the pattern tables and the settings stored in INFO flash, which are validated by the CRC32 module
+    LED_Load_Config();
+
+    // Drive the switch inputs through the loopback pins and start the latency measurement (Benchmark build configuration only)
+    Benchmark_Init(BENCHMARK_PRIORITY);
+
+    // Initialize the frame streaming of the PMOD 8LD module
+    PMOD_8LD_DMA_Init(PMOD_8LD_DMA_PRIORITY);
+
+    // Read the input PMODs through the PMOD bus in every input snapshot
+    InputSnapshot_Init(&Board_PMOD_Bus, BOARD_PMOD_SWT);
+
+    // Take the current inputs as the initial debounced state
+    Debounce_Init(LED_Debounce_Samples);
+
+    // Enable the edge-triggered interrupts of the user buttons
+    InputEvents_Init(INPUT_EVENTS_PRIORITY);
+}
+
+/**
+ * @brief The LED_Wait_Clock function waits for CS_IRQHandler to complete the switch to 48 MHz.
  *
+ * The state is checked with interrupts disabled, and __WFI also wakes the core for an interrupt that is
+ * pending while PRIMASK is set, so the CS interrupt cannot be missed between the check and the wait.
+ * If the switch fails, MCLK stays at 3 MHz and this function returns.
  *
  * @param None
  *
  * @return None
- */void LED_Pattern_5()
-{
-    LED1_Output(RED_LED_OFF);
-    LED2_Output(RGB_LED_OFF);
-    uint8_t shift_bit = 0x1;
-    for (uint8_t led_count = 0x0; led_count <= 0x7; led_count++)
-    {
-        PMOD_8LD_Output(shift_bit);
-        Clock_Delay1ms(500);
-        shift_bit = shift_bit << 1;
-        uint8_t switch_status = PMOD_SWT_Status();
-        if (switch_status != 0x08)
-        {
-            break;
-        }
+ */
+void LED_Wait_Clock()
+{
+    Clock_Status status;
+
+    __disable_irq();
+    Clock_GetStatus(&status);
+    while (status.state == CLOCK_STATE_STARTING)
+    {
+        __WFI();
+
+        // Take the pending interrupt
+        __enable_irq();
+        __disable_irq();
+        Clock_GetStatus(&status);
     }
+    __enable_irq();
 }
 
 /**
- * @brief The LED_Controller function selects and executes an appropriate LED pattern based on button and switch statuses.
+ * @brief The LED_Init_Clocked function initializes the drivers that count MCLK or SMCLK cycles and starts the tick.
  *
- * This function determines the LED pattern to execute based on the given button status and switch status.
- * It calls different pattern functions based on the switch status value.
+ * The switch to 48 MHz must be complete, so that Profile_Measure_Delays measures at 48 MHz and the UART0 baud rate
+ * and the Timer_A periods, which are set for the 12 MHz SMCLK, are correct. In the fast boot path, main calls
+ * LED_Wait_Clock first. Later changes of the MCLK frequency (Clock_SetProfile) are followed by LED_Clock_Changed.
  *
- * @param button_status An 8-bit unsigned integer representing the status of the user buttons. This value is used to determine
- *                      the LED pattern in some cases.
- * @param switch_status An 8-bit unsigned integer representing the status of the switches on the PMOD SWT. This value is used
- *                      to select the LED pattern to execute.
+ * @param None
  *
  * @return None
  */
-void LED_Controller(uint8_t button_status, uint8_t switch_status)
+void LED_Init_Clocked()
 {
-    switch(switch_status)
+    // Start the cycle counter and measure the drift of Clock_Delay1ms (Debug build configuration only)
+    Profile_Init();
+    Profile_Measure_Delays();
+
+    // Clear the event trace, which is timestamped with the cycle counter
+    Trace_Init();
+
+    // Initialize the PWM of the RGB LED
+    if (LED_RGB_PWM)
     {
-        case 0x00:
-        {
-            LED_Pattern_1(button_status);
-        }
-        break;
+        RGB_PWM_Init(RGB_PWM_PRIORITY);
+    }
 
-        case 0x01:
-        {
-            LED_Pattern_2();
-        }
-        break;
-        case 0x02:
-        {
-            LED_Pattern_3();
-        }
-        break;
-        case 0x04:
-        {
-            LED_Pattern_4();
-        }
-        break;
-        case 0x08:
-        {
-            LED_Pattern_5();
-        }
-        break;
-        default:
-        {
-            LED_Pattern_1(button_status);
-        }
+    // Initialize the BCM engine of the PMOD 8LD module, which counts SMCLK
+    if (LED_PMOD_8LD_BCM)
+    {
+        PMOD_8LD_BCM_Init(PMOD_8LD_BCM_PRIORITY);
     }
+
+    // Take the debounced inputs as the initial input state (the buttons and the switches come from the same
+    // snapshots, see InputSnapshot.h), and add the tasks that are posted by the tick
+    uint16_t inputs = Debounce_Get_Inputs();
+    LED_Button_Input = INPUT_SNAPSHOT_GET_BUTTONS(inputs);
+    LED_Switch_Input = INPUT_SNAPSHOT_GET_SWITCHES(inputs);
+    LED_Input_Status = inputs;
+    LED_Input_Task_Id = Scheduler_Add(&LED_Input_Task, LED_INPUT_TASK_PRIORITY);
+    LED_Pattern_Task_Id = Scheduler_Add(&LED_Pattern_Task, LED_PATTERN_TASK_PRIORITY);
+
+    // Start the pattern engine tick. The listener is registered first and the tick is started
+    // with interrupts disabled, so the period follows a change of the MCLK frequency made by an interrupt handler.
+    Clock_AddListener(&LED_Clock_Changed);
+    __disable_irq();
+    SysTickInts_Init(&LED_Tick, (Clock_GetFreq() / 1000) * LED_TICK_MS, LED_TICK_PRIORITY);
+    __enable_irq();
+
+    // Poll the switches in LPM3 with RTC_C
+    LowPower_Init(LOW_POWER_PRIORITY);
 }
 
 int main(void)
 {
-    // Initialize the 48 MHz Clock
-    Clock_Init48MHz();
+    // Start the boot time measurement (see Boot.h), which also records the switch to 48 MHz
+    Boot_Init();
+    Clock_AddListener(&Boot_Clock_Changed);
 
-    // Initialize the built-in red LED and the RGB LEDs
-    LED1_Init();
-    LED2_Init();
+    if (LED_FAST_BOOT)
+    {
+        // Drive every output to its off level first, then start the switch to 48 MHz, which is completed by
+        // CS_IRQHandler once VCORE1 is reached and the crystal is stable. Until then, the program runs at 3 MHz.
+        GPIO_Pins_Init(Board_Pins, GPIO_PINS_COUNT(Board_Pins));
+        PMOD_Bus_Init(&Board_PMOD_Bus, Board_PMODs, PMOD_DEVICE_COUNT(Board_PMODs));
+        Boot_Mark(BOOT_STAGE_OUTPUTS_SAFE);
+        Clock_Init48MHz_Async(CLOCK_PRIORITY);
+        Boot_Mark(BOOT_STAGE_CLOCK_STARTED);
+        LED_Init_Peripherals();
+        Boot_Mark(BOOT_STAGE_PERIPHERALS);
 
-    // Initialize the user buttons
-    Buttons_Init();
+        // The remaining drivers count MCLK or SMCLK cycles, so they are initialized at 48 MHz
+        LED_Wait_Clock();
+    }
+    else
+    {
+        // Initialize the 48 MHz Clock, then the built-in red LED, the RGB LED, the user buttons,
+        // the PMOD 8LD module, and the PMOD SWT module
+        Clock_Init48MHz_Start();
+        Boot_Mark(BOOT_STAGE_CLOCK_STARTED);
+        Clock_Init48MHz_Finish();
+        GPIO_Pins_Init(Board_Pins, GPIO_PINS_COUNT(Board_Pins));
+        PMOD_Bus_Init(&Board_PMOD_Bus, Board_PMODs, PMOD_DEVICE_COUNT(Board_PMODs));
+        Boot_Mark(BOOT_STAGE_OUTPUTS_SAFE);
+        LED_Init_Peripherals();
+        Boot_Mark(BOOT_STAGE_PERIPHERALS);
+    }
+    LED_Init_Clocked();
 
-    // Initialize the PMOD 8LD module
-    PMOD_8LD_Init();
+    // Start the UART0 backchannel. The host overrides are applied by the input task.
+    if (LED_TELEMETRY)
+    {
+        Telemetry_Init(TELEMETRY_PRIORITY);
+    }
+    Boot_Mark(BOOT_STAGE_TICK_STARTED);
+    __enable_irq();
 
-    // Initialize the PMOD SWT module
-    PMOD_SWT_Init();
+    // Measure the register-access primitives at every clock profile (Microbench build configuration only).
+    // The pattern engine is stopped while the measurements run, with interrupts disabled.
+    Microbench_Run();
+
+    // Start the watchdog timer last, so that the boot sequence is not supervised.
+    // The counters retained through a watchdog reset are reported by Watchdog_Boot_Counters and the trace.
+    if (LED_WATCHDOG)
+    {
+        Watchdog_Init(LED_LOOP_BUDGET_US);
+    }
 
     while(1)
     {
-        uint8_t button_status = Get_Buttons_Status();
-        uint8_t switch_status = PMOD_SWT_Status();
-        LED_Controller(button_status, switch_status);
-        //Clock_Delay1ms(100);
+        if (LED_WATCHDOG)
+        {
+            Watchdog_Loop_Start();
+        }
+        PROFILE_START(PROFILE_MAIN_LOOP);
+
+        // Execute the commands received over UART0 and queue the telemetry that fits in the transmit buffer.
+        // The main loop runs below every task, so the pattern engine preempts the telemetry.
+        if (LED_TELEMETRY && Telemetry_Poll())
+        {
+            Scheduler_Post(LED_Input_Task_Id);
+        }
+
+        // Compute the latency statistics of a pattern once all of its samples are measured
+        Benchmark_Poll();
+
+        // Change the clock profile of the active pattern
+        LED_Apply_Clock();
+
+        PROFILE_STOP(PROFILE_MAIN_LOOP);
+        if (LED_WATCHDOG)
+        {
+            Watchdog_Loop_End();
+        }
+
+        // Sleep until the next tick, input event, or UART0 byte. Interrupts are disabled during the check,
+        // and an interrupt or a task that becomes pending afterwards still wakes the core.
+        // The events recorded in LPM3, where the tick is stopped, are applied by posting the input task,
+        // and a clock request made by the pattern task is applied before the core sleeps.
+        __disable_irq();
+        if (InputEvents_Available() != 0)
+        {
+            Scheduler_Post(LED_Input_Task_Id);
+        }
+        else if (!(LED_TELEMETRY && Telemetry_Has_Work()) && (LED_Clock_Request == 0))
+        {
+            LowPower_Sleep(LED_Idle_Mode());
+        }
+        __enable_irq();
     }
 }
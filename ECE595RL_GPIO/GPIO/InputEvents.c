@@ -0,0 +1,173 @@
+/**
+ * @file InputEvents.c
+ * @brief Source code for the InputEvents driver.
+ *
+ * This file contains the function definitions for the interrupt-driven input layer.
+ * PORT1_IRQHandler overrides the weak definition found in startup_msp432p401r_ccs.c.
+ *
+ * The ring buffer is lock-free: PORT1_IRQHandler is the only producer and writes the head index,
+ * while LED_Input_Task (run by the Scheduler driver from PendSV) is the only consumer and writes the
+ * tail index. Both indices are free-running and are masked with (INPUT_EVENTS_SIZE - 1) when the buffer
+ * is accessed.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/SysTickInts.h"
+#include "../inc/Debounce.h"
+#include "../inc/InputSnapshot.h"
+#include "../inc/InputEvents.h"
+#include "../inc/Trace.h"
+#include "../inc/RamFunc.h"
+
+// Mask of the user buttons (P1.1 and P1.4)
+#define BUTTONS_MASK            0x12
+
+static Input_Event Input_Event_Buffer[INPUT_EVENTS_SIZE];
+static volatile uint32_t Input_Event_Head = 0;
+static volatile uint32_t Input_Event_Tail = 0;
+static volatile uint32_t Input_Event_Overflows = 0;
+
+// Last state recorded for each source
+static volatile uint8_t Last_Buttons_Status;
+static volatile uint8_t Last_Switches_Status;
+
+/**
+ * @brief The InputEvents_Put function adds an event to the ring buffer.
+ *
+ * This function must only be called from PORT1_IRQHandler.
+ *
+ * @param source INPUT_EVENT_BUTTONS or INPUT_EVENT_SWITCHES.
+ * @param status The new state of the source.
+ *
+ * @return 1 if the event was added, 0 if the ring buffer is full.
+ */
+RAMFUNC static uint8_t InputEvents_Put(uint8_t source, uint8_t status)
+{
+    uint32_t head = Input_Event_Head;
+    if ((head - Input_Event_Tail) >= INPUT_EVENTS_SIZE)
+    {
+        Input_Event_Overflows = Input_Event_Overflows + 1;
+        return 0;
+    }
+
+    // Read the tick count and the cycles elapsed within the tick.
+    // If SysTick reloaded while reading (its interrupt is pending because it has a lower priority),
+    // the tick has not been counted yet, so it is added here.
+    uint32_t ticks = SysTickInts_Get_Ticks();
+    uint32_t value = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        ticks = ticks + 1;
+        value = SysTick->VAL;
+    }
+
+    Input_Event *event = &Input_Event_Buffer[head & (INPUT_EVENTS_SIZE - 1)];
+    event->ticks = ticks;
+    event->cycles = (uint16_t)(SysTick->LOAD - value);
+    event->source = source;
+    event->status = status;
+
+    // Publish the event only after it has been written
+    Input_Event_Head = head + 1;
+    return 1;
+}
+
+void InputEvents_Init(uint32_t priority)
+{
+    NVIC_DisableIRQ(PORT1_IRQn);
+
+    uint16_t inputs = Debounce_Get_Inputs();
+    Last_Buttons_Status = INPUT_SNAPSHOT_GET_BUTTONS(inputs);
+    Last_Switches_Status = INPUT_SNAPSHOT_GET_SWITCHES(inputs);
+    Input_Event_Head = 0;
+    Input_Event_Tail = 0;
+    Input_Event_Overflows = 0;
+
+    // Select the edge opposite to the current level:
+    // IES = 1 (high-to-low) for a released button, IES = 0 (low-to-high) for a pressed button
+    P1->IES = (P1->IES & ~BUTTONS_MASK) | (P1->IN & BUTTONS_MASK);
+
+    // Writing IES can set the interrupt flags, so they are cleared afterwards
+    P1->IFG &= ~BUTTONS_MASK;
+    P1->IE |= BUTTONS_MASK;
+
+    NVIC_SetPriority(PORT1_IRQn, priority);
+    NVIC_ClearPendingIRQ(PORT1_IRQn);
+    NVIC_EnableIRQ(PORT1_IRQn);
+}
+
+RAMFUNC void InputEvents_Poll(void)
+{
+    // Sample the buttons and the switches at the same moment, and record the new stable state
+    // with the time of the snapshot that completed the change
+    Input_Snapshot snapshot;
+    InputSnapshot_Take(&snapshot);
+    uint8_t changed = Debounce_Sample(snapshot.inputs);
+    uint16_t inputs = Debounce_Get_Inputs();
+    if (changed)
+    {
+        Trace_Record_At(snapshot.cycles, TRACE_EVENT_INPUTS, 0, inputs);
+    }
+
+    // A state that could not be recorded because the ring buffer was full is retried on every tick
+    if (changed ||
+        (INPUT_SNAPSHOT_GET_BUTTONS(inputs) != Last_Buttons_Status) ||
+        (INPUT_SNAPSHOT_GET_SWITCHES(inputs) != Last_Switches_Status))
+    {
+        NVIC_SetPendingIRQ(PORT1_IRQn);
+    }
+}
+
+uint8_t InputEvents_Get(Input_Event *event)
+{
+    uint32_t tail = Input_Event_Tail;
+    if (tail == Input_Event_Head)
+    {
+        return 0;
+    }
+
+    *event = Input_Event_Buffer[tail & (INPUT_EVENTS_SIZE - 1)];
+
+    // Release the slot only after it has been copied
+    Input_Event_Tail = tail + 1;
+    return 1;
+}
+
+uint32_t InputEvents_Available(void)
+{
+    return Input_Event_Head - Input_Event_Tail;
+}
+
+uint32_t InputEvents_Get_Overflows(void)
+{
+    return Input_Event_Overflows;
+}
+
+RAMFUNC void PORT1_IRQHandler(void)
+{
+    // Button edges only wake the core: re-arm both pins for the edge opposite to the current level
+    // and clear the flags. A missed edge does not matter, because the debounced state is sampled every tick.
+    P1->IES = (P1->IES & ~BUTTONS_MASK) | (P1->IN & BUTTONS_MASK);
+    P1->IFG &= ~BUTTONS_MASK;
+
+    // Record the changes of the debounced state detected by InputEvents_Poll.
+    // Both sources are taken from one read of the stable state. The last recorded state is only updated
+    // when the event was added, so InputEvents_Poll pends this handler again while the ring buffer is full.
+    uint16_t inputs = Debounce_Get_Inputs();
+    uint8_t buttons_status = INPUT_SNAPSHOT_GET_BUTTONS(inputs);
+    if ((buttons_status != Last_Buttons_Status) && InputEvents_Put(INPUT_EVENT_BUTTONS, buttons_status))
+    {
+        Last_Buttons_Status = buttons_status;
+        Trace_Record(TRACE_EVENT_BUTTONS, buttons_status, 0);
+    }
+
+    uint8_t switches_status = INPUT_SNAPSHOT_GET_SWITCHES(inputs);
+    if ((switches_status != Last_Switches_Status) && InputEvents_Put(INPUT_EVENT_SWITCHES, switches_status))
+    {
+        Last_Switches_Status = switches_status;
+        Trace_Record(TRACE_EVENT_SWITCHES, switches_status, 0);
+    }
+}
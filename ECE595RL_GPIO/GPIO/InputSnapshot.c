@@ -0,0 +1,47 @@
+/**
+ * @file InputSnapshot.c
+ * @brief Source code for the InputSnapshot driver.
+ *
+ * This file contains the function definitions for sampling the user buttons and the PMOD SWT switches
+ * into one packed word with a common timestamp.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/InputSnapshot.h"
+#include "../inc/PMOD.h"
+#include "../inc/RamFunc.h"
+
+// Bus of the input PMODs and index of the PMOD SWT on it, set by InputSnapshot_Init
+static PMOD_Bus *InputSnapshot_Bus;
+static uint32_t InputSnapshot_Switches;
+
+void InputSnapshot_Init(PMOD_Bus *bus, uint32_t switches)
+{
+    InputSnapshot_Bus = bus;
+    InputSnapshot_Switches = switches;
+}
+
+RAMFUNC uint16_t InputSnapshot_Take(Input_Snapshot *snapshot)
+{
+    // The caller may already run with interrupts disabled, so PRIMASK is restored instead of cleared.
+    // The input values of the bus are also read by every context that takes a snapshot, so they are
+    // copied before PRIMASK is restored.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t cycles = DWT->CYCCNT;
+    uint8_t buttons = P1->IN;
+    PMOD_Bus_Read(InputSnapshot_Bus);
+    uint8_t switches = PMOD_Bus_Get(InputSnapshot_Bus, InputSnapshot_Switches);
+    __set_PRIMASK(primask);
+
+    uint16_t inputs = (buttons & INPUT_SNAPSHOT_BUTTONS) | (((uint16_t)switches << 8) & INPUT_SNAPSHOT_SWITCHES);
+    if (snapshot)
+    {
+        snapshot->cycles = cycles;
+        snapshot->inputs = inputs;
+    }
+    return inputs;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file LowPower.c
+ * @brief Source code for the LowPower driver.
+ *
+ * This file contains the function definitions for the low-power idle modes used between pattern steps.
+ * RTC_C_IRQHandler overrides the weak definition found in startup_msp432p401r_ccs.c.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/InputEvents.h"
+#include "../inc/LowPower.h"
+#include "../inc/RamFunc.h"
+
+const LowPower_Mode_Info LowPower_Modes[3] =
+{
+    // current_ua   wake_latency_us
+    {  4500,        0       },  // LOW_POWER_ACTIVE: busy-wait at 48 MHz
+    {  2000,        1       },  // LOW_POWER_LPM0: core clock gated, wakes within a few cycles
+    {  1,           1000    }   // LOW_POWER_LPM3: about 9 us core wake-up plus the HFXT restart
+};
+
+void LowPower_Init(uint32_t priority)
+{
+    // Source BCLK from REFOCLK so that the RTC_C keeps running in LPM3
+    CS->KEY = 0x695A;                       // unlock CS module for register access
+    CS->CTL1 |= 0x00001000;                 // SELB = 1: BCLK sourced from REFOCLK
+    CS->KEY = 0;                            // lock CS module from unintended access
+
+    // Start the RTC_C in calendar mode so that the prescaler RT0PS counts BCLK
+    RTC_C->CTL0 = (RTC_C->CTL0 & ~0xFF00) | 0xA500;     // unlock RTC_C with RTCKEY
+    RTC_C->CTL13 &= ~0x0040;                            // clear RTCHOLD
+    RTC_C->CTL0 = RTC_C->CTL0 & ~0xFF00;                // lock RTC_C
+
+    // RT0IP = 7: interrupt interval of BCLK/256 (128 Hz, 7.8 ms), interrupt disabled until LPM3
+    RTC_C->PS0CTL = 0x001C;
+
+    NVIC_SetPriority(RTC_C_IRQn, priority);
+    NVIC_EnableIRQ(RTC_C_IRQn);
+}
+
+void LowPower_Sleep(uint8_t mode)
+{
+    switch(mode)
+    {
+        case LOW_POWER_LPM0:
+        {
+            // Sleep (not deep sleep) is LPM0: the core stops while all clocks keep running
+            SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+            __WFI();
+        }
+        break;
+
+        case LOW_POWER_LPM3:
+        {
+            // Sample the inputs with the RTC_C prescaler while SysTick is stopped
+            RTC_C->PS0CTL = (RTC_C->PS0CTL & ~0x0001) | 0x0002;
+
+            // Deep sleep with LPMR = LPM3 and the active mode request unchanged
+            PCM->CTL0 = (PCM->CTL0 & ~0xFFFF00F0) | 0x695A0000;
+            SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+            __WFI();
+            SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+            RTC_C->PS0CTL &= ~0x0002;
+        }
+        break;
+
+        default:
+        {
+            // LOW_POWER_ACTIVE: return to the busy-wait loop
+        }
+    }
+}
+
+RAMFUNC void RTC_C_IRQHandler(void)
+{
+    RTC_C->PS0CTL &= ~0x0001;               // clear RT0PSIFG
+    InputEvents_Poll();
+}
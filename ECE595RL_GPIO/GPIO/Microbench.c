@@ -0,0 +1,231 @@
+/**
+ * @file Microbench.c
+ * @brief Source code for the Microbench driver.
+ *
+ * This file contains the function definitions for measuring the cost of the register-access primitives.
+ * Every operation has two kernels generated by MICROBENCH_KERNEL: a short one that repeats the operation
+ * MICROBENCH_UNROLL times per loop iteration and a long one that repeats it twice as often.
+ * Both run MICROBENCH_ITERATIONS iterations, so they only differ by the extra operations of the long kernel.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/Microbench.h"
+#include "../inc/RamFunc.h"
+
+#ifdef MICROBENCH_ENABLE
+
+// Repeats an operation MICROBENCH_UNROLL times
+#define MICROBENCH_REPEAT(operation)    operation operation operation operation operation operation operation operation
+
+// Defines the short and the long kernel of an operation, which can use the loop index and accumulate into sum
+#define MICROBENCH_KERNEL(name, attribute, operation)                           \
+    attribute static uint32_t name##_Short(void)                                \
+    {                                                                           \
+        uint32_t sum = 0;                                                       \
+        uint32_t start = DWT->CYCCNT;                                           \
+        for (uint32_t index = 0; index < MICROBENCH_ITERATIONS; index++)        \
+        {                                                                       \
+            MICROBENCH_REPEAT(operation)                                        \
+        }                                                                       \
+        uint32_t cycles = DWT->CYCCNT - start;                                  \
+        Microbench_Sink = sum;                                                  \
+        return cycles;                                                          \
+    }                                                                           \
+    attribute static uint32_t name##_Long(void)                                 \
+    {                                                                           \
+        uint32_t sum = 0;                                                       \
+        uint32_t start = DWT->CYCCNT;                                           \
+        for (uint32_t index = 0; index < MICROBENCH_ITERATIONS; index++)        \
+        {                                                                       \
+            MICROBENCH_REPEAT(operation)                                        \
+            MICROBENCH_REPEAT(operation)                                        \
+        }                                                                       \
+        uint32_t cycles = DWT->CYCCNT - start;                                  \
+        Microbench_Sink = sum;                                                  \
+        return cycles;                                                          \
+    }
+
+/**
+ * @brief Microbench_Config describes one clock profile and wait state configuration.
+ *
+ *  - frequency:    MCLK frequency passed to Clock_SetProfile
+ *  - wait_states:  Number of flash read wait states, at least the number set by Clock_SetProfile
+ */
+typedef struct
+{
+    uint32_t frequency;
+    uint8_t wait_states;
+} Microbench_Config;
+
+// Every clock profile with its minimum number of wait states and with one more (see Clock_SetProfile)
+static const Microbench_Config Microbench_Configs[MICROBENCH_CONFIG_COUNT] =
+{
+    { 3000000,  0 },
+    { 3000000,  1 },
+    { 12000000, 0 },
+    { 12000000, 1 },
+    { 24000000, 1 },
+    { 24000000, 2 },
+    { 48000000, 2 },
+    { 48000000, 3 }
+};
+
+// Durations passed to Clock_Delay1us
+static const uint32_t Microbench_Delays_us[MICROBENCH_DELAY_COUNT] = { 1, 10, 100, 1000 };
+
+Microbench_Result Microbench_Results[MICROBENCH_CONFIG_COUNT];
+
+// Set once every configuration has been measured
+static uint8_t Microbench_Done = 0;
+
+// Receives the sums of the kernels, so the reads are not removed by the compiler
+static volatile uint32_t Microbench_Sink;
+
+MICROBENCH_KERNEL(Microbench_Byte_Write,        ,           P2->OUT = (uint8_t)index;)
+MICROBENCH_KERNEL(Microbench_Bitband_Write,     ,           BITBAND_PERI(P2->OUT, 0) = index;)
+MICROBENCH_KERNEL(Microbench_RMW,               ,           P2->OUT = (P2->OUT & ~0x07) | (index & 0x07);)
+MICROBENCH_KERNEL(Microbench_In_Read,           ,           sum = sum + P1->IN;)
+MICROBENCH_KERNEL(Microbench_Byte_Write_SRAM,   RAMFUNC,    P2->OUT = (uint8_t)index;)
+
+// Kernels of every operation, indexed by MICROBENCH_OP_
+static uint32_t (* const Microbench_Short_Kernels[MICROBENCH_OP_COUNT])(void) =
+{
+    Microbench_Byte_Write_Short,
+    Microbench_Bitband_Write_Short,
+    Microbench_RMW_Short,
+    Microbench_In_Read_Short,
+    Microbench_Byte_Write_SRAM_Short
+};
+
+static uint32_t (* const Microbench_Long_Kernels[MICROBENCH_OP_COUNT])(void) =
+{
+    Microbench_Byte_Write_Long,
+    Microbench_Bitband_Write_Long,
+    Microbench_RMW_Long,
+    Microbench_In_Read_Long,
+    Microbench_Byte_Write_SRAM_Long
+};
+
+/**
+ * @brief The Microbench_Set_Wait_States function sets the number of flash read wait states of both banks.
+ *
+ * @param wait_states The number of wait states (0 - 15).
+ *
+ * @return None
+ */
+static void Microbench_Set_Wait_States(uint32_t wait_states)
+{
+    FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL & ~FLCTL_BANK0_RDCTL_WAIT_MASK) | (wait_states << FLCTL_BANK0_RDCTL_WAIT_OFS);
+    FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL & ~FLCTL_BANK1_RDCTL_WAIT_MASK) | (wait_states << FLCTL_BANK1_RDCTL_WAIT_OFS);
+}
+
+/**
+ * @brief The Microbench_Measure function measures every operation and delay at the current configuration.
+ *
+ * @param result A pointer to the structure that receives the measurements.
+ *
+ * @return None
+ */
+static void Microbench_Measure(Microbench_Result *result)
+{
+    uint32_t mhz = Clock_GetFreq() / 1000000;
+
+    for (uint32_t op = 0; op < MICROBENCH_OP_COUNT; op++)
+    {
+        // The first run of each kernel is discarded, so the code of the kernel is already in the flash read buffers
+        Microbench_Short_Kernels[op]();
+        uint32_t short_cycles = Microbench_Short_Kernels[op]();
+        uint32_t long_cycles = Microbench_Long_Kernels[op]();
+        uint32_t extra_cycles = (long_cycles > short_cycles) ? (long_cycles - short_cycles) : 0;
+        result->op_cycles[op] = (uint16_t)((extra_cycles * 100) / (MICROBENCH_ITERATIONS * MICROBENCH_UNROLL));
+    }
+
+    for (uint32_t delay = 0; delay < MICROBENCH_DELAY_COUNT; delay++)
+    {
+        uint32_t start = DWT->CYCCNT;
+        Clock_Delay1us(Microbench_Delays_us[delay]);
+        uint32_t cycles = DWT->CYCCNT - start;
+        result->delay_error[delay] = (int32_t)cycles - (int32_t)(Microbench_Delays_us[delay] * mhz);
+    }
+}
+
+uint8_t Microbench_Run(void)
+{
+    // Clock_SetProfile needs MCLK from the crystal, which CS_IRQHandler selects after Clock_Init48MHz_Async.
+    // A missed wake-up only delays the check until the next tick.
+    Clock_Status status;
+    Clock_GetStatus(&status);
+    while (status.state == CLOCK_STATE_STARTING)
+    {
+        __WFI();
+        Clock_GetStatus(&status);
+    }
+    if (status.state != CLOCK_STATE_READY)
+    {
+        return 0;
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    __disable_irq();
+    uint32_t frequency = Clock_GetFreq();
+    uint32_t wait_states = (FLCTL->BANK0_RDCTL & FLCTL_BANK0_RDCTL_WAIT_MASK) >> FLCTL_BANK0_RDCTL_WAIT_OFS;
+    uint8_t port_2 = P2->OUT;
+
+    // The first call starts Timer32 module 1, which is not part of the measurement
+    Clock_Delay1us(1);
+
+    for (uint32_t index = 0; index < MICROBENCH_CONFIG_COUNT; index++)
+    {
+        // Clock_SetProfile sets the minimum number of wait states whenever the frequency changes
+        const Microbench_Config *config = &Microbench_Configs[index];
+        Microbench_Result *result = &Microbench_Results[index];
+        result->frequency = 0;
+        if (Clock_SetProfile(config->frequency) == 0)
+        {
+            continue;
+        }
+        Microbench_Set_Wait_States(config->wait_states);
+
+        Microbench_Measure(result);
+        result->frequency = config->frequency;
+        result->wait_states = config->wait_states;
+        P2->OUT = port_2;
+    }
+
+    Clock_SetProfile(frequency);
+    Microbench_Set_Wait_States(wait_states);
+    __enable_irq();
+
+    Microbench_Done = 1;
+    return 1;
+}
+
+uint8_t Microbench_Get_Result(uint32_t index, Microbench_Result *result)
+{
+    if ((Microbench_Done == 0) || (index >= MICROBENCH_CONFIG_COUNT) || (Microbench_Results[index].frequency == 0))
+    {
+        return 0;
+    }
+    *result = Microbench_Results[index];
+    return 1;
+}
+
+#else
+
+uint8_t Microbench_Run(void)
+{
+    return 0;
+}
+
+uint8_t Microbench_Get_Result(uint32_t index, Microbench_Result *result)
+{
+    return 0;
+}
+
+#endif /* MICROBENCH_ENABLE */
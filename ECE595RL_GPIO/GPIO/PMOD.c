@@ -0,0 +1,127 @@
+/**
+ * @file PMOD.c
+ * @brief Source code for the PMOD driver.
+ *
+ * This file contains the function definitions for reading and writing a group of PMOD modules as one bus.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/PMOD.h"
+#include "../inc/RamFunc.h"
+
+// Registers of a port slot. In the host simulation, every access goes through Sim_Access like the peripherals of msp.h.
+#ifdef SIMULATION
+#define PMOD_BUS_PORT(bus, slot)    ((DIO_PORT_Odd_Type *)Sim_Access((bus)->registers[slot]))
+#else
+#define PMOD_BUS_PORT(bus, slot)    ((bus)->registers[slot])
+#endif
+
+uint8_t PMOD_Bus_Init(PMOD_Bus *bus, const PMOD_Device *devices, uint32_t count)
+{
+    // Port number of every slot and pins owned by any device of every slot
+    uint8_t port_number[PMOD_MAX_PORTS];
+    uint8_t used[PMOD_MAX_PORTS];
+
+    bus->port_count = 0;
+    bus->dirty = 0;
+    bus->inputs = 0;
+    if (count > PMOD_MAX_DEVICES)
+    {
+        return 0;
+    }
+
+    uint8_t port_count = 0;
+    for (uint32_t device = 0; device < count; device++)
+    {
+        const PMOD_Device *pmod = &devices[device];
+        if ((pmod->port < 1) || (pmod->port > GPIO_PINS_PORT_COUNT))
+        {
+            return 0;
+        }
+
+        // Find the slot of the port, or add one
+        uint8_t slot = 0;
+        while ((slot < port_count) && (port_number[slot] != pmod->port))
+        {
+            slot++;
+        }
+        if (slot == port_count)
+        {
+            if (port_count == PMOD_MAX_PORTS)
+            {
+                return 0;
+            }
+            port_number[slot] = pmod->port;
+            used[slot] = 0;
+            bus->registers[slot] = GPIO_PINS_REGISTERS(pmod->port);
+            bus->output_mask[slot] = 0;
+            bus->input_value[slot] = 0;
+            port_count++;
+        }
+
+        uint8_t mask = (uint8_t)(pmod->mask << pmod->shift);
+        if (used[slot] & mask)
+        {
+            return 0;
+        }
+        used[slot] |= mask;
+
+        bus->device_slot[device] = slot;
+        bus->device_shift[device] = pmod->shift;
+        bus->device_mask[device] = mask;
+        if (pmod->role == PMOD_OUTPUT)
+        {
+            bus->output_mask[slot] |= mask;
+        }
+        else
+        {
+            bus->inputs |= (1 << slot);
+        }
+    }
+
+    for (uint8_t slot = 0; slot < port_count; slot++)
+    {
+        bus->output_value[slot] = PMOD_BUS_PORT(bus, slot)->OUT & bus->output_mask[slot];
+    }
+    bus->port_count = port_count;
+    return 1;
+}
+
+RAMFUNC void PMOD_Bus_Write(PMOD_Bus *bus)
+{
+    uint8_t dirty = bus->dirty;
+    bus->dirty = 0;
+    for (uint8_t slot = 0; slot < bus->port_count; slot++)
+    {
+        if (!(dirty & (1 << slot)))
+        {
+            continue;
+        }
+
+        DIO_PORT_Odd_Type *port = PMOD_BUS_PORT(bus, slot);
+        uint8_t mask = bus->output_mask[slot];
+        if (mask == 0xFF)
+        {
+            port->OUT = bus->output_value[slot];
+        }
+        else
+        {
+            port->OUT = (port->OUT & ~mask) | (bus->output_value[slot] & mask);
+        }
+    }
+}
+
+RAMFUNC void PMOD_Bus_Read(PMOD_Bus *bus)
+{
+    uint8_t inputs = bus->inputs;
+    for (uint8_t slot = 0; slot < bus->port_count; slot++)
+    {
+        if (inputs & (1 << slot))
+        {
+            bus->input_value[slot] = PMOD_BUS_PORT(bus, slot)->IN;
+        }
+    }
+}
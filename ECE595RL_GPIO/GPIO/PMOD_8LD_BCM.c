@@ -0,0 +1,112 @@
+/**
+ * @file PMOD_8LD_BCM.c
+ * @brief Source code for the PMOD_8LD_BCM driver.
+ *
+ * This file contains the function definitions for the binary code modulation engine of the PMOD 8LD module.
+ * TA2_0_IRQHandler overrides the weak definition found in startup_msp432p401r_ccs.c.
+ *
+ * The interrupt runs when the timer rolls over at the end of a bit plane. It writes the next plane and
+ * loads its duration into CCR0, so the new period starts at the roll-over. The interrupt latency is the
+ * same for every plane, so it shifts the planes but does not change their durations.
+ *
+ * The bit planes are double-buffered. PMOD_8LD_BCM_Set fills the back buffer and requests a swap,
+ * and the interrupt swaps the buffers before the first plane of a frame.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/PMOD_8LD_BCM.h"
+#include "../inc/RamFunc.h"
+
+// CCR0 value of each bit plane: (2^k units) - 1
+static const uint16_t BCM_Duration[8] =
+{
+    (PMOD_8LD_BCM_UNIT << 0) - 1,
+    (PMOD_8LD_BCM_UNIT << 1) - 1,
+    (PMOD_8LD_BCM_UNIT << 2) - 1,
+    (PMOD_8LD_BCM_UNIT << 3) - 1,
+    (PMOD_8LD_BCM_UNIT << 4) - 1,
+    (PMOD_8LD_BCM_UNIT << 5) - 1,
+    (PMOD_8LD_BCM_UNIT << 6) - 1,
+    (PMOD_8LD_BCM_UNIT << 7) - 1
+};
+
+// Front and back buffers of bit planes
+static uint8_t BCM_Planes[2][8];
+static volatile uint8_t BCM_Front = 0;
+static volatile uint8_t BCM_Swap_Pending = 0;
+
+// Bit plane displayed next
+static uint8_t BCM_Plane = 0;
+
+void PMOD_8LD_BCM_Init(uint32_t priority)
+{
+    for (uint8_t plane = 0; plane < 8; plane++)
+    {
+        BCM_Planes[0][plane] = 0;
+        BCM_Planes[1][plane] = 0;
+    }
+    BCM_Front = 0;
+    BCM_Swap_Pending = 0;
+    BCM_Plane = 0;
+
+    // Timer_A2: stopped, SMCLK, input divider /1, CCR0 interrupt enabled
+    TIMER_A2->CTL = 0x0204;
+    TIMER_A2->CCR[0] = BCM_Duration[0];
+    TIMER_A2->CCTL[0] = 0x0010;
+
+    NVIC_SetPriority(TA2_0_IRQn, priority);
+    NVIC_EnableIRQ(TA2_0_IRQn);
+}
+
+void PMOD_8LD_BCM_Set(const uint8_t brightness[8])
+{
+    // Cancel a pending swap first, so that the interrupt cannot swap in a partially written buffer
+    BCM_Swap_Pending = 0;
+    uint8_t *planes = BCM_Planes[BCM_Front ^ 1];
+
+    for (uint8_t plane = 0; plane < 8; plane++)
+    {
+        uint8_t value = 0;
+        for (uint8_t led = 0; led < 8; led++)
+        {
+            value |= ((brightness[led] >> plane) & 0x01) << led;
+        }
+        planes[plane] = value;
+    }
+
+    BCM_Swap_Pending = 1;
+}
+
+void PMOD_8LD_BCM_Start(void)
+{
+    BCM_Plane = 0;
+    TIMER_A2->CCR[0] = BCM_Duration[0];
+    TIMER_A2->CTL = 0x0214;                 // SMCLK, up mode, TACLR
+}
+
+void PMOD_8LD_BCM_Stop(void)
+{
+    TIMER_A2->CTL = 0x0204;                 // stop mode, clear the counter
+    TIMER_A2->CCTL[0] &= ~0x0001;           // clear CCIFG
+    NVIC_ClearPendingIRQ(TA2_0_IRQn);
+    P9->OUT = 0x00;
+}
+
+RAMFUNC void TA2_0_IRQHandler(void)
+{
+    TIMER_A2->CCTL[0] &= ~0x0001;           // clear CCIFG
+
+    uint8_t plane = BCM_Plane;
+    if ((plane == 0) && BCM_Swap_Pending)
+    {
+        BCM_Front = BCM_Front ^ 1;
+        BCM_Swap_Pending = 0;
+    }
+
+    P9->OUT = BCM_Planes[BCM_Front][plane];
+    TIMER_A2->CCR[0] = BCM_Duration[plane];
+    BCM_Plane = (plane + 1) & 0x07;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file PMOD_8LD_DMA.c
+ * @brief Source code for the PMOD_8LD_DMA driver.
+ *
+ * This file contains the function definitions for streaming a frame buffer to the PMOD 8LD module (P9.0 - P9.7).
+ * DMA_INT1_IRQHandler overrides the weak definition found in startup_msp432p401r_ccs.c.
+ *
+ * Each entry of the DMA control table has the following layout:
+ *  - Source end pointer
+ *  - Destination end pointer
+ *  - Control word
+ *  - Unused
+ *
+ * The control word used by this driver selects byte transfers, an incrementing source, a fixed
+ * destination (P9->OUT), one transfer per trigger, and the basic cycle type.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/PMOD_8LD_DMA.h"
+#include "../inc/RamFunc.h"
+
+// DMA channel triggered by Timer_A1 CCR0 (source 6 of channel 2)
+#define PMOD_8LD_DMA_CHANNEL        2
+#define PMOD_8LD_DMA_SOURCE         6
+
+// Control word: no destination increment, byte size, byte source increment, arbitrate after
+// every transfer, and basic cycle type. The number of transfers minus one goes in bits 13:4.
+#define PMOD_8LD_DMA_CONTROL        0xC0000001
+
+// Frequency of ACLK (REFOCLK) that clocks Timer_A1
+#define PMOD_8LD_DMA_ACLK_HZ        32768
+
+typedef struct
+{
+    volatile const void *source_end;
+    volatile void *destination_end;
+    volatile uint32_t control;
+    uint32_t unused;
+} DMA_Control_Entry;
+
+// The control table must be aligned to its size: primary and alternate entries for 8 channels
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(DMA_Control_Table, 256)
+static DMA_Control_Entry DMA_Control_Table[16];
+#else
+static DMA_Control_Entry DMA_Control_Table[16] __attribute__((aligned(256)));
+#endif
+
+// Frame buffer that is playing
+static const uint8_t *Stream_Frames;
+static uint16_t Stream_Frame_Count;
+static uint8_t Stream_Repeat;
+static volatile uint8_t Stream_Active = 0;
+
+/**
+ * @brief The PMOD_8LD_DMA_Arm function loads the primary control entry of channel 2 and enables the channel.
+ *
+ * @param first_frame   A pointer to the first frame that the DMA controller copies.
+ * @param frame_count   The number of frames to copy (1 to PMOD_8LD_DMA_MAX_FRAMES).
+ *
+ * @return None
+ */
+RAMFUNC static void PMOD_8LD_DMA_Arm(const uint8_t *first_frame, uint16_t frame_count)
+{
+    DMA_Control_Entry *entry = &DMA_Control_Table[PMOD_8LD_DMA_CHANNEL];
+    entry->source_end = &first_frame[frame_count - 1];
+    entry->destination_end = &P9->OUT;
+    entry->control = PMOD_8LD_DMA_CONTROL | ((uint32_t)(frame_count - 1) << 4);
+    DMA_Control->ENASET = 1 << PMOD_8LD_DMA_CHANNEL;
+}
+
+void PMOD_8LD_DMA_Init(uint32_t priority)
+{
+    // Enable the DMA controller and set the base address of the control table
+    DMA_Control->CFG = 0x00000001;
+    DMA_Control->CTLBASE = (uint32_t)DMA_Control_Table;
+
+    // Trigger channel 2 from Timer_A1 CCR0 with the primary entry, single requests, and default priority
+    DMA_Channel->CH_SRCCFG[PMOD_8LD_DMA_CHANNEL] = PMOD_8LD_DMA_SOURCE;
+    DMA_Control->ALTCLR = 1 << PMOD_8LD_DMA_CHANNEL;
+    DMA_Control->USEBURSTCLR = 1 << PMOD_8LD_DMA_CHANNEL;
+    DMA_Control->PRIOCLR = 1 << PMOD_8LD_DMA_CHANNEL;
+    DMA_Control->REQMASKCLR = 1 << PMOD_8LD_DMA_CHANNEL;
+
+    // Route the completion of channel 2 to DMA_INT1 (bit 5 enables the interrupt)
+    DMA_Channel->INT1_SRCCFG = 0x00000020 | PMOD_8LD_DMA_CHANNEL;
+    NVIC_SetPriority(DMA_INT1_IRQn, priority);
+    NVIC_EnableIRQ(DMA_INT1_IRQn);
+
+    // Timer_A1 is stopped until a frame buffer is started
+    TIMER_A1->CTL = 0x0004;                 // stop mode, clear the counter
+    TIMER_A1->CCTL[0] = 0x0000;             // compare mode, no interrupt
+}
+
+uint8_t PMOD_8LD_DMA_Start(const uint8_t *frames, uint16_t frame_count, uint16_t period_ms, uint8_t repeat)
+{
+    if ((frame_count < 2) || (frame_count > PMOD_8LD_DMA_MAX_FRAMES) || (period_ms == 0) || (period_ms > 2000))
+    {
+        return 0;
+    }
+
+    PMOD_8LD_DMA_Stop();
+
+    Stream_Frames = frames;
+    Stream_Frame_Count = frame_count;
+    Stream_Repeat = repeat;
+    Stream_Active = 1;
+
+    // Display the first frame now, and let the DMA controller copy the others at each period
+    P9->OUT = frames[0];
+    PMOD_8LD_DMA_Arm(&frames[1], frame_count - 1);
+
+    // Timer_A1: ACLK, up mode, one CCR0 event every period_ms milliseconds
+    TIMER_A1->CCR[0] = (uint16_t)((((uint32_t)period_ms * PMOD_8LD_DMA_ACLK_HZ) + 500) / 1000 - 1);
+    TIMER_A1->CTL = 0x0114;                 // TASSEL = ACLK, MC = up mode, TACLR
+    return 1;
+}
+
+void PMOD_8LD_DMA_Stop(void)
+{
+    TIMER_A1->CTL = 0x0004;                 // stop mode, clear the counter
+    DMA_Control->ENACLR = 1 << PMOD_8LD_DMA_CHANNEL;
+    DMA_Channel->INT0_CLRFLG = 1 << PMOD_8LD_DMA_CHANNEL;
+    Stream_Active = 0;
+}
+
+uint8_t PMOD_8LD_DMA_Is_Active(void)
+{
+    return Stream_Active;
+}
+
+RAMFUNC void DMA_INT1_IRQHandler(void)
+{
+    DMA_Channel->INT0_CLRFLG = 1 << PMOD_8LD_DMA_CHANNEL;
+
+    if (Stream_Active && Stream_Repeat)
+    {
+        // The next pass starts with the next trigger, one period after the last frame
+        PMOD_8LD_DMA_Arm(Stream_Frames, Stream_Frame_Count);
+    }
+    else
+    {
+        TIMER_A1->CTL = 0x0004;
+        Stream_Active = 0;
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file Profile.c
+ * @brief Source code for the Profile driver.
+ *
+ * This file contains the function definitions for measuring code regions with the DWT cycle counter.
+ * When PROFILE_ENABLE is not defined, the functions are empty so that callers do not need to be
+ * guarded, and no statistics are allocated.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Clock.h"
+#include "../inc/Profile.h"
+
+// Number of calls to Clock_Delay1ms measured by Profile_Measure_Delays
+#define PROFILE_DELAY_SAMPLES       8
+
+#ifdef PROFILE_ENABLE
+
+Profile_Stats Profile_Regions[PROFILE_REGION_COUNT];
+uint32_t Profile_Overhead = 0;
+
+void Profile_Init(void)
+{
+    // Enable the trace block, then start the cycle counter
+    // The counter is not reset because the Boot and Trace modules share it
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // Measure an empty region with the overhead correction disabled
+    Profile_Overhead = 0;
+    Profile_Reset();
+    PROFILE_START(PROFILE_MAIN_LOOP);
+    PROFILE_STOP(PROFILE_MAIN_LOOP);
+    Profile_Overhead = Profile_Regions[PROFILE_MAIN_LOOP].min;
+    Profile_Reset();
+}
+
+void Profile_Reset(void)
+{
+    for (uint32_t region = 0; region < PROFILE_REGION_COUNT; region++)
+    {
+        Profile_Regions[region].count = 0;
+        Profile_Regions[region].min = 0xFFFFFFFF;
+        Profile_Regions[region].max = 0;
+        Profile_Regions[region].total = 0;
+    }
+}
+
+uint32_t Profile_Get_Mean(uint32_t region)
+{
+    Profile_Stats *stats = &Profile_Regions[region];
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+    return (uint32_t)(stats->total / stats->count);
+}
+
+void Profile_Measure_Delays(void)
+{
+    for (uint32_t sample = 0; sample < PROFILE_DELAY_SAMPLES; sample++)
+    {
+        PROFILE_START(PROFILE_CLOCK_DELAY_1MS);
+        Clock_Delay1ms(1);
+        PROFILE_STOP(PROFILE_CLOCK_DELAY_1MS);
+    }
+}
+
+#else
+
+void Profile_Init(void)
+{
+}
+
+void Profile_Reset(void)
+{
+}
+
+uint32_t Profile_Get_Mean(uint32_t region)
+{
+    return 0;
+}
+
+void Profile_Measure_Delays(void)
+{
+}
+
+#endif /* PROFILE_ENABLE */
@@ -0,0 +1,195 @@
+/**
+ * @file RGB_PWM.c
+ * @brief Source code for the RGB_PWM driver.
+ *
+ * This file contains the function definitions for driving the RGB LED with hardware PWM.
+ * TA0_0_IRQHandler overrides the weak definition found in startup_msp432p401r_ccs.c.
+ *
+ * Every channel uses output mode 7 (reset/set): the output is set when the timer rolls over at CCR0
+ * and reset when it reaches CCRn, so the duty cycle is CCRn / 1024. A duty cycle of 1024 never resets
+ * the output (fully on). A duty cycle of 0 would still produce a 1-count pulse, so output mode 0 with
+ * OUT = 0 is used instead.
+ *
+ * The fade state keeps every level in 8.8 fixed point, so a slow fade can move by less than one
+ * level per PWM period.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/RGB_PWM.h"
+#include "../inc/RamFunc.h"
+
+// Port mapping mnemonics of the Timer_A0 compare outputs (MSP432P401R datasheet, Port Mapping Mnemonics)
+#define RGB_PWM_PMAP_TA0CCR1A   20
+#define RGB_PWM_PMAP_TA0CCR2A   21
+#define RGB_PWM_PMAP_TA0CCR3A   22
+
+// Number of timer counts per PWM period
+#define RGB_PWM_PERIOD          1024
+
+// Output modes of the capture/compare control registers
+#define RGB_PWM_OUTMOD_OFF      0x0000
+#define RGB_PWM_OUTMOD_RESET_SET 0x00E0
+
+/**
+ * @brief RGB_PWM_Gamma converts a brightness level (0 - 255) to a duty cycle (0 - 1024).
+ *
+ * RGB_PWM_Gamma[n] = 1024 * (n / 255)^2.2, and at least 1 for n > 0 so that every nonzero level is visible.
+ */
+static const uint16_t RGB_PWM_Gamma[256] =
+{
+       0,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,    2,    2,
+       2,    3,    3,    3,    4,    4,    5,    5,    6,    6,    7,    7,    8,    9,    9,   10,
+      11,   11,   12,   13,   14,   15,   16,   16,   17,   18,   19,   20,   21,   23,   24,   25,
+      26,   27,   28,   30,   31,   32,   34,   35,   36,   38,   39,   41,   42,   44,   46,   47,
+      49,   51,   52,   54,   56,   58,   60,   61,   63,   65,   67,   69,   71,   73,   76,   78,
+      80,   82,   84,   87,   89,   91,   94,   96,   99,  101,  104,  106,  109,  111,  114,  117,
+     119,  122,  125,  128,  131,  133,  136,  139,  142,  145,  148,  152,  155,  158,  161,  164,
+     168,  171,  174,  178,  181,  184,  188,  191,  195,  199,  202,  206,  210,  213,  217,  221,
+     225,  229,  233,  237,  241,  245,  249,  253,  257,  261,  265,  269,  274,  278,  282,  287,
+     291,  296,  300,  305,  309,  314,  319,  323,  328,  333,  338,  342,  347,  352,  357,  362,
+     367,  372,  377,  383,  388,  393,  398,  404,  409,  414,  420,  425,  431,  436,  442,  447,
+     453,  459,  464,  470,  476,  482,  488,  494,  499,  505,  511,  518,  524,  530,  536,  542,
+     548,  555,  561,  568,  574,  580,  587,  593,  600,  607,  613,  620,  627,  634,  640,  647,
+     654,  661,  668,  675,  682,  689,  696,  704,  711,  718,  725,  733,  740,  747,  755,  762,
+     770,  778,  785,  793,  801,  808,  816,  824,  832,  840,  848,  856,  864,  872,  880,  888,
+     896,  904,  913,  921,  929,  938,  946,  955,  963,  972,  980,  989,  998, 1006, 1015, 1024
+};
+
+// Current levels in 8.8 fixed point, and the increment per PWM period during a fade
+static int32_t RGB_PWM_Level[3];
+static int32_t RGB_PWM_Increment[3];
+static uint8_t RGB_PWM_Target[3];
+
+// Number of PWM periods left in the fade in progress
+static volatile uint32_t RGB_PWM_Steps_Left = 0;
+
+/**
+ * @brief The RGB_PWM_Write function sets the duty cycle of one channel from a brightness level.
+ *
+ * @param channel   The channel index (0: red, 1: green, 2: blue).
+ * @param level     The brightness level (0 - 255).
+ *
+ * @return None
+ */
+RAMFUNC static void RGB_PWM_Write(uint8_t channel, uint8_t level)
+{
+    uint16_t duty = RGB_PWM_Gamma[level];
+    if (duty == 0)
+    {
+        TIMER_A0->CCTL[channel + 1] = RGB_PWM_OUTMOD_OFF;
+    }
+    else
+    {
+        TIMER_A0->CCR[channel + 1] = duty;
+        TIMER_A0->CCTL[channel + 1] = RGB_PWM_OUTMOD_RESET_SET;
+    }
+}
+
+void RGB_PWM_Init(uint32_t priority)
+{
+    RGB_PWM_Steps_Left = 0;
+    for (uint8_t channel = 0; channel < 3; channel++)
+    {
+        RGB_PWM_Level[channel] = 0;
+        RGB_PWM_Target[channel] = 0;
+        TIMER_A0->CCTL[channel + 1] = RGB_PWM_OUTMOD_OFF;
+    }
+
+    // Timer_A0: stopped, SMCLK, input divider /8; period of 1024 counts, CCR0 interrupt disabled until a fade starts
+    TIMER_A0->CTL = 0x02C4;
+    TIMER_A0->CCR[0] = RGB_PWM_PERIOD - 1;
+    TIMER_A0->CCTL[0] = 0x0000;
+
+    // Map P2.0 - P2.2 to TA0.1 - TA0.3 and select the primary (mapped) function of the pins
+    PMAP->KEYID = 0x2D52;                   // unlock the port mapping controller
+    P2MAP->PMAP_REGISTER0 = RGB_PWM_PMAP_TA0CCR1A;
+    P2MAP->PMAP_REGISTER1 = RGB_PWM_PMAP_TA0CCR2A;
+    P2MAP->PMAP_REGISTER2 = RGB_PWM_PMAP_TA0CCR3A;
+    PMAP->KEYID = 0;                        // lock the port mapping controller
+    P2->SEL0 |= 0x07;
+    P2->SEL1 &= ~0x07;
+
+    NVIC_SetPriority(TA0_0_IRQn, priority);
+    NVIC_EnableIRQ(TA0_0_IRQn);
+
+    // Start Timer_A0 in up mode
+    TIMER_A0->CTL = 0x02D4;
+}
+
+void RGB_PWM_Set(uint8_t red, uint8_t green, uint8_t blue)
+{
+    RGB_PWM_Fade(red, green, blue, 0);
+}
+
+void RGB_PWM_Fade(uint8_t red, uint8_t green, uint8_t blue, uint16_t duration_ms)
+{
+    uint8_t target[3] = { red, green, blue };
+    uint32_t steps = ((uint32_t)duration_ms * RGB_PWM_FREQUENCY_HZ) / 1000;
+
+    // Stop the fade in progress before its state is changed. A request that was latched before CCIE was cleared
+    // stays pending in the NVIC when this function preempts the TA0_0 interrupt, so it is cleared as well.
+    TIMER_A0->CCTL[0] = 0x0000;
+    NVIC_ClearPendingIRQ(TA0_0_IRQn);
+    RGB_PWM_Steps_Left = 0;
+
+    for (uint8_t channel = 0; channel < 3; channel++)
+    {
+        RGB_PWM_Target[channel] = target[channel];
+        if (steps == 0)
+        {
+            RGB_PWM_Level[channel] = (int32_t)target[channel] << 8;
+            RGB_PWM_Write(channel, target[channel]);
+        }
+        else
+        {
+            RGB_PWM_Increment[channel] = (((int32_t)target[channel] << 8) - RGB_PWM_Level[channel]) / (int32_t)steps;
+        }
+    }
+
+    if (steps != 0)
+    {
+        RGB_PWM_Steps_Left = steps;
+        TIMER_A0->CCTL[0] = 0x0010;         // CCIE: advance the fade at the start of every PWM period
+    }
+}
+
+uint8_t RGB_PWM_Is_Fading(void)
+{
+    return (RGB_PWM_Steps_Left != 0) ? 1 : 0;
+}
+
+RAMFUNC void TA0_0_IRQHandler(void)
+{
+    TIMER_A0->CCTL[0] &= ~0x0001;           // clear CCIFG
+
+    // No fade in progress, for example after a fade was stopped while this interrupt was being entered
+    if (RGB_PWM_Steps_Left == 0)
+    {
+        TIMER_A0->CCTL[0] = 0x0000;
+        return;
+    }
+
+    uint32_t steps_left = RGB_PWM_Steps_Left - 1;
+    for (uint8_t channel = 0; channel < 3; channel++)
+    {
+        if (steps_left == 0)
+        {
+            // Land exactly on the target, whatever the rounding of the increment
+            RGB_PWM_Level[channel] = (int32_t)RGB_PWM_Target[channel] << 8;
+        }
+        else
+        {
+            RGB_PWM_Level[channel] = RGB_PWM_Level[channel] + RGB_PWM_Increment[channel];
+        }
+        RGB_PWM_Write(channel, (uint8_t)(RGB_PWM_Level[channel] >> 8));
+    }
+
+    RGB_PWM_Steps_Left = steps_left;
+    if (steps_left == 0)
+    {
+        TIMER_A0->CCTL[0] = 0x0000;         // fade complete, disable the interrupt
+    }
+}
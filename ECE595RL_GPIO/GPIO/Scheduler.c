@@ -0,0 +1,75 @@
+/**
+ * @file Scheduler.c
+ * @brief Source code for the Scheduler driver.
+ *
+ * This file contains the function definitions for the run-to-completion task scheduler.
+ * PendSV_Handler, COMP_E1_IRQHandler, and COMP_E0_IRQHandler override the weak definitions
+ * found in startup_msp432p401r_ccs.c. PendSV is pended through SCB->ICSR, and the device
+ * interrupts through the NVIC set-pending registers.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Scheduler.h"
+#include "../inc/RamFunc.h"
+
+// Exception of every task, in the order they are taken by Scheduler_Add
+static const IRQn_Type Scheduler_Exceptions[SCHEDULER_MAX_TASKS] = { PendSV_IRQn, COMP_E1_IRQn, COMP_E0_IRQn };
+
+// Function of every task, or 0 if the exception is free
+static void (*Scheduler_Tasks[SCHEDULER_MAX_TASKS])(void);
+
+// Number of tasks added
+static uint8_t Scheduler_Task_Count = 0;
+
+uint8_t Scheduler_Add(void (*task)(void), uint32_t priority)
+{
+    uint8_t index = Scheduler_Task_Count;
+    if (index >= SCHEDULER_MAX_TASKS)
+    {
+        return SCHEDULER_NO_TASK;
+    }
+
+    IRQn_Type exception = Scheduler_Exceptions[index];
+    Scheduler_Tasks[index] = task;
+    Scheduler_Task_Count = index + 1;
+    NVIC_SetPriority(exception, priority);
+
+    // PendSV is a system exception and is always enabled
+    if (exception != PendSV_IRQn)
+    {
+        NVIC_ClearPendingIRQ(exception);
+        NVIC_EnableIRQ(exception);
+    }
+    return index;
+}
+
+RAMFUNC void Scheduler_Post(uint8_t task)
+{
+    IRQn_Type exception = Scheduler_Exceptions[task];
+    if (exception == PendSV_IRQn)
+    {
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    }
+    else
+    {
+        NVIC_SetPendingIRQ(exception);
+    }
+}
+
+RAMFUNC void PendSV_Handler(void)
+{
+    (*Scheduler_Tasks[0])();
+}
+
+RAMFUNC void COMP_E1_IRQHandler(void)
+{
+    (*Scheduler_Tasks[1])();
+}
+
+RAMFUNC void COMP_E0_IRQHandler(void)
+{
+    (*Scheduler_Tasks[2])();
+}
@@ -0,0 +1,58 @@
+/**
+ * @file SysTickInts.c
+ * @brief Source code for the SysTickInts driver.
+ *
+ * This file contains the function definitions for the SysTick periodic interrupt.
+ * SysTick_Handler overrides the weak definition found in startup_msp432p401r_ccs.c,
+ * counts the elapsed ticks, and calls the user task registered with SysTickInts_Init.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/SysTickInts.h"
+#include "../inc/RamFunc.h"
+
+// Pointer to the user function called on every SysTick interrupt
+static void (*SysTickTask)(void);
+
+// Number of SysTick interrupts since SysTickInts_Init was called
+static volatile uint32_t SysTick_Ticks = 0;
+
+void SysTickInts_Init(void(*task)(void), uint32_t period, uint32_t priority)
+{
+    SysTickTask = task;
+    SysTick_Ticks = 0;
+
+    // Disable SysTick during setup
+    SysTick->CTRL = 0x00000000;
+
+    // Set the reload value (the counter counts period-1 down to 0)
+    SysTick->LOAD = period - 1;
+
+    // Any write to the current value register clears it
+    SysTick->VAL = 0;
+
+    // Set the priority (only the top three bits of the priority byte are implemented)
+    NVIC_SetPriority(SysTick_IRQn, priority);
+
+    // Enable SysTick with the core clock source and interrupts
+    SysTick->CTRL = 0x00000007;
+}
+
+void SysTickInts_Set_Period(uint32_t period)
+{
+    SysTick->LOAD = period - 1;
+}
+
+uint32_t SysTickInts_Get_Ticks(void)
+{
+    return SysTick_Ticks;
+}
+
+RAMFUNC void SysTick_Handler(void)
+{
+    SysTick_Ticks = SysTick_Ticks + 1;
+    (*SysTickTask)();
+}
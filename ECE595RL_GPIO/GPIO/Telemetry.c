@@ -0,0 +1,594 @@
+/**
+ * @file Telemetry.c
+ * @brief Source code for the Telemetry driver.
+ *
+ * This file contains the function definitions for the binary command and telemetry channel over UART0.
+ * Received bytes are decoded one at a time by a state machine, so a command may arrive over several
+ * calls to Telemetry_Poll. A frame with a wrong checksum or length is answered with a negative ACK,
+ * and the decoder resynchronizes on the next 0xA5 byte.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/UART0.h"
+#include "../inc/Profile.h"
+#include "../inc/Trace.h"
+#include "../inc/Benchmark.h"
+#include "../inc/Microbench.h"
+#include "../inc/Boot.h"
+#include "../inc/Clock.h"
+#include "../inc/Watchdog.h"
+#include "../inc/ConfigStore.h"
+#include "../inc/Telemetry.h"
+
+// Bytes of a frame in addition to the payload (sync, type, length, and checksum)
+#define TELEMETRY_FRAME_OVERHEAD        4
+#define TELEMETRY_MAX_FRAME             (TELEMETRY_MAX_PAYLOAD + TELEMETRY_FRAME_OVERHEAD)
+
+// States of the frame decoder
+#define TELEMETRY_STATE_SYNC            0
+#define TELEMETRY_STATE_TYPE            1
+#define TELEMETRY_STATE_LENGTH          2
+#define TELEMETRY_STATE_PAYLOAD         3
+#define TELEMETRY_STATE_CHECKSUM        4
+
+// Transfers that span several reply frames
+#define TELEMETRY_TRANSFER_NONE         0
+#define TELEMETRY_TRANSFER_PROFILE      1
+#define TELEMETRY_TRANSFER_TRACE        2
+#define TELEMETRY_TRANSFER_BENCHMARK    3
+#define TELEMETRY_TRANSFER_MICROBENCH   4
+
+// Frame decoder
+static uint8_t Decoder_State = TELEMETRY_STATE_SYNC;
+static uint8_t Decoder_Type;
+static uint8_t Decoder_Length;
+static uint8_t Decoder_Index;
+static uint8_t Decoder_Sum;
+static uint8_t Decoder_Payload[TELEMETRY_MAX_PAYLOAD];
+
+// Transfer in progress: the next item to send and the item after the last one
+static uint8_t Transfer = TELEMETRY_TRANSFER_NONE;
+static uint32_t Transfer_Index;
+static uint32_t Transfer_End;
+
+// Sequence number of the first trace entry that has not been sent yet
+static uint32_t Trace_Cursor = 0;
+
+// Inputs replaced by the host and their values
+static uint8_t Override_Mask = 0;
+static uint8_t Override_Buttons;
+static uint8_t Override_Switches;
+
+/**
+ * @brief The Telemetry_Put_32 function stores a 32-bit value in little-endian order.
+ *
+ * @param buffer    A pointer to the first of the four bytes.
+ * @param value     The value to store.
+ *
+ * @return None
+ */
+static void Telemetry_Put_32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief The Telemetry_Get_16 function loads a 16-bit value stored in little-endian order.
+ *
+ * @param buffer A pointer to the first of the two bytes.
+ *
+ * @return The value.
+ */
+static uint16_t Telemetry_Get_16(const uint8_t *buffer)
+{
+    return (uint16_t)(buffer[0] | (buffer[1] << 8));
+}
+
+/**
+ * @brief The Telemetry_Config_Status function converts a result of the ConfigStore driver to an ACK status.
+ *
+ * @param result The result of ConfigStore_Begin, ConfigStore_Write, or ConfigStore_Commit.
+ *
+ * @return The status of TELEMETRY_REPLY_ACK.
+ */
+static uint8_t Telemetry_Config_Status(uint8_t result)
+{
+    switch(result)
+    {
+        case CONFIG_STORE_OK:           return TELEMETRY_STATUS_OK;
+        case CONFIG_STORE_BAD_LENGTH:   return TELEMETRY_STATUS_BAD_LENGTH;
+        case CONFIG_STORE_BAD_STATE:    return TELEMETRY_STATUS_UNAVAILABLE;
+        case CONFIG_STORE_INVALID:      return TELEMETRY_STATUS_INVALID;
+        default:                        return TELEMETRY_STATUS_FLASH_ERROR;
+    }
+}
+
+/**
+ * @brief The Telemetry_Send function queues one reply frame.
+ *
+ * The caller must ensure that the transmit ring buffer has room for TELEMETRY_MAX_FRAME bytes.
+ *
+ * @param type      The reply type.
+ * @param payload   A pointer to the payload.
+ * @param length    The length of the payload (0 - TELEMETRY_MAX_PAYLOAD).
+ *
+ * @return None
+ */
+static void Telemetry_Send(uint8_t type, const uint8_t *payload, uint8_t length)
+{
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    uint8_t sum = type + length;
+
+    frame[0] = TELEMETRY_SYNC;
+    frame[1] = type;
+    frame[2] = length;
+    for (uint8_t index = 0; index < length; index++)
+    {
+        frame[3 + index] = payload[index];
+        sum = sum + payload[index];
+    }
+    frame[3 + length] = (uint8_t)(0 - sum);
+
+    UART0_Write(frame, length + TELEMETRY_FRAME_OVERHEAD);
+}
+
+/**
+ * @brief The Telemetry_Send_Ack function queues the acknowledgment of a command.
+ *
+ * @param command   The command that is acknowledged.
+ * @param status    One of the TELEMETRY_STATUS_ constants.
+ *
+ * @return None
+ */
+static void Telemetry_Send_Ack(uint8_t command, uint8_t status)
+{
+    uint8_t payload[2] = { command, status };
+    Telemetry_Send(TELEMETRY_REPLY_ACK, payload, 2);
+}
+
+/**
+ * @brief The Telemetry_Continue_Transfer function queues the next frame of the transfer in progress.
+ *
+ * The last frame of a transfer is the ACK of the command that started it or the TRACE_END reply.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Telemetry_Continue_Transfer(void)
+{
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+
+    if (Transfer == TELEMETRY_TRANSFER_PROFILE)
+    {
+        if (Transfer_Index == Transfer_End)
+        {
+            Transfer = TELEMETRY_TRANSFER_NONE;
+            Telemetry_Send_Ack(TELEMETRY_CMD_GET_PROFILE, TELEMETRY_STATUS_OK);
+            return;
+        }
+#ifdef PROFILE_ENABLE
+        Profile_Stats *stats = &Profile_Regions[Transfer_Index];
+        payload[0] = (uint8_t)Transfer_Index;
+        Telemetry_Put_32(&payload[1], stats->count);
+        Telemetry_Put_32(&payload[5], stats->min);
+        Telemetry_Put_32(&payload[9], stats->max);
+        Telemetry_Put_32(&payload[13], Profile_Get_Mean(Transfer_Index));
+        Telemetry_Send(TELEMETRY_REPLY_PROFILE, payload, 17);
+#endif
+        Transfer_Index = Transfer_Index + 1;
+    }
+    else if (Transfer == TELEMETRY_TRANSFER_BENCHMARK)
+    {
+        if (Transfer_Index == Transfer_End)
+        {
+            Transfer = TELEMETRY_TRANSFER_NONE;
+            Telemetry_Send_Ack(TELEMETRY_CMD_GET_BENCHMARK, TELEMETRY_STATUS_OK);
+            return;
+        }
+
+        // Patterns that have not been measured yet are skipped
+        Benchmark_Result result;
+        if (Benchmark_Get_Result(Transfer_Index, &result))
+        {
+            payload[0] = result.switch_status;
+            payload[1] = (uint8_t)result.samples;
+            payload[2] = (uint8_t)(result.samples >> 8);
+            payload[3] = (uint8_t)result.timeouts;
+            payload[4] = (uint8_t)(result.timeouts >> 8);
+            Telemetry_Put_32(&payload[5], result.min_ns);
+            Telemetry_Put_32(&payload[9], result.mean_ns);
+            Telemetry_Put_32(&payload[13], result.max_ns);
+            Telemetry_Put_32(&payload[17], result.p99_ns);
+            Telemetry_Send(TELEMETRY_REPLY_BENCHMARK, payload, 21);
+        }
+        Transfer_Index = Transfer_Index + 1;
+    }
+    else if (Transfer == TELEMETRY_TRANSFER_MICROBENCH)
+    {
+        if (Transfer_Index == Transfer_End)
+        {
+            Transfer = TELEMETRY_TRANSFER_NONE;
+            Telemetry_Send_Ack(TELEMETRY_CMD_GET_MICROBENCH, TELEMETRY_STATUS_OK);
+            return;
+        }
+
+        // Configurations that could not be measured are skipped
+        Microbench_Result result;
+        if (Microbench_Get_Result(Transfer_Index, &result))
+        {
+            payload[0] = (uint8_t)(result.frequency / 1000000);
+            payload[1] = result.wait_states;
+            for (uint32_t op = 0; op < MICROBENCH_OP_COUNT; op++)
+            {
+                payload[2 + (op * 2)] = (uint8_t)result.op_cycles[op];
+                payload[3 + (op * 2)] = (uint8_t)(result.op_cycles[op] >> 8);
+            }
+            for (uint32_t delay = 0; delay < MICROBENCH_DELAY_COUNT; delay++)
+            {
+                // The error is saturated to 16 bits, which is only reached by the software delay at a low frequency
+                int32_t error = result.delay_error[delay];
+                error = (error > 32767) ? 32767 : ((error < -32768) ? -32768 : error);
+                payload[12 + (delay * 2)] = (uint8_t)error;
+                payload[13 + (delay * 2)] = (uint8_t)((uint32_t)error >> 8);
+            }
+            Telemetry_Send(TELEMETRY_REPLY_MICROBENCH, payload, 20);
+        }
+        Transfer_Index = Transfer_Index + 1;
+    }
+    else if (Transfer == TELEMETRY_TRANSFER_TRACE)
+    {
+        if (Transfer_Index == Transfer_End)
+        {
+            Transfer = TELEMETRY_TRANSFER_NONE;
+            Trace_Cursor = Transfer_End;
+            Telemetry_Put_32(payload, Transfer_End);
+            Telemetry_Send(TELEMETRY_REPLY_TRACE_END, payload, 4);
+            return;
+        }
+
+        // An entry that was overwritten since the command was received is skipped
+        Trace_Entry entry;
+        if (Trace_Read(Transfer_Index, &entry))
+        {
+            Telemetry_Put_32(&payload[0], Transfer_Index);
+            Telemetry_Put_32(&payload[4], entry.cycles);
+            payload[8] = entry.event;
+            payload[9] = entry.arg;
+            payload[10] = (uint8_t)entry.value;
+            payload[11] = (uint8_t)(entry.value >> 8);
+            Telemetry_Send(TELEMETRY_REPLY_TRACE, payload, 12);
+        }
+        Transfer_Index = Transfer_Index + 1;
+    }
+}
+
+/**
+ * @brief The Telemetry_Execute function executes a command with a valid checksum.
+ *
+ * Short commands are acknowledged immediately. The profile and trace commands start a transfer,
+ * which is sent by Telemetry_Continue_Transfer. A configuration update that erases the sector of the
+ * configuration store drops the patterns of the configuration, which is reported as a change of the inputs
+ * so the input task selects the pattern again.
+ *
+ * @param command   The command type.
+ * @param payload   A pointer to the payload of the command.
+ * @param length    The length of the payload.
+ *
+ * @return 1 if the input overrides or the patterns in use were changed, 0 otherwise.
+ */
+static uint8_t Telemetry_Execute(uint8_t command, const uint8_t *payload, uint8_t length)
+{
+    uint8_t expected_length = 0;
+    if (command == TELEMETRY_CMD_OVERRIDE)
+    {
+        expected_length = 3;
+    }
+    else if (command == TELEMETRY_CMD_CONFIG_BEGIN)
+    {
+        expected_length = 2;
+    }
+    else if (command == TELEMETRY_CMD_CONFIG_DATA)
+    {
+        expected_length = 2 + CONFIG_STORE_CHUNK;
+    }
+
+    if (length != expected_length)
+    {
+        Telemetry_Send_Ack(command, TELEMETRY_STATUS_BAD_LENGTH);
+        return 0;
+    }
+
+    switch(command)
+    {
+        case TELEMETRY_CMD_PING:
+        {
+            Telemetry_Send_Ack(command, TELEMETRY_STATUS_OK);
+            return 0;
+        }
+
+        case TELEMETRY_CMD_OVERRIDE:
+        {
+            // The overrides are read by the input task, which can preempt the main loop.
+            // PRIMASK is restored, so a caller that runs with interrupts disabled keeps them disabled.
+            uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            Override_Mask = payload[0] & (TELEMETRY_OVERRIDE_BUTTONS | TELEMETRY_OVERRIDE_SWITCHES);
+            Override_Buttons = payload[1] & 0x12;
+            Override_Switches = payload[2] & 0x0F;
+            __set_PRIMASK(primask);
+            Telemetry_Send_Ack(command, TELEMETRY_STATUS_OK);
+            return 1;
+        }
+
+        case TELEMETRY_CMD_GET_PROFILE:
+        {
+#ifdef PROFILE_ENABLE
+            Transfer = TELEMETRY_TRANSFER_PROFILE;
+            Transfer_Index = 0;
+            Transfer_End = PROFILE_REGION_COUNT;
+#else
+            Telemetry_Send_Ack(command, TELEMETRY_STATUS_UNAVAILABLE);
+#endif
+            return 0;
+        }
+
+        case TELEMETRY_CMD_RESET_PROFILE:
+        {
+            Profile_Reset();
+            Telemetry_Send_Ack(command, TELEMETRY_STATUS_OK);
+            return 0;
+        }
+
+        case TELEMETRY_CMD_GET_TRACE:
+        {
+            // Start from the oldest entry that is still in the buffer if the host fell behind
+            uint32_t count = Trace_Get_Count();
+            Transfer_Index = Trace_Cursor;
+            if ((count - Transfer_Index) > TRACE_SIZE)
+            {
+                Transfer_Index = count - TRACE_SIZE;
+            }
+            Transfer_End = count;
+            Transfer = TELEMETRY_TRANSFER_TRACE;
+            return 0;
+        }
+
+        case TELEMETRY_CMD_GET_BENCHMARK:
+        {
+#ifdef BENCHMARK_ENABLE
+            Transfer = TELEMETRY_TRANSFER_BENCHMARK;
+            Transfer_Index = 0;
+            Transfer_End = BENCHMARK_PATTERN_COUNT;
+#else
+            Telemetry_Send_Ack(command, TELEMETRY_STATUS_UNAVAILABLE);
+#endif
+            return 0;
+        }
+
+        case TELEMETRY_CMD_GET_MICROBENCH:
+        {
+#ifdef MICROBENCH_ENABLE
+            Transfer = TELEMETRY_TRANSFER_MICROBENCH;
+            Transfer_Index = 0;
+            Transfer_End = MICROBENCH_CONFIG_COUNT;
+#else
+            Telemetry_Send_Ack(command, TELEMETRY_STATUS_UNAVAILABLE);
+#endif
+            return 0;
+        }
+
+        case TELEMETRY_CMD_GET_BOOT:
+        {
+            uint8_t times[BOOT_STAGE_COUNT * 4];
+            for (uint32_t stage = 0; stage < BOOT_STAGE_COUNT; stage++)
+            {
+                Telemetry_Put_32(&times[stage * 4], Boot_Get_Time(stage));
+            }
+            Telemetry_Send(TELEMETRY_REPLY_BOOT, times, BOOT_STAGE_COUNT * 4);
+            return 0;
+        }
+
+        case TELEMETRY_CMD_GET_CLOCK:
+        {
+            Clock_Status status;
+            Clock_GetStatus(&status);
+            uint8_t clock[14];
+            clock[0] = (uint8_t)status.state;
+            clock[1] = (uint8_t)status.error;
+            Telemetry_Put_32(&clock[2], status.pcm_flags);
+            Telemetry_Put_32(&clock[6], status.hfxt_restarts);
+            Telemetry_Put_32(&clock[10], Clock_GetFreq());
+            Telemetry_Send(TELEMETRY_REPLY_CLOCK, clock, 14);
+            return 0;
+        }
+
+        case TELEMETRY_CMD_GET_WATCHDOG:
+        {
+            Watchdog_Counters counters;
+            Watchdog_Get_Counters(&counters);
+            uint8_t watchdog[21];
+            watchdog[0] = Watchdog_Boot_Cause;
+            Telemetry_Put_32(&watchdog[1], counters.watchdog_resets);
+            Telemetry_Put_32(&watchdog[5], counters.deadline_misses);
+            Telemetry_Put_32(&watchdog[9], counters.worst_loop_us);
+            Telemetry_Put_32(&watchdog[13], Watchdog_Boot_Counters.deadline_misses);
+            Telemetry_Put_32(&watchdog[17], Watchdog_Boot_Counters.worst_loop_us);
+            Telemetry_Send(TELEMETRY_REPLY_WATCHDOG, watchdog, 21);
+            return 0;
+        }
+
+        case TELEMETRY_CMD_CONFIG_BEGIN:
+        {
+            const Config_Data *config = ConfigStore_Get();
+            uint8_t result = ConfigStore_Begin(Telemetry_Get_16(payload));
+            Telemetry_Send_Ack(command, Telemetry_Config_Status(result));
+            return ((config != 0) && (ConfigStore_Get() == 0)) ? 1 : 0;
+        }
+
+        case TELEMETRY_CMD_CONFIG_DATA:
+        {
+            uint8_t result = ConfigStore_Write(Telemetry_Get_16(payload), &payload[2]);
+            Telemetry_Send_Ack(command, Telemetry_Config_Status(result));
+            return 0;
+        }
+
+        case TELEMETRY_CMD_CONFIG_COMMIT:
+        {
+            uint8_t result = ConfigStore_Commit();
+            Telemetry_Send_Ack(command, Telemetry_Config_Status(result));
+            return 0;
+        }
+
+        case TELEMETRY_CMD_GET_CONFIG:
+        {
+            ConfigStore_Status status;
+            ConfigStore_Get_Status(&status);
+            uint8_t config[15];
+            config[0] = status.loaded;
+            config[1] = (uint8_t)status.sequence;
+            config[2] = (uint8_t)(status.sequence >> 8);
+            config[3] = (uint8_t)status.length;
+            config[4] = (uint8_t)(status.length >> 8);
+            Telemetry_Put_32(&config[5], status.crc);
+            config[9] = (uint8_t)status.free_offset;
+            config[10] = (uint8_t)(status.free_offset >> 8);
+            Telemetry_Put_32(&config[11], status.erase_count);
+            Telemetry_Send(TELEMETRY_REPLY_CONFIG, config, 15);
+            return 0;
+        }
+
+        default:
+        {
+            Telemetry_Send_Ack(command, TELEMETRY_STATUS_UNKNOWN);
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief The Telemetry_Decode function adds one received byte to the frame decoder.
+ *
+ * @param data The received byte.
+ *
+ * @return 1 if a command changed the input overrides or the patterns in use, 0 otherwise.
+ */
+static uint8_t Telemetry_Decode(uint8_t data)
+{
+    switch(Decoder_State)
+    {
+        case TELEMETRY_STATE_SYNC:
+        {
+            if (data == TELEMETRY_SYNC)
+            {
+                Decoder_State = TELEMETRY_STATE_TYPE;
+            }
+            break;
+        }
+
+        case TELEMETRY_STATE_TYPE:
+        {
+            Decoder_Type = data;
+            Decoder_Sum = data;
+            Decoder_State = TELEMETRY_STATE_LENGTH;
+            break;
+        }
+
+        case TELEMETRY_STATE_LENGTH:
+        {
+            if (data > TELEMETRY_MAX_PAYLOAD)
+            {
+                Decoder_State = TELEMETRY_STATE_SYNC;
+                Telemetry_Send_Ack(Decoder_Type, TELEMETRY_STATUS_BAD_LENGTH);
+                break;
+            }
+            Decoder_Length = data;
+            Decoder_Index = 0;
+            Decoder_Sum = Decoder_Sum + data;
+            Decoder_State = (data == 0) ? TELEMETRY_STATE_CHECKSUM : TELEMETRY_STATE_PAYLOAD;
+            break;
+        }
+
+        case TELEMETRY_STATE_PAYLOAD:
+        {
+            Decoder_Payload[Decoder_Index] = data;
+            Decoder_Index = Decoder_Index + 1;
+            Decoder_Sum = Decoder_Sum + data;
+            if (Decoder_Index == Decoder_Length)
+            {
+                Decoder_State = TELEMETRY_STATE_CHECKSUM;
+            }
+            break;
+        }
+
+        default:
+        {
+            Decoder_State = TELEMETRY_STATE_SYNC;
+            if ((uint8_t)(Decoder_Sum + data) != 0)
+            {
+                Telemetry_Send_Ack(Decoder_Type, TELEMETRY_STATUS_BAD_CHECKSUM);
+                break;
+            }
+            return Telemetry_Execute(Decoder_Type, Decoder_Payload, Decoder_Length);
+        }
+    }
+    return 0;
+}
+
+void Telemetry_Init(uint32_t priority)
+{
+    Decoder_State = TELEMETRY_STATE_SYNC;
+    Transfer = TELEMETRY_TRANSFER_NONE;
+    Trace_Cursor = 0;
+    Override_Mask = 0;
+    UART0_Init(priority);
+}
+
+uint8_t Telemetry_Poll(void)
+{
+    uint8_t changed = 0;
+
+    // Every step either queues at most one frame, which fits in the transmit ring buffer,
+    // or consumes one received byte, so the loop ends when both are exhausted
+    while (Telemetry_Has_Work())
+    {
+        if (Transfer != TELEMETRY_TRANSFER_NONE)
+        {
+            Telemetry_Continue_Transfer();
+        }
+        else
+        {
+            uint8_t data;
+            UART0_Read(&data);
+            changed = changed | Telemetry_Decode(data);
+        }
+    }
+    return changed;
+}
+
+uint8_t Telemetry_Has_Work(void)
+{
+    if (UART0_Get_Free() < TELEMETRY_MAX_FRAME)
+    {
+        return 0;
+    }
+    return ((Transfer != TELEMETRY_TRANSFER_NONE) || (UART0_Available() != 0)) ? 1 : 0;
+}
+
+void Telemetry_Apply_Overrides(uint8_t *button_status, uint8_t *switch_status)
+{
+    if (Override_Mask & TELEMETRY_OVERRIDE_BUTTONS)
+    {
+        *button_status = Override_Buttons;
+    }
+    if (Override_Mask & TELEMETRY_OVERRIDE_SWITCHES)
+    {
+        *switch_status = Override_Switches;
+    }
+}
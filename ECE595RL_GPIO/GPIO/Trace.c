@@ -0,0 +1,71 @@
+/**
+ * @file Trace.c
+ * @brief Source code for the Trace driver.
+ *
+ * This file contains the function definitions for the event trace.
+ * When TRACE_DISABLE is defined, the functions are empty and no trace buffer is allocated.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Trace.h"
+
+#ifndef TRACE_DISABLE
+
+Trace_Entry Trace_Buffer[TRACE_SIZE];
+volatile uint32_t Trace_Index = 0;
+
+void Trace_Init(void)
+{
+    // Enable the trace block and the cycle counter, which may already be running for the Profile driver
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (uint32_t index = 0; index < TRACE_SIZE; index++)
+    {
+        Trace_Buffer[index].cycles = 0;
+        Trace_Buffer[index].event = 0;
+        Trace_Buffer[index].arg = 0;
+        Trace_Buffer[index].value = 0;
+    }
+    Trace_Index = 0;
+}
+
+uint32_t Trace_Get_Count(void)
+{
+    return Trace_Index;
+}
+
+uint8_t Trace_Read(uint32_t sequence, Trace_Entry *entry)
+{
+    // The entries still in the buffer are the last TRACE_SIZE sequence numbers before Trace_Index
+    if ((Trace_Index - sequence - 1) >= TRACE_SIZE)
+    {
+        return 0;
+    }
+
+    *entry = Trace_Buffer[sequence & (TRACE_SIZE - 1)];
+
+    // Discard the copy if an interrupt handler overwrote the slot in the meantime
+    return ((Trace_Index - sequence) <= TRACE_SIZE) ? 1 : 0;
+}
+
+#else
+
+void Trace_Init(void)
+{
+}
+
+uint32_t Trace_Get_Count(void)
+{
+    return 0;
+}
+
+uint8_t Trace_Read(uint32_t sequence, Trace_Entry *entry)
+{
+    return 0;
+}
+
+#endif /* TRACE_DISABLE */
@@ -0,0 +1,165 @@
+/**
+ * @file UART0.c
+ * @brief Source code for the UART0 driver.
+ *
+ * This file contains the function definitions for the interrupt-driven eUSCI_A0 UART.
+ * EUSCIA0_IRQHandler overrides the weak definition found in startup_msp432p401r_ccs.c.
+ *
+ * The receive ring buffer is filled by EUSCIA0_IRQHandler and emptied by the main loop.
+ * The transmit ring buffer is filled by the main loop and emptied by EUSCIA0_IRQHandler.
+ * All indices are free-running and are masked when the buffers are accessed.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/UART0.h"
+#include "../inc/RamFunc.h"
+
+// P1.2 (UCA0RXD) and P1.3 (UCA0TXD)
+#define UART0_PINS              0x0C
+
+// Baud rate generator for 115200 baud from SMCLK = 12 MHz (N = 104.17, oversampling mode):
+// UCBRx = INT(N / 16) = 6, UCBRFx = INT(((N / 16) - 6) * 16) = 8, UCBRSx = 0x20 (fractional part 0.17)
+#define UART0_BRW               6
+#define UART0_MCTLW             0x2081
+
+// Bit of the transmit interrupt enable (TXIE) in UCA0IE
+#define UART0_TXIE_BIT          1
+
+static uint8_t UART0_RX_Buffer[UART0_RX_SIZE];
+static volatile uint32_t UART0_RX_Head = 0;
+static volatile uint32_t UART0_RX_Tail = 0;
+static volatile uint32_t UART0_RX_Overflows = 0;
+
+static uint8_t UART0_TX_Buffer[UART0_TX_SIZE];
+static volatile uint32_t UART0_TX_Head = 0;
+static volatile uint32_t UART0_TX_Tail = 0;
+
+void UART0_Init(uint32_t priority)
+{
+    NVIC_DisableIRQ(EUSCIA0_IRQn);
+
+    // Hold the eUSCI_A0 module in reset while it is configured
+    EUSCI_A0->CTLW0 = 0x0001;
+
+    // Select the primary module function (UART) of P1.2 and P1.3
+    P1->SEL0 |= UART0_PINS;
+    P1->SEL1 &= ~UART0_PINS;
+
+    // bit15=0,      no parity
+    // bit14=x,      not used when parity is disabled
+    // bit13=0,      LSB first
+    // bit12=0,      8-bit data length
+    // bit11=0,      1 stop bit
+    // bits10-8=000, asynchronous UART mode
+    // bits7-6=10,   clock source to SMCLK
+    // bit5=0,       reject erroneous characters and do not set flag
+    // bit4=0,       do not set flag on break receive
+    // bit3=0,       not dormant
+    // bit2=0,       transmit data, not address (not used here)
+    // bit1=0,       do not transmit break (not used here)
+    // bit0=1,       hold logic in reset state while configuring
+    EUSCI_A0->CTLW0 = 0x0081;
+    EUSCI_A0->BRW = UART0_BRW;
+    EUSCI_A0->MCTLW = UART0_MCTLW;
+
+    UART0_RX_Head = 0;
+    UART0_RX_Tail = 0;
+    UART0_RX_Overflows = 0;
+    UART0_TX_Head = 0;
+    UART0_TX_Tail = 0;
+
+    // Release the module from reset, then enable the receive interrupt.
+    // The transmit interrupt is only enabled while the transmit ring buffer holds data.
+    EUSCI_A0->CTLW0 &= ~0x0001;
+    EUSCI_A0->IE = 0x0001;
+
+    NVIC_SetPriority(EUSCIA0_IRQn, priority);
+    NVIC_ClearPendingIRQ(EUSCIA0_IRQn);
+    NVIC_EnableIRQ(EUSCIA0_IRQn);
+}
+
+uint8_t UART0_Read(uint8_t *data)
+{
+    uint32_t tail = UART0_RX_Tail;
+    if (tail == UART0_RX_Head)
+    {
+        return 0;
+    }
+
+    *data = UART0_RX_Buffer[tail & (UART0_RX_SIZE - 1)];
+    UART0_RX_Tail = tail + 1;
+    return 1;
+}
+
+uint32_t UART0_Available(void)
+{
+    return UART0_RX_Head - UART0_RX_Tail;
+}
+
+uint8_t UART0_Write(const uint8_t *data, uint32_t length)
+{
+    uint32_t head = UART0_TX_Head;
+    if (length > (UART0_TX_SIZE - (head - UART0_TX_Tail)))
+    {
+        return 0;
+    }
+
+    for (uint32_t index = 0; index < length; index++)
+    {
+        UART0_TX_Buffer[(head + index) & (UART0_TX_SIZE - 1)] = data[index];
+    }
+
+    // Publish the bytes, then enable the transmit interrupt with a single bit-band store,
+    // so the write cannot overwrite the receive enable bit or a change made by EUSCIA0_IRQHandler
+    UART0_TX_Head = head + length;
+    BITBAND_PERI(EUSCI_A0->IE, UART0_TXIE_BIT) = 1;
+    return 1;
+}
+
+uint32_t UART0_Get_Free(void)
+{
+    return UART0_TX_SIZE - (UART0_TX_Head - UART0_TX_Tail);
+}
+
+uint32_t UART0_Get_Overflows(void)
+{
+    return UART0_RX_Overflows;
+}
+
+RAMFUNC void EUSCIA0_IRQHandler(void)
+{
+    // Reading RXBUF clears the receive flag
+    if (EUSCI_A0->IFG & 0x0001)
+    {
+        uint8_t data = (uint8_t)EUSCI_A0->RXBUF;
+        uint32_t head = UART0_RX_Head;
+        if ((head - UART0_RX_Tail) < UART0_RX_SIZE)
+        {
+            UART0_RX_Buffer[head & (UART0_RX_SIZE - 1)] = data;
+            UART0_RX_Head = head + 1;
+        }
+        else
+        {
+            UART0_RX_Overflows = UART0_RX_Overflows + 1;
+        }
+    }
+
+    // Writing TXBUF clears the transmit flag. The transmit flag stays set while the buffer is empty,
+    // so the transmit interrupt is disabled until UART0_Write queues more bytes.
+    if ((EUSCI_A0->IFG & 0x0002) && BITBAND_PERI(EUSCI_A0->IE, UART0_TXIE_BIT))
+    {
+        uint32_t tail = UART0_TX_Tail;
+        if (tail != UART0_TX_Head)
+        {
+            EUSCI_A0->TXBUF = UART0_TX_Buffer[tail & (UART0_TX_SIZE - 1)];
+            UART0_TX_Tail = tail + 1;
+        }
+        else
+        {
+            BITBAND_PERI(EUSCI_A0->IE, UART0_TXIE_BIT) = 0;
+        }
+    }
+}
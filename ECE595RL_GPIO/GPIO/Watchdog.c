@@ -0,0 +1,125 @@
+/**
+ * @file Watchdog.c
+ * @brief Source code for the Watchdog driver.
+ *
+ * This file contains the function definitions for supervising the main loop with the watchdog timer (WDT_A).
+ * A watchdog timeout causes a hard reset (the default of SYSCTL->WDTRESET_CTL), which is found
+ * in RSTCTL->HARDRESET_STAT after the reset. SRAM is retained through the reset.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/Watchdog.h"
+#include "../inc/Clock.h"
+#include "../inc/RamFunc.h"
+#include "../inc/Trace.h"
+
+// Places a variable in the .noinit section, which msp432p401r.cmd allocates in SRAM without initialization
+#if defined(__TI_COMPILER_VERSION__)
+#define WATCHDOG_NOINIT     __attribute__((section(".noinit")))
+#else
+#define WATCHDOG_NOINIT
+#endif
+
+// Watchdog mode, clocked by ACLK, with an interval of 2^13 cycles (250 ms at 32.768 kHz)
+#define WATCHDOG_CTL        (WDT_A_CTL_PW | WDT_A_CTL_SSEL__ACLK | WDT_A_CTL_IS_5)
+
+// Combined with the counters to form the check word
+#define WATCHDOG_MAGIC      0x57444F47
+
+// Counters and check word retained through a reset
+static Watchdog_Counters Watchdog_Retained WATCHDOG_NOINIT;
+static uint32_t Watchdog_Check WATCHDOG_NOINIT;
+
+Watchdog_Counters Watchdog_Boot_Counters;
+uint8_t Watchdog_Boot_Cause;
+
+// Budget of one iteration of the main loop in us
+static uint32_t Watchdog_Budget_us;
+
+// Value of the cycle counter at the start of the iteration
+static uint32_t Watchdog_Loop_Cycles;
+
+/**
+ * @brief The Watchdog_Sum function computes the check word of the retained counters.
+ *
+ * @param None
+ *
+ * @return The check word.
+ */
+static uint32_t Watchdog_Sum(void)
+{
+    return WATCHDOG_MAGIC ^ Watchdog_Retained.watchdog_resets ^ Watchdog_Retained.deadline_misses ^ Watchdog_Retained.worst_loop_us;
+}
+
+void Watchdog_Init(uint32_t budget_us)
+{
+    uint32_t hard_reset = RSTCTL->HARDRESET_STAT;
+    uint32_t soft_reset = RSTCTL->SOFTRESET_STAT;
+    RSTCTL->HARDRESET_CLR = hard_reset;
+    RSTCTL->SOFTRESET_CLR = soft_reset;
+
+    // The counters are random after a power-up
+    if (Watchdog_Check != Watchdog_Sum())
+    {
+        Watchdog_Retained.watchdog_resets = 0;
+        Watchdog_Retained.deadline_misses = 0;
+        Watchdog_Retained.worst_loop_us = 0;
+        Watchdog_Boot_Cause = WATCHDOG_CAUSE_POWER_UP;
+    }
+    else if ((hard_reset & RSTCTL_HARDRESET_STAT_SRC1) || (soft_reset & RSTCTL_SOFTRESET_STAT_SRC1))
+    {
+        Watchdog_Retained.watchdog_resets = Watchdog_Retained.watchdog_resets + 1;
+        Watchdog_Boot_Cause = WATCHDOG_CAUSE_TIMEOUT;
+    }
+    else
+    {
+        Watchdog_Boot_Cause = WATCHDOG_CAUSE_OTHER;
+    }
+    Watchdog_Check = Watchdog_Sum();
+    Watchdog_Boot_Counters = Watchdog_Retained;
+
+    if (Watchdog_Boot_Cause == WATCHDOG_CAUSE_TIMEOUT)
+    {
+        Trace_Record(TRACE_EVENT_WATCHDOG_RESET, 0, (uint16_t)Watchdog_Retained.watchdog_resets);
+    }
+
+    Watchdog_Budget_us = budget_us;
+    Watchdog_Loop_Cycles = DWT->CYCCNT;
+    WDT_A->CTL = WATCHDOG_CTL | WDT_A_CTL_CNTCL;
+}
+
+RAMFUNC void Watchdog_Loop_Start(void)
+{
+    Watchdog_Loop_Cycles = DWT->CYCCNT;
+}
+
+RAMFUNC void Watchdog_Loop_End(void)
+{
+    WDT_A->CTL = WATCHDOG_CTL | WDT_A_CTL_CNTCL;
+
+    // The check word is only updated when a counter changes, which is rare once the worst case has been seen
+    uint32_t loop_us = (DWT->CYCCNT - Watchdog_Loop_Cycles) / (Clock_GetFreq() / 1000000);
+    if ((loop_us <= Watchdog_Retained.worst_loop_us) && (loop_us <= Watchdog_Budget_us))
+    {
+        return;
+    }
+
+    if (loop_us > Watchdog_Retained.worst_loop_us)
+    {
+        Watchdog_Retained.worst_loop_us = loop_us;
+    }
+    if (loop_us > Watchdog_Budget_us)
+    {
+        Watchdog_Retained.deadline_misses = Watchdog_Retained.deadline_misses + 1;
+        Trace_Record(TRACE_EVENT_DEADLINE_MISS, 0, (loop_us > 0xFFFF) ? 0xFFFF : (uint16_t)loop_us);
+    }
+    Watchdog_Check = Watchdog_Sum();
+}
+
+void Watchdog_Get_Counters(Watchdog_Counters *counters)
+{
+    *counters = Watchdog_Retained;
+}
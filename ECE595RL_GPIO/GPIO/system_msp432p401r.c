@@ -53,6 +53,9 @@
    3. If you prefer the DC-DC power regulator (more efficient at higher
        frequencies), set the __REGULATOR to 1:
    #define __REGULATOR      1
+   4. If the application configures the clocks itself (Clock_Init48MHz),
+       set __CLOCK_SETUP to 0 to skip steps 4 to 7 of SystemInit:
+   #define __CLOCK_SETUP    0
  *---------------------------------------------------------------------------*/
 
 /*--------------------- Watchdog Timer Configuration ------------------------*/
@@ -76,6 +79,12 @@
 //     <1> DC-DC
 #define __REGULATOR        0
 
+/*--------------------- Clock Setup Configuration ---------------------------*/
+//  Clock Setup
+//     <0> Keep the reset clocks (DCO at 3 MHz); main configures them with Clock_Init48MHz
+//     <1> Configure the clocks for __SYSTEM_CLOCK
+#define __CLOCK_SETUP      0
+
 /*----------------------------------------------------------------------------
    Define clocks, used for SystemCoreClockUpdate()
  *---------------------------------------------------------------------------*/
@@ -87,7 +96,11 @@
 /*----------------------------------------------------------------------------
    Clock Variable definitions
  *---------------------------------------------------------------------------*/
+#if __CLOCK_SETUP
 uint32_t SystemCoreClock = __SYSTEM_CLOCK;  /*!< System Clock Frequency (Core Clock)*/
+#else
+uint32_t SystemCoreClock = 3000000;         /*!< System Clock Frequency (Core Clock), DCO at reset*/
+#endif
 
 /**
  * Update SystemCoreClock variable
@@ -262,6 +275,8 @@ void SystemCoreClockUpdate(void)
  *     5. Enable Flash wait states if needed
  *     6. Change MCLK to desired frequency
  *     7. Enable Flash read buffering
+ *
+ * Steps 4 to 7 are skipped if __CLOCK_SETUP is 0.
  */
 void SystemInit(void)
 {
@@ -277,7 +292,10 @@ void SystemInit(void)
 
     SYSCTL->SRAM_BANKEN = SYSCTL_SRAM_BANKEN_BNK7_EN;      // Enable all SRAM banks
 
-    #if (__SYSTEM_CLOCK == 1500000)                        // 1.5 MHz
+    #if (__CLOCK_SETUP == 0)                               // Keep the reset clocks (DCO = 3 MHz, LDO VCORE0)
+    // No change necessary
+
+    #elif (__SYSTEM_CLOCK == 1500000)                        // 1.5 MHz
     // Default VCORE is LDO VCORE0 so no change necessary
 
     // Switches LDO VCORE0 to DCDC VCORE0 if requested
@@ -0,0 +1,118 @@
+/**
+ * @file Benchmark.h
+ * @brief Header file for the Benchmark driver.
+ *
+ * This file contains the function definitions for measuring the latency from an input change to the
+ * corresponding output change, end to end on the hardware. It is compiled in the Benchmark build configuration,
+ * which defines BENCHMARK_ENABLE. In the other configurations, the functions are empty.
+ *
+ * The stimulus is applied through loopback jumpers in place of the PMOD SWT module, which must be removed:
+ *  - Stimulus      (P4.0 - P4.3)   <-->  PMOD SWT inputs (P10.0 - P10.3)
+ *  - Strobe        (P4.4)          <-->  TA3.CCI0A (P10.4)
+ *  - Frame marker  (P5.0)          <-->  TA3.CCI1A (P10.5)
+ *
+ * The strobe is written in the same store as the stimulus, and the frame marker is toggled by LED_Frame_Commit
+ * right after it changes LED1, the RGB LED (P2), or the PMOD 8LD module (P9). Timer_A3 counts SMCLK/8 (1.5 MHz)
+ * and captures both edges in hardware, so the interrupt latency does not affect the measurement.
+ * The measured latency therefore includes the debouncing, the event delivery, the pattern selection, and the wait
+ * for the tick boundary at which the frame is committed.
+ *
+ * Every sample starts from LED_Pattern_1 with the buttons released (switch status 0x00), which is held, so the first
+ * output change after the stimulus belongs to the new pattern. The stimulus is delayed by a pseudo-random number of
+ * timer counts, so the samples are spread over the phase of the 1 ms tick. The patterns are measured in this order:
+ *  - LED_Pattern_2 (switch status 0x01)
+ *  - LED_Pattern_3 (switch status 0x02)
+ *  - LED_Pattern_4 (switch status 0x04)
+ *  - LED_Pattern_5 (switch status 0x08)
+ *
+ * The results can be viewed in Benchmark_Results from the debugger or read with TELEMETRY_CMD_GET_BENCHMARK.
+ *
+ * TA3_0_IRQHandler and TA3_N_IRQHandler override the weak definitions found in startup_msp432p401r_ccs.c.
+ *
+ * @note The user buttons (P1.1 and P1.4) are not available on the LaunchPad headers, so they cannot be driven
+ * through a jumper. The switches share the same path (Debounce_Sample, PORT1_IRQHandler, LED_Select_Pattern).
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+// Number of measured patterns and number of samples per pattern
+#define BENCHMARK_PATTERN_COUNT     4
+#define BENCHMARK_SAMPLE_COUNT      200
+
+/**
+ * @brief Benchmark_Result holds the latency statistics of one pattern.
+ *
+ *  - switch_status:    Switch status that selects the pattern
+ *  - samples:          Number of measured samples
+ *  - timeouts:         Number of stimuli without an output change within 40 ms
+ *  - min_ns:           Shortest latency in ns
+ *  - mean_ns:          Mean latency in ns
+ *  - max_ns:           Longest latency in ns
+ *  - p99_ns:           99th percentile of the latency in ns
+ */
+typedef struct
+{
+    uint8_t switch_status;
+    uint16_t samples;
+    uint16_t timeouts;
+    uint32_t min_ns;
+    uint32_t mean_ns;
+    uint32_t max_ns;
+    uint32_t p99_ns;
+} Benchmark_Result;
+
+#ifdef BENCHMARK_ENABLE
+
+// Statistics of every measured pattern, valid once its samples field is BENCHMARK_SAMPLE_COUNT
+extern Benchmark_Result Benchmark_Results[BENCHMARK_PATTERN_COUNT];
+
+// Toggles the frame marker (P5.0). It must only be called from LED_Frame_Commit.
+#define BENCHMARK_MARK()        (BITBAND_PERI(P5->OUT, 0) = BITBAND_PERI(P5->OUT, 0) ^ 1)
+
+#else
+
+#define BENCHMARK_MARK()
+
+#endif /* BENCHMARK_ENABLE */
+
+/**
+ * @brief The Benchmark_Init function configures the loopback pins and starts Timer_A3.
+ *
+ * This function must be called after GPIO_Pins_Init and before Debounce_Init, so the debounced state
+ * starts from switch status 0x00. It does nothing if BENCHMARK_ENABLE is not defined.
+ *
+ * @param priority The TA3_0 and TA3_N interrupt priority (0 is highest, 7 is lowest).
+ *
+ * @return None
+ */
+void Benchmark_Init(uint32_t priority);
+
+/**
+ * @brief The Benchmark_Poll function computes the statistics of a pattern once all of its samples are measured.
+ *
+ * The samples are sorted to find the 99th percentile, then the measurement of the next pattern is started.
+ * This function must be called from the main loop.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Benchmark_Poll(void);
+
+/**
+ * @brief The Benchmark_Get_Result function copies the statistics of a measured pattern.
+ *
+ * @param index     The index of the pattern (0 to BENCHMARK_PATTERN_COUNT - 1).
+ * @param result    A pointer to the structure that receives the statistics.
+ *
+ * @return 1 if the pattern has been measured, 0 otherwise.
+ */
+uint8_t Benchmark_Get_Result(uint32_t index, Benchmark_Result *result);
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,107 @@
+/**
+ * @file Boot.h
+ * @brief Header file for the Boot driver.
+ *
+ * This file contains the function definitions for measuring the boot time of the GPIO program,
+ * from the entry of main to the first output change of the LED pattern engine.
+ *
+ * main records a timestamp with Boot_Mark at the end of every boot stage:
+ *
+ *  Stage                           End of the stage
+ *  -----                           ----------------
+ *  BOOT_STAGE_OUTPUTS_SAFE         GPIO_Pins_Init has driven every output to its initial (off) level
+ *  BOOT_STAGE_CLOCK_STARTED        VCORE1 has been requested and the crystal started
+ *  BOOT_STAGE_PERIPHERALS          The drivers that do not depend on MCLK or SMCLK are initialized
+ *  BOOT_STAGE_CLOCK_READY          MCLK has been switched to 48 MHz (recorded by Boot_Clock_Changed)
+ *  BOOT_STAGE_TICK_STARTED         The pattern engine tick is running and the main loop is entered
+ *  BOOT_STAGE_FIRST_OUTPUT         LED_Frame_Commit has displayed the first step of the selected pattern
+ *
+ * With Clock_Init48MHz_Async, the switch to 48 MHz completes in an interrupt handler,
+ * so BOOT_STAGE_CLOCK_READY can end before or after BOOT_STAGE_PERIPHERALS. The drivers that count MCLK
+ * or SMCLK cycles are only initialized once it has ended, so it always ends before BOOT_STAGE_TICK_STARTED.
+ *
+ * The time of BOOT_STAGE_FIRST_OUTPUT is the time to the first valid output. The times are kept in us
+ * in Boot_Times_us, which can be added to the Expressions window of the debugger, and can be read over
+ * UART0 with TELEMETRY_CMD_GET_BOOT.
+ *
+ * The times are measured with the DWT cycle counter (CYCCNT), which counts MCLK cycles. The cycles are
+ * converted at the MCLK frequency of each interval, which is updated by Boot_Clock_Changed.
+ * The reset sequence and SystemInit, which run before main, are not included.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef BOOT_H_
+#define BOOT_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+// Boot stages
+#define BOOT_STAGE_OUTPUTS_SAFE     0
+#define BOOT_STAGE_CLOCK_STARTED    1
+#define BOOT_STAGE_PERIPHERALS      2
+#define BOOT_STAGE_CLOCK_READY      3
+#define BOOT_STAGE_TICK_STARTED     4
+#define BOOT_STAGE_FIRST_OUTPUT     5
+#define BOOT_STAGE_COUNT            6
+
+// Time from the entry of main to the end of every boot stage in us, or 0 if the stage has not ended yet
+extern uint32_t Boot_Times_us[BOOT_STAGE_COUNT];
+
+/**
+ * @brief The Boot_Init function starts the DWT cycle counter and clears the boot times.
+ *
+ * This function must be the first call of main. The cycle counter is not reset,
+ * so it can be shared with the Profile and Trace drivers.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Boot_Init(void);
+
+/**
+ * @brief The Boot_Mark function records the end of a boot stage.
+ *
+ * A stage is only recorded once. This function can be called with interrupts disabled, because the previous PRIMASK is restored.
+ *
+ * @param stage The boot stage (BOOT_STAGE_OUTPUTS_SAFE to BOOT_STAGE_COUNT - 1).
+ *
+ * @return None
+ */
+void Boot_Mark(uint32_t stage);
+
+/**
+ * @brief The Boot_Clock_Changed function converts the following cycles at the new MCLK frequency.
+ *
+ * This function is registered with Clock_AddListener before the switch to 48 MHz is started.
+ * The first call records BOOT_STAGE_CLOCK_READY. It does nothing once BOOT_STAGE_FIRST_OUTPUT has been recorded.
+ *
+ * @param frequency The new MCLK frequency in Hz.
+ *
+ * @return None
+ */
+void Boot_Clock_Changed(uint32_t frequency);
+
+/**
+ * @brief The Boot_Output_Changed function records BOOT_STAGE_FIRST_OUTPUT on the first output change.
+ *
+ * It is called by LED_Frame_Commit whenever it changes an output, and returns immediately after the first call.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Boot_Output_Changed(void);
+
+/**
+ * @brief The Boot_Get_Time function returns the time from the entry of main to the end of a boot stage.
+ *
+ * @param stage The boot stage (BOOT_STAGE_OUTPUTS_SAFE to BOOT_STAGE_COUNT - 1).
+ *
+ * @return The time in us, or 0 if the stage has not ended yet.
+ */
+uint32_t Boot_Get_Time(uint32_t stage);
+
+#endif /* BOOT_H_ */
@@ -48,56 +48,181 @@ those of the authors and should not be interpreted as representing official
 policies, either expressed or implied, of the FreeBSD Project.
 */
 
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#include <stdint.h>
+
+// Progress of the switch to 48 MHz (Clock_Status.state)
+#define CLOCK_STATE_DCO             0   // MCLK from the 3 MHz DCO, no switch requested
+#define CLOCK_STATE_STARTING        1   // VCORE1 requested and HFXT enabled, MCLK still at 3 MHz
+#define CLOCK_STATE_READY           2   // MCLK, HSMCLK, and SMCLK sourced from HFXT
+#define CLOCK_STATE_FAILED          3   // the switch failed, MCLK stays at 3 MHz
+
+// Cause of a failed switch (Clock_Status.error)
+#define CLOCK_ERROR_NONE            0
+#define CLOCK_ERROR_PCM_BUSY        1   // the PCM did not become idle (Prewait)
+#define CLOCK_ERROR_PCM_INVALID     2   // the VCORE1 request was an invalid transition (IFlags)
+#define CLOCK_ERROR_VCORE_TIMEOUT   3   // VCORE1 was not reached (CPMwait, Postwait)
+#define CLOCK_ERROR_HFXT_TIMEOUT    4   // the crystal did not stabilize (Crystalstable, or CLOCK_ASYNC_TIMEOUT_MS)
+
+/**
+ * Progress of the switch to 48 MHz
+ * state is one of the CLOCK_STATE_ constants, error one of the CLOCK_ERROR_ constants,
+ * pcm_flags the PCM interrupt flags of an invalid transition, and
+ * hfxt_restarts the number of crystal faults seen by Clock_Init48MHz_Async()
+ * @see Clock_GetStatus()
+ * @brief  Status of the clock system
+ */
+typedef struct{
+  uint32_t state;
+  uint32_t error;
+  uint32_t pcm_flags;
+  uint32_t hfxt_restarts;
+} Clock_Status;
+
 /**
  * Configure the MSP432 clock to run at 48 MHz
  * @param none
  * @return none
- * @note  Since the crystal is used, the bus clock will be very accurate
- * @see Clock_GetFreq()
+ * @note  Since the crystal is used, the bus clock will be very accurate.
+ * Equivalent to Clock_Init48MHz_Start() followed by Clock_Init48MHz_Finish().
+ * @see Clock_GetFreq(), Clock_Init48MHz_Start()
  * @brief  Initialize clock to 48 MHz
  */
 void Clock_Init48MHz(void);
+
+
+/**
+ * Begin the switch to 48 MHz without waiting for it to complete:
+ * request power active mode LDO VCORE1 and start the 48 MHz crystal (HFXT).
+ * MCLK keeps running from the 3 MHz DCO until Clock_Init48MHz_Finish(),
+ * so the program can initialize peripherals that do not depend on
+ * MCLK or SMCLK while VCORE rises and the crystal settles.
+ * @param none
+ * @return none
+ * @see Clock_Init48MHz_Finish()
+ * @brief  Start VCORE1 and HFXT
+ */
+void Clock_Init48MHz_Start(void);
+
+
+/**
+ * Complete the switch started by Clock_Init48MHz_Start(): wait for VCORE1
+ * and a stable crystal, set 2 flash wait states, and source MCLK, HSMCLK,
+ * and SMCLK from HFXT, then call the functions registered with
+ * Clock_AddListener(). The clock stays at 3 MHz if the start failed or
+ * a wait timed out, which is reported by Clock_GetStatus().
+ * @param none
+ * @return none
+ * @note  Clock_Init48MHz_Start() must be called first
+ * @see Clock_Init48MHz_Start(), Clock_GetFreq()
+ * @brief  Switch MCLK to 48 MHz
+ */
+void Clock_Init48MHz_Finish(void);
+
+
+/**
+ * Begin the switch to 48 MHz and return immediately.
+ * Clock_Init48MHz_Start() is followed by the HFXT start fault counter,
+ * which interrupts once the crystal has run 16384 cycles without a fault.
+ * CS_IRQHandler then completes the switch as Clock_Init48MHz_Finish() does
+ * and calls the listeners, so the program keeps running at 3 MHz in the
+ * meantime with a correct ClockFrequency. PCM_IRQHandler reports an invalid
+ * VCORE1 request, and T32_INT2_IRQHandler gives up if the crystal is not
+ * stable within 50 ms.
+ * @param  priority is the CS, PCM, and Timer32 module 2 interrupt priority (0 is highest, 7 is lowest)
+ * @return none
+ * @note  A delay that spans the switch ends early, because Timer32 module 1
+ * counts MCLK cycles. CS_IRQHandler, PCM_IRQHandler, and T32_INT2_IRQHandler
+ * override the weak definitions in startup_msp432p401r_ccs.c, and Timer32
+ * module 2 is used for the time out.
+ * @see Clock_GetStatus(), Clock_AddListener()
+ * @brief  Switch MCLK to 48 MHz from interrupts
+ */
+void Clock_Init48MHz_Async(uint32_t priority);
+
+
+/**
+ * Copy the progress of the switch to 48 MHz. A failure of
+ * Clock_Init48MHz(), Clock_Init48MHz_Finish(), or Clock_Init48MHz_Async()
+ * leaves MCLK at 3 MHz, reports CLOCK_STATE_FAILED and the cause in error.
+ * @param  status is the structure that receives the status
+ * @return none
+ * @brief  Read the status of the clock system
+ */
+void Clock_GetStatus(Clock_Status *status);
  
 
 /**
  * Return the current bus clock frequency
  * @param none
  * @return frequency of the system clock in Hz
- * @note  In this module, the return result will be 3000000 or 48000000
- * @see Clock_Init48MHz()
+ * @note  In this module, the return result will be 3000000, 12000000, 24000000, or 48000000
+ * @see Clock_Init48MHz(), Clock_SetProfile()
  * @brief Returns current clock bus frequency in Hz
  */
 uint32_t Clock_GetFreq(void);
 
 
 /**
- * Simple delay function which delays about n milliseconds.
- * It is implemented with a nested for-loop and is very approximate.
+ * Change the MCLK frequency at run time by dividing the 48 MHz crystal.
+ * VCORE and the flash wait states are raised before the frequency goes up
+ * and lowered after it goes down, walking the PCM transition chart so that
+ * every intermediate setting is valid. SMCLK, HSMCLK, and ACLK do not change.
+ * ClockFrequency and SystemCoreClock are updated, then every function
+ * registered with Clock_AddListener() is called with the new frequency.
+ * While the switch to 48 MHz is in progress, the frequency is stored and
+ * applied once the switch completes.
+ * @param  frequency is 48000000, 24000000, 12000000, or 3000000
+ * @return 1 on success or if the frequency was stored, 0 if the frequency is
+ * not supported, MCLK is not sourced from HFXT, or a PCM transition failed
+ * @note  Clock_Init48MHz() or Clock_Init48MHz_Async() must be called first
+ * @see Clock_Init48MHz(), Clock_AddListener()
+ * @brief  Switch between 3, 12, 24, and 48 MHz
+ */
+uint32_t Clock_SetProfile(uint32_t frequency);
+
+
+/**
+ * Register a function that is called after Clock_SetProfile() changes
+ * the MCLK frequency, so that modules counting MCLK cycles can recompute
+ * their periods. Up to 4 listeners can be registered.
+ * The delay functions read ClockFrequency on every call and do not need a listener.
+ * @param  listener is the function called with the new frequency in Hz
+ * @return 1 if registered, 0 if the listener table is full
+ * @see Clock_SetProfile()
+ * @brief  Register a clock change listener
+ */
+uint32_t Clock_AddListener(void(*listener)(uint32_t frequency));
+
+
+/**
+ * Delay function which delays n milliseconds.
+ * By default it busy-waits on Timer32 module 1, which is started on the
+ * first call and counts MCLK cycles, so the delay is exact at any
+ * frequency stored in ClockFrequency (3 MHz out of reset, 48 MHz after
+ * Clock_Init48MHz) regardless of optimization level or flash wait states.
  * @param  n is the number of msec to wait
  * @return none
- * @note This function assumes a 48 MHz clock.
- * This implementation is not very accurate.
- * To improve accuracy, you could tune this function
- * by adjusting the constant within the implementation
- * found in the <b>Clock.c</b> file.
- * For a more accurate time delay, you could use the SysTick module.
- * @brief  Software implementation of a busy-wait delay
+ * @note Define CLOCK_DELAY_SOFTWARE in the project settings to use the
+ * original software loop instead, which does not use Timer32 and is smaller.
+ * That implementation is tuned at 48 MHz and is not very accurate.
+ * @brief  Busy-wait delay in milliseconds
  */
 void Clock_Delay1ms(uint32_t n);
 
 /**
- * Simple delay function which delays about n microseconds.
- * It is implemented with a nested for-loop and is very approximate.
+ * Delay function which delays n microseconds.
+ * By default it busy-waits on Timer32 module 1, see Clock_Delay1ms().
+ * The call overhead is not compensated, so short delays are longer
+ * by a few tens of MCLK cycles (well under 1 us at 48 MHz).
  * @param  n is the number of usec to wait
  * @return none
- * @note This function assumes a 48 MHz clock.
- * This implementation is not very accurate.
- * To improve accuracy, you could tune this function
- * by adjusting the constant within the implementation
- * found in the <b>Clock.c</b> file.
- * For a more accurate time delay, you could use the SysTick module.
- * @brief  Software implementation of a busy-wait delay
+ * @note Define CLOCK_DELAY_SOFTWARE in the project settings to use the
+ * original software loop instead, which is tuned at 48 MHz and is not very accurate.
+ * @brief  Busy-wait delay in microseconds
  */
 void Clock_Delay1us(uint32_t n);
 
-
+#endif /* CLOCK_H_ */
@@ -0,0 +1,190 @@
+/**
+ * @file ConfigStore.h
+ * @brief Header file for the ConfigStore driver.
+ *
+ * This file contains the function definitions for the configuration store in INFO flash, which holds
+ * customer-specific pattern tables and the clock and debounce settings without recompiling the program.
+ * The store uses sector 0 of INFO bank 0 (CONFIG_STORE_ADDRESS, see msp432p401r.cmd). The other INFO sectors
+ * hold the device descriptor (TLV) and the bootloader. The program does not use the flash mailbox, and the
+ * first word of a record never matches the mailbox command key, so the boot code ignores the sector.
+ *
+ * The sector is a log of records. Each update appends a record after the last one, and the sector is only
+ * erased when the next record does not fit, which spreads the wear over many updates. A record is made of
+ * 16-byte flash words, so every flash word is programmed once between erases:
+ *
+ *  Offset  Flash word      Content
+ *  ------  ----------      -------
+ *  0       Header          magic (4), length (2), sequence (2), erase count (4), 0xFFFFFFFF (4)
+ *  16      Commit          CRC32 of the data (4), inverted CRC32 (4), 0xFFFFFFFF (8)
+ *  32      Data            Config_Data, padded with 0xFF to a multiple of 16 bytes
+ *
+ * The header is programmed by ConfigStore_Begin and the commit word by ConfigStore_Commit, once the data has
+ * been programmed and checked. A record that was not committed (for example after a reset during an update)
+ * is skipped. At boot, ConfigStore_Init finds the last committed record and validates its data with the
+ * CRC32 hardware module. The data is then read in place: only the pointer to it is kept in SRAM.
+ *
+ * The data of a record is a Config_Data structure (little-endian, 40 bytes) followed by the steps of its
+ * patterns in the packed LED_Step format (see LED_Step.h): the steps of patterns[0] first, then the steps of
+ * patterns[1], and so on. Every pattern replaces the built-in patterns of its switch status for every button status.
+ *
+ * A new configuration is used after the next reset. An update that erases the sector invalidates the
+ * configuration found at boot immediately, and ConfigStore_Get returns 0 until the next reset.
+ *
+ * @note The flash routines run from SRAM with interrupts disabled, because INFO bank 0 and the program
+ * share flash bank 0. An erase takes a few ms, so the pattern engine loses the ticks of that time.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef CONFIGSTORE_H_
+#define CONFIGSTORE_H_
+
+#include <stdint.h>
+#include "../inc/LED_Step.h"
+
+// Sector used by the configuration store (INFO bank 0, sector 0)
+#define CONFIG_STORE_ADDRESS        0x00200000
+#define CONFIG_STORE_SIZE           4096
+
+// Number of bytes programmed by one call to ConfigStore_Write (one flash word)
+#define CONFIG_STORE_CHUNK          16
+
+// Largest data of a record in bytes, so at least three records fit in the sector
+#define CONFIG_STORE_MAX_LENGTH     1024
+
+// Number of patterns of a configuration
+#define CONFIG_STORE_MAX_PATTERNS   8
+
+// Largest total number of steps of a configuration
+#define CONFIG_STORE_MAX_STEPS      ((CONFIG_STORE_MAX_LENGTH - sizeof(Config_Data)) / sizeof(LED_Step))
+
+// Results of ConfigStore_Begin, ConfigStore_Write, and ConfigStore_Commit
+#define CONFIG_STORE_OK             0
+#define CONFIG_STORE_BAD_LENGTH     1
+#define CONFIG_STORE_BAD_STATE      2
+#define CONFIG_STORE_INVALID        3
+#define CONFIG_STORE_FLASH_ERROR    4
+
+/**
+ * @brief Config_Pattern describes one pattern of a configuration.
+ *
+ *  - switch_status:    Switch status that displays the pattern (0x00 - 0x0F)
+ *  - reserved:         Must be 0
+ *  - step_count:       Number of steps of the pattern (at least 1)
+ */
+typedef struct
+{
+    uint8_t switch_status;
+    uint8_t reserved;
+    uint16_t step_count;
+} Config_Pattern;
+
+/**
+ * @brief Config_Data describes the data of a record.
+ *
+ *  - idle_clock_hz:    MCLK frequency of a held pattern (3000000, 12000000, 24000000, or 48000000), or 0 for the default
+ *  - debounce_samples: Number of samples for a debounced input (DEBOUNCE_MIN_SAMPLES - DEBOUNCE_MAX_SAMPLES), or 0 for the default
+ *  - pattern_count:    Number of entries used in patterns (0 - CONFIG_STORE_MAX_PATTERNS)
+ *  - step_count:       Total number of steps, which is the sum of the step_count of the patterns used
+ *  - patterns:         The patterns, of which the first pattern_count entries are used
+ *  - steps:            The steps of every pattern, in the order of patterns
+ */
+typedef struct
+{
+    uint32_t idle_clock_hz;
+    uint8_t debounce_samples;
+    uint8_t pattern_count;
+    uint16_t step_count;
+    Config_Pattern patterns[CONFIG_STORE_MAX_PATTERNS];
+    LED_Step steps[];
+} Config_Data;
+
+/**
+ * @brief ConfigStore_Status describes the content of the sector.
+ *
+ *  - loaded:       1 if the configuration found at boot is in use, 0 otherwise
+ *  - sequence:     Sequence number of the last committed record, incremented by every update (0 if none)
+ *  - length:       Length of the data of the last committed record in bytes (0 if none)
+ *  - crc:          CRC32 of the data of the last committed record (0 if none)
+ *  - free_offset:  Offset of the next record in the sector (CONFIG_STORE_SIZE if the sector must be erased first)
+ *  - erase_count:  Number of erases of the sector recorded in the last header
+ */
+typedef struct
+{
+    uint8_t loaded;
+    uint16_t sequence;
+    uint16_t length;
+    uint32_t crc;
+    uint16_t free_offset;
+    uint32_t erase_count;
+} ConfigStore_Status;
+
+/**
+ * @brief The ConfigStore_Init function finds and validates the last committed configuration.
+ *
+ * The data is validated with the CRC32 hardware module, and its fields are checked against the limits of
+ * Config_Data. If the last committed record fails, the committed records before it are tried.
+ *
+ * @param None
+ *
+ * @return A pointer to the configuration in INFO flash, or 0 if there is no valid configuration.
+ */
+const Config_Data *ConfigStore_Init(void);
+
+/**
+ * @brief The ConfigStore_Get function returns the configuration found by ConfigStore_Init.
+ *
+ * @param None
+ *
+ * @return A pointer to the configuration in INFO flash, or 0 if there is none or the sector has been erased since.
+ */
+const Config_Data *ConfigStore_Get(void);
+
+/**
+ * @brief The ConfigStore_Begin function starts an update and programs the header of the new record.
+ *
+ * The sector is erased first if the record does not fit after the last one. An update that was in progress is abandoned.
+ * This function must be called from the main loop.
+ *
+ * @param length The length of the data in bytes (a multiple of 4, at most CONFIG_STORE_MAX_LENGTH).
+ *
+ * @return CONFIG_STORE_OK, CONFIG_STORE_BAD_LENGTH, or CONFIG_STORE_FLASH_ERROR.
+ */
+uint8_t ConfigStore_Begin(uint16_t length);
+
+/**
+ * @brief The ConfigStore_Write function programs the next CONFIG_STORE_CHUNK bytes of the data.
+ *
+ * The chunks must be written in order. The bytes of the last chunk after the end of the data should be 0xFF.
+ * This function must be called from the main loop.
+ *
+ * @param offset    The offset of the chunk in the data (a multiple of CONFIG_STORE_CHUNK).
+ * @param data      A pointer to the CONFIG_STORE_CHUNK bytes of the chunk.
+ *
+ * @return CONFIG_STORE_OK, CONFIG_STORE_BAD_LENGTH if the offset is not the next chunk,
+ *         CONFIG_STORE_BAD_STATE if no update is in progress, or CONFIG_STORE_FLASH_ERROR.
+ */
+uint8_t ConfigStore_Write(uint16_t offset, const uint8_t *data);
+
+/**
+ * @brief The ConfigStore_Commit function checks the data of the update and programs the commit word.
+ *
+ * This function must be called from the main loop.
+ *
+ * @param None
+ *
+ * @return CONFIG_STORE_OK, CONFIG_STORE_BAD_STATE if the data is incomplete or no update is in progress,
+ *         CONFIG_STORE_INVALID if the data is not a valid Config_Data, or CONFIG_STORE_FLASH_ERROR.
+ */
+uint8_t ConfigStore_Commit(void);
+
+/**
+ * @brief The ConfigStore_Get_Status function returns the content of the sector.
+ *
+ * @param status A pointer to the structure that receives the status.
+ *
+ * @return None
+ */
+void ConfigStore_Get_Status(ConfigStore_Status *status);
+
+#endif /* CONFIGSTORE_H_ */
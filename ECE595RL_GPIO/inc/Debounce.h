@@ -0,0 +1,93 @@
+/**
+ * @file Debounce.h
+ * @brief Header file for the Debounce driver.
+ *
+ * This file contains the function definitions for debouncing the user buttons (P1.1 and P1.4)
+ * and the PMOD SWT switches (P10.0 - P10.3).
+ *
+ * All six inputs are sampled together by InputSnapshot_Take and filtered in the packed 16-bit format
+ * of the snapshot (see InputSnapshot.h) by a 3-bit vertical counter: bit k of counter plane j holds
+ * bit j of the counter of input k, so one sample updates every counter with a few bitwise operations
+ * and without a loop over the pins. An input changes its stable state only after it differs from that
+ * state for the configured number of samples in a row. The stable state of all inputs is kept in one word,
+ * so the buttons and the switches that it reports always come from the same snapshots.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+
+#include <stdint.h>
+
+// Range of the number of consecutive samples required for a change
+#define DEBOUNCE_MIN_SAMPLES    2
+#define DEBOUNCE_MAX_SAMPLES    8
+
+/**
+ * @brief The Debounce_Init function initializes the debouncing filter.
+ *
+ * The inputs are read once with InputSnapshot_Take and taken as the initial stable state.
+ * The input pins must be configured with GPIO_Pins_Init before this function is called.
+ *
+ * @param samples The number of consecutive samples that an input must differ from its stable state
+ *                before the change is accepted (DEBOUNCE_MIN_SAMPLES to DEBOUNCE_MAX_SAMPLES).
+ *                Values outside of the range are clamped.
+ *
+ * @return None
+ */
+void Debounce_Init(uint8_t samples);
+
+/**
+ * @brief The Debounce_Sample function advances the filter by one sample of all six inputs.
+ *
+ * This function must be called at a constant rate, such as once per tick from the SysTick task,
+ * with the inputs returned by InputSnapshot_Take.
+ *
+ * @param inputs The inputs in the packed format of InputSnapshot_Take. The other bits are ignored.
+ *
+ * @return A bit mask of the inputs whose stable state changed with this sample, in the packed format.
+ */
+uint16_t Debounce_Sample(uint16_t inputs);
+
+/**
+ * @brief The Debounce_Get_Inputs function returns the stable state of all inputs.
+ *
+ * @param None
+ *
+ * @return The stable state in the packed format of InputSnapshot_Take.
+ */
+uint16_t Debounce_Get_Inputs(void);
+
+/**
+ * @brief The Debounce_Get_Buttons_Status function returns the stable state of the user buttons.
+ *
+ * @param None
+ *
+ * @return The stable state in the format returned by Get_Buttons_Status (0x00 - 0x12).
+ */
+uint8_t Debounce_Get_Buttons_Status(void);
+
+/**
+ * @brief The Debounce_Get_Switches_Status function returns the stable state of the PMOD SWT switches.
+ *
+ * @param None
+ *
+ * @return The stable state as the switch status of the PMOD SWT (0x00 - 0x0F, SWT1 - SWT4 in bits 0 - 3).
+ */
+uint8_t Debounce_Get_Switches_Status(void);
+
+/**
+ * @brief The Debounce_Get_Edges function returns and clears the press and release edges recorded since the last call.
+ *
+ * A button is pressed when its pin goes low (negative logic), and a switch is pressed when its pin goes high.
+ * This function briefly disables interrupts, restores the previous PRIMASK, and must be called from the main loop.
+ *
+ * @param pressed   A pointer that receives the mask of the inputs that were pressed, in the packed format.
+ * @param released  A pointer that receives the mask of the inputs that were released, in the packed format.
+ *
+ * @return None
+ */
+void Debounce_Get_Edges(uint16_t *pressed, uint16_t *released);
+
+#endif /* DEBOUNCE_H_ */
@@ -0,0 +1,93 @@
+/**
+ * @file GPIO_Pins.h
+ * @brief Header file for the GPIO_Pins driver.
+ *
+ * This file contains the pin descriptor type and the function definitions for initializing
+ * GPIO pins from a table of descriptors. Each descriptor configures a group of pins of one port
+ * with the same direction, pull resistor, and drive strength. GPIO_Pins_Init merges all descriptors
+ * of the same port, so every configuration register of a port is written once, regardless of the
+ * number of devices that share the port.
+ *
+ * Example: the built-in red LED (P1.0) and the user buttons (P1.1 and P1.4)
+ *
+ *      static const GPIO_Pin Pins[] =
+ *      {
+ *          GPIO_PIN(1, 0x01, GPIO_PINS_OUTPUT, GPIO_PINS_PULL_NONE, GPIO_PINS_DRIVE_REGULAR, 0x00),
+ *          GPIO_PIN(1, 0x12, GPIO_PINS_INPUT,  GPIO_PINS_PULL_UP,   GPIO_PINS_DRIVE_REGULAR, 0x00)
+ *      };
+ *      GPIO_Pins_Init(Pins, GPIO_PINS_COUNT(Pins));
+ *
+ * @note Only ports P1 - P10 are supported. The pins are always configured as GPIO (SEL0 = SEL1 = 0).
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef GPIO_PINS_H_
+#define GPIO_PINS_H_
+
+#include <stdint.h>
+
+// Number of ports supported by GPIO_Pins_Init (P1 - P10)
+#define GPIO_PINS_PORT_COUNT    10
+
+// Pin direction
+#define GPIO_PINS_INPUT         0
+#define GPIO_PINS_OUTPUT        1
+
+// Pull resistor of an input pin
+#define GPIO_PINS_PULL_NONE     0
+#define GPIO_PINS_PULL_UP       1
+#define GPIO_PINS_PULL_DOWN     2
+
+// Drive strength of an output pin
+#define GPIO_PINS_DRIVE_REGULAR 0
+#define GPIO_PINS_DRIVE_HIGH    1
+
+/**
+ * @brief GPIO_Pin describes a group of pins of one port that share the same configuration.
+ *
+ *  - port:         Port number (1 - 10)
+ *  - mask:         Pins of the port (e.g. 0x12 for P1.1 and P1.4)
+ *  - direction:    GPIO_PINS_INPUT or GPIO_PINS_OUTPUT
+ *  - pull:         GPIO_PINS_PULL_NONE, GPIO_PINS_PULL_UP, or GPIO_PINS_PULL_DOWN (inputs only)
+ *  - drive:        GPIO_PINS_DRIVE_REGULAR or GPIO_PINS_DRIVE_HIGH (outputs only)
+ *  - initial:      Initial output value of the pins (outputs only)
+ */
+typedef struct
+{
+    uint8_t port;
+    uint8_t mask;
+    uint8_t direction;
+    uint8_t pull;
+    uint8_t drive;
+    uint8_t initial;
+} GPIO_Pin;
+
+// Initializer of a GPIO_Pin descriptor, usable in constant tables
+#define GPIO_PIN(port, mask, direction, pull, drive, initial) \
+    { (port), (mask), (direction), (pull), (drive), (initial) }
+
+// Number of descriptors in a descriptor table
+#define GPIO_PINS_COUNT(pins)   ((uint32_t)(sizeof(pins) / sizeof(GPIO_Pin)))
+
+// Registers of port 1 - 10. The registers of an even port are located one byte after the
+// registers of the odd port in the same pair, so both can be accessed with the odd port layout.
+#define GPIO_PINS_REGISTERS(port) \
+    ((DIO_PORT_Odd_Type *)((uint8_t *)P1 + ((((port) - 1) >> 1) * 0x20) + (((port) - 1) & 0x01)))
+
+/**
+ * @brief The GPIO_Pins_Init function configures the pins listed in a descriptor table.
+ *
+ * The descriptors are first merged per port. Then, each configuration register of every port that is used
+ * is updated with a single read-modify-write, in the following order: SEL0, SEL1, OUT, REN, DS, and DIR.
+ * The output value and the pull resistors are set before the direction, so an output pin starts at its
+ * initial value without a glitch. Pins that are not listed in the table keep their configuration.
+ *
+ * @param pins  A pointer to the descriptor table.
+ * @param count The number of descriptors in the table.
+ *
+ * @return None
+ */
+void GPIO_Pins_Init(const GPIO_Pin *pins, uint32_t count);
+
+#endif /* GPIO_PINS_H_ */
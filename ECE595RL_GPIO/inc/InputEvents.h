@@ -0,0 +1,109 @@
+/**
+ * @file InputEvents.h
+ * @brief Header file for the InputEvents driver.
+ *
+ * This file contains the function definitions for the interrupt-driven input layer.
+ * Every debounced change of the user buttons (P1.1 and P1.4) and the PMOD SWT switches (P10.0 - P10.3)
+ * is recorded as a timestamped event in a single-producer/single-consumer ring buffer.
+ *
+ * All inputs are sampled together with InputSnapshot_Take and debounced by InputEvents_Poll,
+ * which must be called once per tick.
+ * When the stable state of a source changes, the PORT1 interrupt is pended in software and the event
+ * is recorded by PORT1_IRQHandler. PORT1_IRQHandler is therefore the only producer of the ring buffer.
+ * Port 10 cannot request interrupts on the MSP432P401R (only P1 - P6 have interrupt vectors), and
+ * the edge-triggered PORT1 interrupts of the user buttons only wake the core from the idle modes.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef INPUTEVENTS_H_
+#define INPUTEVENTS_H_
+
+#include <stdint.h>
+
+// Number of events that the ring buffer can hold (must be a power of 2)
+#define INPUT_EVENTS_SIZE       32
+
+// Source of an input event
+#define INPUT_EVENT_BUTTONS     0x01
+#define INPUT_EVENT_SWITCHES    0x02
+
+/**
+ * @brief Input_Event describes one change of the user buttons or the PMOD SWT switches.
+ *
+ * The timestamp is the SysTick tick count plus the number of MCLK cycles elapsed within that tick,
+ * taken when the debounced change was accepted.
+ * The status holds the new state of the source in the same format that is returned by
+ * Get_Buttons_Status (0x00 - 0x12) or the switch status of the PMOD SWT (0x00 - 0x0F).
+ */
+typedef struct
+{
+    uint32_t ticks;
+    uint16_t cycles;
+    uint8_t source;
+    uint8_t status;
+} Input_Event;
+
+/**
+ * @brief The InputEvents_Init function enables the edge-triggered interrupts of the user buttons.
+ *
+ * This function arms the P1.1 and P1.4 interrupts for the edge opposite to the current level,
+ * clears any pending flags, and enables the PORT1 interrupt in the NVIC at the given priority.
+ * GPIO_Pins_Init, Debounce_Init, and SysTickInts_Init must be called before this function.
+ *
+ * @param priority The PORT1 interrupt priority (0 is highest, 7 is lowest). It should be higher
+ *                 (numerically lower) than the SysTick priority to keep the capture latency short.
+ *
+ * @return None
+ */
+void InputEvents_Init(uint32_t priority);
+
+/**
+ * @brief The InputEvents_Poll function samples the user buttons and the PMOD SWT switches.
+ *
+ * This function must be called from the SysTick task once per tick. It takes one input snapshot,
+ * advances the debouncing filter, records a TRACE_EVENT_INPUTS entry when the stable state changes,
+ * and if the stable state of a source differs from the last recorded state, the PORT1 interrupt is pended
+ * so that PORT1_IRQHandler records the event.
+ * A state that was not recorded because the ring buffer was full is therefore retried on the next tick,
+ * so the final state of each source always reaches the consumer once it frees space.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void InputEvents_Poll(void);
+
+/**
+ * @brief The InputEvents_Get function removes the oldest event from the ring buffer.
+ *
+ * This function is the consumer side of the ring buffer and must only be called from one place,
+ * such as the main loop or a single task of the Scheduler driver.
+ *
+ * @param event A pointer to the structure that receives the oldest event.
+ *
+ * @return 1 if an event was removed, 0 if the ring buffer is empty.
+ */
+uint8_t InputEvents_Get(Input_Event *event);
+
+/**
+ * @brief The InputEvents_Available function returns the number of events waiting in the ring buffer.
+ *
+ * @param None
+ *
+ * @return The number of events that can be removed with InputEvents_Get.
+ */
+uint32_t InputEvents_Available(void);
+
+/**
+ * @brief The InputEvents_Get_Overflows function returns the number of events that could not be added because the ring buffer was full.
+ *
+ * Intermediate states can be lost, but the last state of each source is retried on every tick until it is added.
+ *
+ * @param None
+ *
+ * @return The number of failed attempts to add an event since InputEvents_Init was called.
+ */
+uint32_t InputEvents_Get_Overflows(void);
+
+#endif /* INPUTEVENTS_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file InputSnapshot.h
+ * @brief Header file for the InputSnapshot driver.
+ *
+ * This file contains the function definitions for sampling every input of the program at the same moment.
+ * InputSnapshot_Take latches P1->IN and the input PMODs of a PMOD bus (PMOD_Bus_Read) back to back with
+ * the DWT cycle counter (CYCCNT), with interrupts disabled, so the user buttons and the PMOD SWT switches
+ * of one snapshot are never separated by an interrupt handler. Every port with an input PMOD is read once
+ * per snapshot, so a PMOD added to the bus is sampled with the others and read with PMOD_Bus_Get. The inputs are packed into one 16-bit word, which is the format
+ * used by the Debounce driver, the TRACE_EVENT_INPUTS entries, and the pattern selection in main:
+ *
+ *  Bit     15 - 12     11      10      9       8       7 - 5   4       3 - 2   1       0
+ *  Input   0           P10.3   P10.2   P10.1   P10.0   0       P1.4    0       P1.1    0
+ *
+ * The buttons keep their position in P1->IN and the switches are moved to the upper byte, so both
+ * formats returned by Get_Buttons_Status (0x00 - 0x12) and the PMOD SWT device (0x00 - 0x0F) are extracted
+ * with a mask and a shift. Every other bit is 0.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef INPUTSNAPSHOT_H_
+#define INPUTSNAPSHOT_H_
+
+#include <stdint.h>
+#include "../inc/PMOD.h"
+
+// Bits of the packed input word
+#define INPUT_SNAPSHOT_BUTTON_1     0x0002
+#define INPUT_SNAPSHOT_BUTTON_2     0x0010
+#define INPUT_SNAPSHOT_BUTTONS      0x0012
+#define INPUT_SNAPSHOT_SWITCHES     0x0F00
+#define INPUT_SNAPSHOT_ALL          (INPUT_SNAPSHOT_BUTTONS | INPUT_SNAPSHOT_SWITCHES)
+
+// Button status (0x00 - 0x12) and switch status (0x00 - 0x0F) of a packed input word
+#define INPUT_SNAPSHOT_GET_BUTTONS(inputs)      ((uint8_t)((inputs) & INPUT_SNAPSHOT_BUTTONS))
+#define INPUT_SNAPSHOT_GET_SWITCHES(inputs)     ((uint8_t)(((inputs) & INPUT_SNAPSHOT_SWITCHES) >> 8))
+
+/**
+ * @brief Input_Snapshot describes the inputs sampled by one call to InputSnapshot_Take.
+ *
+ *  - cycles:   Value of the DWT cycle counter when the inputs were latched
+ *  - inputs:   The inputs in the packed format
+ */
+typedef struct
+{
+    uint32_t cycles;
+    uint16_t inputs;
+} Input_Snapshot;
+
+/**
+ * @brief The InputSnapshot_Init function selects the PMOD bus that is read by every snapshot.
+ *
+ * The bus must be initialized with PMOD_Bus_Init, and this function must be called before the first snapshot.
+ *
+ * @param bus       A pointer to the bus of the input PMODs.
+ * @param switches  The index of the PMOD SWT in the descriptor table of the bus.
+ *
+ * @return None
+ */
+void InputSnapshot_Init(PMOD_Bus *bus, uint32_t switches);
+
+/**
+ * @brief The InputSnapshot_Take function latches the user buttons and the PMOD SWT switches with a timestamp.
+ *
+ * The cycle counter, P1->IN, and the IN register of every port of the bus with an input PMOD are read
+ * back to back while interrupts are briefly disabled.
+ * This function can be called from the main loop, from interrupt handlers, and with interrupts disabled,
+ * because the previous PRIMASK is restored.
+ * The input pins must be configured with GPIO_Pins_Init, and the cycle counter is only running once
+ * Boot_Init, Profile_Init, or Trace_Init has been called.
+ *
+ * @param snapshot A pointer to the structure that receives the snapshot, or 0 if only the inputs are needed.
+ *
+ * @return The inputs in the packed format.
+ */
+uint16_t InputSnapshot_Take(Input_Snapshot *snapshot);
+
+#endif /* INPUTSNAPSHOT_H_ */
@@ -0,0 +1,89 @@
+/**
+ * @file LED_Output.h
+ * @brief Header file for the write-only LED outputs.
+ *
+ * This file contains the inline functions that write the built-in red LED (P1.0), the RGB LED (P2.0 - P2.2),
+ * and the PMOD 8LD module without reading the output registers back. They are defined in this header so
+ * they are inlined into every caller, and they are used on the paths that run on every tick.
+ *
+ * LED1_Output, LED2_Output, and PMOD_8LD_Output in GPIO_main.c remain the functions that return the status
+ * of the LEDs. They call the functions below and then read the output register, which is one more
+ * peripheral bus transaction, so they should only be used when the status is needed. They are not on the
+ * tick path, so they run from flash and are not copied to SRAM.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef LED_OUTPUT_H_
+#define LED_OUTPUT_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/PMOD.h"
+
+/**
+ * @brief The LED1_Write function sets the output of the built-in red LED.
+ *
+ * The LED pin is written through its bit-band alias with a single store, so only P1.0 is affected.
+ *
+ * @param led_value 0 turns off the LED. Otherwise, bit 0 of led_value is written to the LED.
+ *
+ * @return None
+ */
+static inline void LED1_Write(uint8_t led_value)
+{
+    BITBAND_PERI(P1->OUT, 0) = led_value;
+}
+
+/**
+ * @brief The LED2_Write function sets the output of the RGB LED.
+ *
+ * Each color pin is written through its bit-band alias, so the other pins of Port 2 are preserved.
+ *
+ * @param led_value The color of the RGB LED (0x00 - 0x07). Bit 0 is red, bit 1 is green, and bit 2 is blue.
+ *
+ * @return None
+ */
+static inline void LED2_Write(uint8_t led_value)
+{
+    BITBAND_PERI(P2->OUT, 0) = led_value;
+    BITBAND_PERI(P2->OUT, 1) = led_value >> 1;
+    BITBAND_PERI(P2->OUT, 2) = led_value >> 2;
+}
+
+/**
+ * @brief The LED2_Write_Color function turns one color of the RGB LED on or off.
+ *
+ * The write is one store, so it is safe to call from an interrupt handler while the main loop writes the other colors.
+ *
+ * @param color_bit The bit number of the color: 0 (red, P2.0), 1 (green, P2.1), or 2 (blue, P2.2).
+ * @param led_value 0 turns the color off. Otherwise, the color is turned on.
+ *
+ * @return None
+ */
+static inline void LED2_Write_Color(uint8_t color_bit, uint8_t led_value)
+{
+    if (color_bit <= 2)
+    {
+        BITBAND_PERI(P2->OUT, color_bit) = (led_value != 0);
+    }
+}
+
+/**
+ * @brief The PMOD_8LD_Write function sets the output of the eight LEDs on the PMOD 8LD module.
+ *
+ * The value is written with PMOD_Bus_Write, so the other output PMODs of the bus that were set are written at the same time.
+ *
+ * @param bus       A pointer to the bus that drives the PMOD 8LD module.
+ * @param device    The index of the PMOD 8LD module in the device table of the bus.
+ * @param led_value The value displayed on the LEDs. Bit 0 is LED0 and bit 7 is LED7.
+ *
+ * @return None
+ */
+static inline void PMOD_8LD_Write(PMOD_Bus *bus, uint32_t device, uint8_t led_value)
+{
+    PMOD_Bus_Set(bus, device, led_value);
+    PMOD_Bus_Write(bus);
+}
+
+#endif /* LED_OUTPUT_H_ */
@@ -0,0 +1,130 @@
+/**
+ * @file LED_Step.h
+ * @brief Header file for the packed LED step format.
+ *
+ * This file contains the macros that encode and decode the steps of the LED patterns.
+ * A step holds the state of every LED and the time it is displayed, packed into one 32-bit word,
+ * so a step table is a constant array that is stored in flash (MAIN) and the pattern engine decodes
+ * any step with the same few shifts and masks:
+ *
+ *  Bits    31 - 16         15 - 8          7 - 4   3 - 1       0
+ *  Field   duration_ms     PMOD 8LD        0       RGB LED     LED1
+ *
+ * A duration of 0 holds the step until a different pattern is selected.
+ *
+ * Step tables are written with LED_STEP, or generated at compile time with LED_STEPS_256 or LED_STEPS_N and
+ * a generator macro that computes a step from its index. For example, a counter from 0x10 up to 0x40 by 3,
+ * with 100 ms per count, has LED_COUNTER_LENGTH(0x10, 0x40, 3) = 17 steps (16 * 1 + 1):
+ *
+ *      static const LED_Step Counter_Steps[LED_COUNTER_LENGTH(0x10, 0x40, 3)] =
+ *      {
+ *          LED_STEPS_N(1, 1, LED_STEP_COUNTER, RED_LED_ON, RGB_LED_RED, 0x10, 0x40, 3, 100)
+ *      };
+ *
+ * The same generators fill the byte tables streamed by the DMA controller, for example
+ * LED_STEPS_N(1, 1, LED_STEP_COUNTER_VALUE, 0x10, 0x40, 3) for the PMOD 8LD values of the counter above.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef LED_STEP_H_
+#define LED_STEP_H_
+
+#include <stdint.h>
+
+/**
+ * @brief LED_Step describes the state of all LEDs for one step of a pattern, in the packed format.
+ */
+typedef uint32_t LED_Step;
+
+// Encodes one step. The result is a constant expression when the arguments are constants.
+#define LED_STEP(led1_value, rgb_value, pmod_8ld_value, duration_ms) \
+    ((LED_Step)(((uint32_t)(led1_value) & 0x01) | (((uint32_t)(rgb_value) & 0x07) << 1) | \
+                (((uint32_t)(pmod_8ld_value) & 0xFF) << 8) | (((uint32_t)(duration_ms) & 0xFFFF) << 16)))
+
+// Fields of a step
+#define LED_STEP_LED1(step)             ((uint8_t)((step) & 0x01))
+#define LED_STEP_RGB(step)              ((uint8_t)(((step) >> 1) & 0x07))
+#define LED_STEP_PMOD_8LD(step)         ((uint8_t)((step) >> 8))
+#define LED_STEP_DURATION_MS(step)      ((uint16_t)((step) >> 16))
+
+// Expands generator(index, ...) for 16 or 256 consecutive indexes, separated by commas
+#define LED_STEPS_16(generator, base, ...) \
+    generator((base) + 0x0, __VA_ARGS__), generator((base) + 0x1, __VA_ARGS__), \
+    generator((base) + 0x2, __VA_ARGS__), generator((base) + 0x3, __VA_ARGS__), \
+    generator((base) + 0x4, __VA_ARGS__), generator((base) + 0x5, __VA_ARGS__), \
+    generator((base) + 0x6, __VA_ARGS__), generator((base) + 0x7, __VA_ARGS__), \
+    generator((base) + 0x8, __VA_ARGS__), generator((base) + 0x9, __VA_ARGS__), \
+    generator((base) + 0xA, __VA_ARGS__), generator((base) + 0xB, __VA_ARGS__), \
+    generator((base) + 0xC, __VA_ARGS__), generator((base) + 0xD, __VA_ARGS__), \
+    generator((base) + 0xE, __VA_ARGS__), generator((base) + 0xF, __VA_ARGS__)
+#define LED_STEPS_256(generator, ...) \
+    LED_STEPS_16(generator, 0x00, __VA_ARGS__), LED_STEPS_16(generator, 0x10, __VA_ARGS__), \
+    LED_STEPS_16(generator, 0x20, __VA_ARGS__), LED_STEPS_16(generator, 0x30, __VA_ARGS__), \
+    LED_STEPS_16(generator, 0x40, __VA_ARGS__), LED_STEPS_16(generator, 0x50, __VA_ARGS__), \
+    LED_STEPS_16(generator, 0x60, __VA_ARGS__), LED_STEPS_16(generator, 0x70, __VA_ARGS__), \
+    LED_STEPS_16(generator, 0x80, __VA_ARGS__), LED_STEPS_16(generator, 0x90, __VA_ARGS__), \
+    LED_STEPS_16(generator, 0xA0, __VA_ARGS__), LED_STEPS_16(generator, 0xB0, __VA_ARGS__), \
+    LED_STEPS_16(generator, 0xC0, __VA_ARGS__), LED_STEPS_16(generator, 0xD0, __VA_ARGS__), \
+    LED_STEPS_16(generator, 0xE0, __VA_ARGS__), LED_STEPS_16(generator, 0xF0, __VA_ARGS__)
+
+// Expands generator(index, ...) for the indexes 0 to (16 * blocks + rest - 1), each followed by a comma.
+// The preprocessor cannot evaluate an expression, so blocks (0 - 16) and rest (0 - 15) must be decimal literals,
+// or macros that expand to them. A table sized by its length gets a diagnostic if they give too many steps.
+#define LED_STEPS_N(blocks, rest, generator, ...) \
+    LED_STEPS_N_EXPAND(blocks, rest, generator, __VA_ARGS__)
+#define LED_STEPS_N_EXPAND(blocks, rest, generator, ...) \
+    LED_STEPS_BLOCKS_##blocks(generator, __VA_ARGS__) LED_STEPS_REST_##rest(generator, (blocks) * 16, __VA_ARGS__)
+
+#define LED_STEPS_BLOCKS_0(generator, ...)
+#define LED_STEPS_BLOCKS_1(generator, ...)  LED_STEPS_BLOCKS_0(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x00, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_2(generator, ...)  LED_STEPS_BLOCKS_1(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x10, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_3(generator, ...)  LED_STEPS_BLOCKS_2(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x20, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_4(generator, ...)  LED_STEPS_BLOCKS_3(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x30, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_5(generator, ...)  LED_STEPS_BLOCKS_4(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x40, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_6(generator, ...)  LED_STEPS_BLOCKS_5(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x50, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_7(generator, ...)  LED_STEPS_BLOCKS_6(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x60, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_8(generator, ...)  LED_STEPS_BLOCKS_7(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x70, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_9(generator, ...)  LED_STEPS_BLOCKS_8(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x80, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_10(generator, ...) LED_STEPS_BLOCKS_9(generator, __VA_ARGS__) LED_STEPS_16(generator, 0x90, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_11(generator, ...) LED_STEPS_BLOCKS_10(generator, __VA_ARGS__) LED_STEPS_16(generator, 0xA0, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_12(generator, ...) LED_STEPS_BLOCKS_11(generator, __VA_ARGS__) LED_STEPS_16(generator, 0xB0, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_13(generator, ...) LED_STEPS_BLOCKS_12(generator, __VA_ARGS__) LED_STEPS_16(generator, 0xC0, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_14(generator, ...) LED_STEPS_BLOCKS_13(generator, __VA_ARGS__) LED_STEPS_16(generator, 0xD0, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_15(generator, ...) LED_STEPS_BLOCKS_14(generator, __VA_ARGS__) LED_STEPS_16(generator, 0xE0, __VA_ARGS__),
+#define LED_STEPS_BLOCKS_16(generator, ...) LED_STEPS_BLOCKS_15(generator, __VA_ARGS__) LED_STEPS_16(generator, 0xF0, __VA_ARGS__),
+
+#define LED_STEPS_REST_0(generator, base, ...)
+#define LED_STEPS_REST_1(generator, base, ...)  LED_STEPS_REST_0(generator, base, __VA_ARGS__) generator((base) + 0x0, __VA_ARGS__),
+#define LED_STEPS_REST_2(generator, base, ...)  LED_STEPS_REST_1(generator, base, __VA_ARGS__) generator((base) + 0x1, __VA_ARGS__),
+#define LED_STEPS_REST_3(generator, base, ...)  LED_STEPS_REST_2(generator, base, __VA_ARGS__) generator((base) + 0x2, __VA_ARGS__),
+#define LED_STEPS_REST_4(generator, base, ...)  LED_STEPS_REST_3(generator, base, __VA_ARGS__) generator((base) + 0x3, __VA_ARGS__),
+#define LED_STEPS_REST_5(generator, base, ...)  LED_STEPS_REST_4(generator, base, __VA_ARGS__) generator((base) + 0x4, __VA_ARGS__),
+#define LED_STEPS_REST_6(generator, base, ...)  LED_STEPS_REST_5(generator, base, __VA_ARGS__) generator((base) + 0x5, __VA_ARGS__),
+#define LED_STEPS_REST_7(generator, base, ...)  LED_STEPS_REST_6(generator, base, __VA_ARGS__) generator((base) + 0x6, __VA_ARGS__),
+#define LED_STEPS_REST_8(generator, base, ...)  LED_STEPS_REST_7(generator, base, __VA_ARGS__) generator((base) + 0x7, __VA_ARGS__),
+#define LED_STEPS_REST_9(generator, base, ...)  LED_STEPS_REST_8(generator, base, __VA_ARGS__) generator((base) + 0x8, __VA_ARGS__),
+#define LED_STEPS_REST_10(generator, base, ...) LED_STEPS_REST_9(generator, base, __VA_ARGS__) generator((base) + 0x9, __VA_ARGS__),
+#define LED_STEPS_REST_11(generator, base, ...) LED_STEPS_REST_10(generator, base, __VA_ARGS__) generator((base) + 0xA, __VA_ARGS__),
+#define LED_STEPS_REST_12(generator, base, ...) LED_STEPS_REST_11(generator, base, __VA_ARGS__) generator((base) + 0xB, __VA_ARGS__),
+#define LED_STEPS_REST_13(generator, base, ...) LED_STEPS_REST_12(generator, base, __VA_ARGS__) generator((base) + 0xC, __VA_ARGS__),
+#define LED_STEPS_REST_14(generator, base, ...) LED_STEPS_REST_13(generator, base, __VA_ARGS__) generator((base) + 0xD, __VA_ARGS__),
+#define LED_STEPS_REST_15(generator, base, ...) LED_STEPS_REST_14(generator, base, __VA_ARGS__) generator((base) + 0xE, __VA_ARGS__),
+
+/**
+ * @brief LED_COUNTER_LENGTH computes the number of steps of a bounded counter.
+ *
+ * The counter visits start, start +/- step, ... and stops at the last value that does not pass end.
+ * The direction is up if end >= start, and down otherwise. The step must be at least 1.
+ * The result is a constant expression that sizes the step table, and it can also be tested with #if.
+ */
+#define LED_COUNTER_LENGTH(start, end, step) \
+    (((((end) >= (start)) ? ((end) - (start)) : ((start) - (end))) / (step)) + 1)
+
+// Generators of a bounded counter on the PMOD 8LD module, for the indexes 0 to LED_COUNTER_LENGTH(start, end, step) - 1
+#define LED_STEP_COUNTER_VALUE(index, start, end, step) \
+    ((uint8_t)((((end) >= (start)) ? ((start) + ((index) * (step))) : ((start) - ((index) * (step)))) & 0xFF))
+#define LED_STEP_COUNTER(index, led1_value, rgb_value, start, end, step, duration_ms) \
+    LED_STEP((led1_value), (rgb_value), LED_STEP_COUNTER_VALUE((index), (start), (end), (step)), (duration_ms))
+
+#endif /* LED_STEP_H_ */
@@ -0,0 +1,78 @@
+/**
+ * @file LowPower.h
+ * @brief Header file for the LowPower driver.
+ *
+ * This file contains the function definitions for the low-power idle modes used between pattern steps.
+ *
+ *  Mode    Core        Clocks running              Wake-up sources used by this program
+ *  ----    ----        --------------              ------------------------------------
+ *  LPM0    Sleeping    MCLK, HSMCLK, SMCLK, ACLK   SysTick tick, PORT1 (buttons)
+ *  LPM3    Off         ACLK, BCLK (REFOCLK)        RTC_C prescaler (inputs), PORT1 (buttons)
+ *
+ * SysTick stops in LPM3, so LPM3 can only be used while the active step is held (duration of 0).
+ * During LPM3, the RTC_C prescaler interrupt samples the inputs every 7.8 ms instead of every tick.
+ *
+ * The figures in LowPower_Modes are typical values for the MSP432P401R with the LDO regulator
+ * at VCORE1 and MCLK = 48 MHz from HFXT (MSP432P401R datasheet, SLAS826). They are intended for
+ * choosing a trade-off per deployment and must be confirmed with a measurement on the target board.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef LOWPOWER_H_
+#define LOWPOWER_H_
+
+#include <stdint.h>
+
+// Idle modes
+#define LOW_POWER_ACTIVE        0
+#define LOW_POWER_LPM0          1
+#define LOW_POWER_LPM3          2
+
+/**
+ * @brief LowPower_Mode_Info describes the cost of using an idle mode.
+ *
+ *  - current_ua:       Typical supply current while idle in the mode, in microamperes
+ *  - wake_latency_us:  Typical time from the wake-up event to the first instruction of the handler, in microseconds
+ */
+typedef struct
+{
+    uint32_t current_ua;
+    uint32_t wake_latency_us;
+} LowPower_Mode_Info;
+
+/**
+ * @brief Typical current and wake-up latency of each idle mode, indexed by LOW_POWER_ACTIVE, LOW_POWER_LPM0, and LOW_POWER_LPM3.
+ *
+ * LOW_POWER_ACTIVE is the busy-wait loop used without a low-power mode.
+ * The LPM3 wake-up latency includes the restart of the 48 MHz HFXT crystal, which dominates the total.
+ */
+extern const LowPower_Mode_Info LowPower_Modes[3];
+
+/**
+ * @brief The LowPower_Init function prepares the wake-up source used in LPM3.
+ *
+ * This function sources BCLK from REFOCLK (32.768 kHz) and starts the RTC_C prescaler RT0PS,
+ * whose interrupt wakes the core from LPM3 every 7.8 ms to sample the inputs.
+ * The prescaler interrupt is only enabled while the core is in LPM3.
+ *
+ * @param priority The RTC_C interrupt priority (0 is highest, 7 is lowest).
+ *
+ * @return None
+ */
+void LowPower_Init(uint32_t priority);
+
+/**
+ * @brief The LowPower_Sleep function puts the core in the requested idle mode until the next interrupt.
+ *
+ * This function must be called with interrupts disabled (PRIMASK set) after checking that there is no pending work.
+ * A pending interrupt still wakes the core, and it is serviced once interrupts are enabled again by the caller.
+ * This avoids losing a wake-up that occurs between the check and the sleep instruction.
+ *
+ * @param mode LOW_POWER_ACTIVE (returns immediately), LOW_POWER_LPM0, or LOW_POWER_LPM3.
+ *
+ * @return None
+ */
+void LowPower_Sleep(uint8_t mode);
+
+#endif /* LOWPOWER_H_ */
@@ -0,0 +1,104 @@
+/**
+ * @file Microbench.h
+ * @brief Header file for the Microbench driver.
+ *
+ * This file contains the function definitions for measuring the cost of the register-access primitives used
+ * by Clock.c and GPIO_main.c with the DWT cycle counter (CYCCNT). It is compiled in the Microbench build configuration,
+ * which defines MICROBENCH_ENABLE. In the other configurations, the functions are empty.
+ *
+ * Microbench_Run measures every primitive at every configuration of Microbench_Configs, which covers each
+ * clock profile of Clock_SetProfile with its minimum number of flash wait states and with one more:
+ *
+ *  Operation                       Primitive
+ *  ---------                       ---------
+ *  MICROBENCH_OP_BYTE_WRITE        P2->OUT = value, executed from flash
+ *  MICROBENCH_OP_BITBAND_WRITE     BITBAND_PERI(P2->OUT, 0) = value (LED2_Write, LED1_Write)
+ *  MICROBENCH_OP_RMW               P2->OUT = (P2->OUT & ~0x07) | value (read-modify-write of the RGB LED pins)
+ *  MICROBENCH_OP_IN_READ           value = P1->IN
+ *  MICROBENCH_OP_BYTE_WRITE_SRAM   P2->OUT = value, executed from SRAM (RAMFUNC)
+ *
+ * Each operation is timed in a loop that repeats it MICROBENCH_UNROLL times per iteration and in a loop that
+ * repeats it twice as often, and the difference is divided by the number of extra operations, so the loop
+ * overhead cancels out. The cost is given in hundredths of an MCLK cycle per operation.
+ * MICROBENCH_OP_BYTE_WRITE and MICROBENCH_OP_BYTE_WRITE_SRAM differ only in where the code is fetched from.
+ *
+ * The accuracy of Clock_Delay1us is measured for 1, 10, 100, and 1000 us, as the number of MCLK cycles
+ * of the call minus the number of cycles of the requested delay. The call overhead is included.
+ *
+ * The results can be viewed in Microbench_Results from the debugger or read with TELEMETRY_CMD_GET_MICROBENCH.
+ *
+ * @note P2->OUT is restored after every measurement, so the RGB LED only flickers while Microbench_Run runs.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef MICROBENCH_H_
+#define MICROBENCH_H_
+
+#include <stdint.h>
+
+// Measured operations
+#define MICROBENCH_OP_BYTE_WRITE        0
+#define MICROBENCH_OP_BITBAND_WRITE     1
+#define MICROBENCH_OP_RMW               2
+#define MICROBENCH_OP_IN_READ           3
+#define MICROBENCH_OP_BYTE_WRITE_SRAM   4
+#define MICROBENCH_OP_COUNT             5
+
+// Number of measured Clock_Delay1us durations (1, 10, 100, and 1000 us)
+#define MICROBENCH_DELAY_COUNT          4
+
+// Number of clock profile and wait state configurations
+#define MICROBENCH_CONFIG_COUNT         8
+
+// Operations per loop iteration and loop iterations of the shorter loop
+#define MICROBENCH_UNROLL               8
+#define MICROBENCH_ITERATIONS           128
+
+/**
+ * @brief Microbench_Result holds the measurements of one configuration.
+ *
+ *  - frequency:        MCLK frequency in Hz
+ *  - wait_states:      Number of flash read wait states of both banks
+ *  - op_cycles:        Cost of every operation in 1/100 MCLK cycle (indexed by MICROBENCH_OP_)
+ *  - delay_error:      Measured minus requested MCLK cycles of Clock_Delay1us(1), (10), (100), and (1000)
+ */
+typedef struct
+{
+    uint32_t frequency;
+    uint8_t wait_states;
+    uint16_t op_cycles[MICROBENCH_OP_COUNT];
+    int32_t delay_error[MICROBENCH_DELAY_COUNT];
+} Microbench_Result;
+
+#ifdef MICROBENCH_ENABLE
+
+// Measurements of every configuration, valid once Microbench_Run has returned 1
+extern Microbench_Result Microbench_Results[MICROBENCH_CONFIG_COUNT];
+
+#endif /* MICROBENCH_ENABLE */
+
+/**
+ * @brief The Microbench_Run function measures every operation at every configuration.
+ *
+ * This function waits for the switch to 48 MHz to complete, so it must be called with interrupts enabled,
+ * before the watchdog timer is started. The measurements run with interrupts disabled, and the MCLK frequency
+ * and the wait states found on entry are restored afterwards. It does nothing if MICROBENCH_ENABLE is not defined.
+ *
+ * @param None
+ *
+ * @return 1 if the measurements were made, 0 if MCLK is not sourced from the 48 MHz crystal or MICROBENCH_ENABLE is not defined.
+ */
+uint8_t Microbench_Run(void);
+
+/**
+ * @brief The Microbench_Get_Result function copies the measurements of a configuration.
+ *
+ * @param index     The index of the configuration (0 to MICROBENCH_CONFIG_COUNT - 1).
+ * @param result    A pointer to the structure that receives the measurements.
+ *
+ * @return 1 if the configuration has been measured, 0 otherwise.
+ */
+uint8_t Microbench_Get_Result(uint32_t index, Microbench_Result *result);
+
+#endif /* MICROBENCH_H_ */
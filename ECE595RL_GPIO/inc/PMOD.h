@@ -0,0 +1,190 @@
+/**
+ * @file PMOD.h
+ * @brief Header file for the PMOD driver.
+ *
+ * This file contains the device descriptor type and the function definitions for reading and writing
+ * a group of PMOD modules as one bus. Each PMOD binds a full 8-bit port or one nibble of a port
+ * (pins 0 - 3 or pins 4 - 7) to an input or an output role. PMOD_Bus_Init groups the devices per port,
+ * so the values of all devices are exchanged with one register access per port:
+ *
+ *  - PMOD_Bus_Set and PMOD_Bus_Get only access the values stored in the bus.
+ *  - PMOD_Bus_Write writes the OUT register once for every port with an output value that was set.
+ *  - PMOD_Bus_Read reads the IN register once for every port with an input device.
+ *
+ * A new PMOD is added by appending its descriptor to the device table, without any device specific code.
+ * The cost of PMOD_Bus_Write and PMOD_Bus_Read grows with the number of ports, not with the number of devices,
+ * so two nibble-wide PMODs on the same port cost one access.
+ *
+ * Example: a PMOD 8LD on P9, and a PMOD SWT and a 4-LED PMOD sharing P10
+ *
+ *      static const PMOD_Device Devices[] =
+ *      {
+ *          PMOD_DEVICE_8(9, PMOD_OUTPUT),                          // Index 0
+ *          PMOD_DEVICE_NIBBLE(10, PMOD_NIBBLE_LOW, PMOD_INPUT),    // Index 1
+ *          PMOD_DEVICE_NIBBLE(10, PMOD_NIBBLE_HIGH, PMOD_OUTPUT)   // Index 2
+ *      };
+ *      static PMOD_Bus Bus;
+ *
+ *      PMOD_Bus_Init(&Bus, Devices, PMOD_DEVICE_COUNT(Devices));
+ *      PMOD_Bus_Set(&Bus, 0, 0xAA);
+ *      PMOD_Bus_Set(&Bus, 2, 0x05);
+ *      PMOD_Bus_Write(&Bus);                                       // One write of P9->OUT and P10->OUT
+ *      PMOD_Bus_Read(&Bus);                                        // One read of P10->IN
+ *      uint8_t switches = PMOD_Bus_Get(&Bus, 1);
+ *
+ * @note The pins are configured with GPIO_Pins_Init, which must be called before PMOD_Bus_Init.
+ * A port whose pins are not all owned by output devices is written with a read-modify-write, so its
+ * other pins must not be written by an interrupt handler that can preempt PMOD_Bus_Write.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef PMOD_H_
+#define PMOD_H_
+
+#include <stdint.h>
+#include "msp.h"
+#include "../inc/GPIO_Pins.h"
+
+// Maximum number of devices and ports of a bus
+#define PMOD_MAX_DEVICES        8
+#define PMOD_MAX_PORTS          8
+
+// Role of a device
+#define PMOD_INPUT              GPIO_PINS_INPUT
+#define PMOD_OUTPUT             GPIO_PINS_OUTPUT
+
+// Nibble of a nibble-wide device
+#define PMOD_NIBBLE_LOW         0
+#define PMOD_NIBBLE_HIGH        1
+
+/**
+ * @brief PMOD_Device describes the pins of one PMOD module.
+ *
+ *  - port:         Port number (1 - 10)
+ *  - shift:        Position of the first pin of the device (0 or 4)
+ *  - mask:         Width of the device value (0xFF for 8 pins, 0x0F for a nibble)
+ *  - role:         PMOD_INPUT or PMOD_OUTPUT
+ */
+typedef struct
+{
+    uint8_t port;
+    uint8_t shift;
+    uint8_t mask;
+    uint8_t role;
+} PMOD_Device;
+
+// Initializers of a PMOD_Device descriptor, usable in constant tables
+#define PMOD_DEVICE_8(port, role) \
+    { (port), 0, 0xFF, (role) }
+#define PMOD_DEVICE_NIBBLE(port, nibble, role) \
+    { (port), ((nibble) ? 4 : 0), 0x0F, (role) }
+
+// Number of descriptors in a descriptor table
+#define PMOD_DEVICE_COUNT(devices)  ((uint32_t)(sizeof(devices) / sizeof(PMOD_Device)))
+
+/**
+ * @brief PMOD_Bus holds the per-port plan of a device table and the values of its devices.
+ *
+ * The fields are filled by PMOD_Bus_Init and must not be changed directly.
+ *
+ *  - port_count:       Number of ports used by the devices
+ *  - dirty:            Port slots with an output value that was set but not written yet (bit n = slot n)
+ *  - inputs:           Port slots with at least one input device (bit n = slot n)
+ *  - registers:        Registers of every port slot
+ *  - output_mask:      Pins of every port slot that are owned by output devices
+ *  - output_value:     Output value of every port slot, written by the next PMOD_Bus_Write
+ *  - input_value:      IN register of every port slot, read by the last PMOD_Bus_Read
+ *  - device_slot:      Port slot of every device
+ *  - device_shift:     Position of the first pin of every device
+ *  - device_mask:      Pins of every device, shifted to their position in the port
+ */
+typedef struct
+{
+    uint8_t port_count;
+    uint8_t dirty;
+    uint8_t inputs;
+    DIO_PORT_Odd_Type *registers[PMOD_MAX_PORTS];
+    uint8_t output_mask[PMOD_MAX_PORTS];
+    uint8_t output_value[PMOD_MAX_PORTS];
+    uint8_t input_value[PMOD_MAX_PORTS];
+    uint8_t device_slot[PMOD_MAX_DEVICES];
+    uint8_t device_shift[PMOD_MAX_DEVICES];
+    uint8_t device_mask[PMOD_MAX_DEVICES];
+} PMOD_Bus;
+
+/**
+ * @brief The PMOD_Bus_Init function groups the devices of a descriptor table per port.
+ *
+ * The output values start at the current value of the OUT registers, so the first PMOD_Bus_Write
+ * does not change the outputs that have not been set. The input values start at 0 until the first PMOD_Bus_Read.
+ * The device index used by the other functions is the index of the descriptor in the table.
+ *
+ * @param bus       A pointer to the bus to initialize.
+ * @param devices   A pointer to the descriptor table.
+ * @param count     The number of descriptors in the table (at most PMOD_MAX_DEVICES).
+ *
+ * @return 1 if the bus is initialized, or 0 if the table has too many devices or ports,
+ *         a device with an invalid port, or two devices that share a pin. The bus is then empty.
+ */
+uint8_t PMOD_Bus_Init(PMOD_Bus *bus, const PMOD_Device *devices, uint32_t count);
+
+/**
+ * @brief The PMOD_Bus_Write function writes the output values that were set since the last write.
+ *
+ * The OUT register of every port with a device that was set is written once. A port whose pins are all owned
+ * by output devices is written with a single store, and any other port with a read-modify-write.
+ *
+ * @param bus A pointer to the bus.
+ *
+ * @return None
+ */
+void PMOD_Bus_Write(PMOD_Bus *bus);
+
+/**
+ * @brief The PMOD_Bus_Read function reads the inputs of every input device.
+ *
+ * The IN register of every port with an input device is read once, back to back, and the values
+ * are returned by PMOD_Bus_Get until the next read.
+ *
+ * @param bus A pointer to the bus.
+ *
+ * @return None
+ */
+void PMOD_Bus_Read(PMOD_Bus *bus);
+
+/**
+ * @brief The PMOD_Bus_Set function sets the output value of a device, written by the next PMOD_Bus_Write.
+ *
+ * The port is written even if the value is unchanged, so the pins are restored after another writer,
+ * such as the DMA controller, has driven them.
+ *
+ * @param bus       A pointer to the bus.
+ * @param device    The index of an output device in the descriptor table.
+ * @param value     The output value. Only the lower 4 bits are used for a nibble-wide device.
+ *
+ * @return None
+ */
+static inline void PMOD_Bus_Set(PMOD_Bus *bus, uint32_t device, uint8_t value)
+{
+    uint8_t slot = bus->device_slot[device];
+    uint8_t mask = bus->device_mask[device];
+    bus->output_value[slot] = (bus->output_value[slot] & ~mask) | ((uint8_t)(value << bus->device_shift[device]) & mask);
+    bus->dirty = bus->dirty | (1 << slot);
+}
+
+/**
+ * @brief The PMOD_Bus_Get function returns the value of a device read by the last PMOD_Bus_Read.
+ *
+ * @param bus       A pointer to the bus.
+ * @param device    The index of an input device in the descriptor table.
+ *
+ * @return The input value of the device, right-aligned.
+ */
+static inline uint8_t PMOD_Bus_Get(const PMOD_Bus *bus, uint32_t device)
+{
+    uint8_t value = bus->input_value[bus->device_slot[device]] & bus->device_mask[device];
+    return value >> bus->device_shift[device];
+}
+
+#endif /* PMOD_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file PMOD_8LD_BCM.h
+ * @brief Header file for the PMOD_8LD_BCM driver.
+ *
+ * This file contains the function definitions for controlling the brightness of each LED on the
+ * PMOD 8LD module (P9.0 - P9.7) with binary code modulation (BCM).
+ *
+ * The 8-bit brightness of the eight LEDs is split into eight bit planes. Bit plane k holds bit k of every
+ * brightness value, packed as a P9 value, and is displayed for 2^k time units. A frame of 255 units therefore
+ * lights each LED for (brightness / 255) of the time. Timer_A2 counts SMCLK (12 MHz after Clock_Init48MHz)
+ * in up mode, and its CCR0 interrupt runs once per bit plane: it writes the precomputed plane to P9->OUT
+ * and loads the duration of that plane.
+ *
+ *  Time unit       48 SMCLK cycles (4 us)
+ *  Frame           255 units (1.02 ms), about 980 Hz refresh
+ *  Interrupts      8 per frame, about 7840 per second
+ *
+ * At about 40 MCLK cycles per interrupt including entry and exit, the engine uses under 1% of the CPU at 48 MHz.
+ *
+ * GPIO_main.c displays LED_Pattern_6 with the engine when LED_PMOD_8LD_BCM is 1.
+ *
+ * @note Only one driver may write P9 at a time. PMOD_8LD_Output, PMOD_Bus_Write, and PMOD_8LD_DMA must not write P9 while
+ * the engine runs. LED_Select_Pattern stops the writer of the previous pattern before it starts the engine, and the frames
+ * drawn for a brightness pattern do not own the PMOD 8LD module, so LED_Frame_Commit does not set it on the PMOD bus.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef PMOD_8LD_BCM_H_
+#define PMOD_8LD_BCM_H_
+
+#include <stdint.h>
+
+// Duration of the shortest bit plane in SMCLK cycles
+#define PMOD_8LD_BCM_UNIT       48
+
+/**
+ * @brief The PMOD_8LD_BCM_Init function initializes Timer_A2 for the BCM engine with all LEDs off.
+ *
+ * The PMOD 8LD pins must be configured as outputs with GPIO_Pins_Init before the engine is started.
+ *
+ * @param priority The TA2_0 interrupt priority (0 is highest, 7 is lowest). A high priority keeps the
+ *                 duration of the short bit planes accurate.
+ *
+ * @return None
+ */
+void PMOD_8LD_BCM_Init(uint32_t priority);
+
+/**
+ * @brief The PMOD_8LD_BCM_Set function sets the brightness of the eight LEDs.
+ *
+ * The bit planes are computed into a back buffer, which replaces the displayed planes at the start of
+ * the next frame, so a frame never mixes old and new brightness values.
+ *
+ * @param brightness An array of 8 brightness values (0 is off, 255 is fully on). Element n controls LEDn (P9.n).
+ *
+ * @return None
+ */
+void PMOD_8LD_BCM_Set(const uint8_t brightness[8]);
+
+/**
+ * @brief The PMOD_8LD_BCM_Start function starts displaying the bit planes on the PMOD 8LD module.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_8LD_BCM_Start(void);
+
+/**
+ * @brief The PMOD_8LD_BCM_Stop function stops the BCM engine and turns all LEDs off.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_8LD_BCM_Stop(void);
+
+#endif /* PMOD_8LD_BCM_H_ */
@@ -0,0 +1,72 @@
+/**
+ * @file PMOD_8LD_DMA.h
+ * @brief Header file for the PMOD_8LD_DMA driver.
+ *
+ * This file contains the function definitions for streaming a frame buffer to the PMOD 8LD module (P9.0 - P9.7).
+ * Timer_A1 counts ACLK (REFOCLK, 32.768 kHz) in up mode, and every CCR0 event triggers DMA channel 2,
+ * which copies the next frame from the buffer to P9->OUT. The CPU is not involved while a frame buffer
+ * is playing, except for one DMA_INT1 interrupt at the end of each pass when the animation repeats.
+ *
+ * @note The DMA controller needs the system clocks, so the core may sleep in LPM0 but not in LPM3 during streaming.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef PMOD_8LD_DMA_H_
+#define PMOD_8LD_DMA_H_
+
+#include <stdint.h>
+
+// Maximum number of frames in one pass (limit of a single DMA cycle)
+#define PMOD_8LD_DMA_MAX_FRAMES     1024
+
+/**
+ * @brief The PMOD_8LD_DMA_Init function initializes the DMA controller and Timer_A1 for frame streaming.
+ *
+ * This function enables the DMA controller, sets the address of its control table, assigns the
+ * Timer_A1 CCR0 trigger to DMA channel 2, and routes the channel 2 completion interrupt to DMA_INT1.
+ * The PMOD 8LD pins must be configured as outputs with GPIO_Pins_Init before the first frame buffer is started.
+ *
+ * @param priority The DMA_INT1 interrupt priority (0 is highest, 7 is lowest).
+ *
+ * @return None
+ */
+void PMOD_8LD_DMA_Init(uint32_t priority);
+
+/**
+ * @brief The PMOD_8LD_DMA_Start function starts playing a frame buffer on the PMOD 8LD module.
+ *
+ * The first frame is written to P9->OUT immediately, and the following frames are copied by the DMA
+ * controller every period_ms milliseconds. A frame buffer that is already playing is stopped first.
+ * The frame buffer must remain valid until PMOD_8LD_DMA_Stop is called.
+ *
+ * @param frames        A pointer to the P9 values to display, one byte per frame.
+ * @param frame_count   The number of frames (2 to PMOD_8LD_DMA_MAX_FRAMES).
+ * @param period_ms     The time each frame is displayed in milliseconds (1 to 2000).
+ * @param repeat        0 stops after the last frame. Otherwise, the animation restarts from the first frame.
+ *
+ * @return 1 if the frame buffer was started, 0 if the arguments are out of range.
+ */
+uint8_t PMOD_8LD_DMA_Start(const uint8_t *frames, uint16_t frame_count, uint16_t period_ms, uint8_t repeat);
+
+/**
+ * @brief The PMOD_8LD_DMA_Stop function stops the frame buffer that is playing.
+ *
+ * The PMOD 8LD module keeps displaying the last frame that was copied.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void PMOD_8LD_DMA_Stop(void);
+
+/**
+ * @brief The PMOD_8LD_DMA_Is_Active function indicates whether a frame buffer is playing.
+ *
+ * @param None
+ *
+ * @return 1 if a frame buffer is playing, 0 otherwise.
+ */
+uint8_t PMOD_8LD_DMA_Is_Active(void);
+
+#endif /* PMOD_8LD_DMA_H_ */
@@ -0,0 +1,137 @@
+/**
+ * @file Profile.h
+ * @brief Header file for the Profile driver.
+ *
+ * This file contains the function definitions and macros for measuring code regions with the
+ * DWT cycle counter (CYCCNT) of the Cortex-M4. CYCCNT counts MCLK cycles, so one cycle is 20.8 ns at 48 MHz.
+ *
+ * A region is measured by placing PROFILE_START and PROFILE_STOP around it in the same scope:
+ *
+ *      PROFILE_START(PROFILE_LED_CONTROLLER);
+ *      LED_Controller(button_status, switch_status);
+ *      PROFILE_STOP(PROFILE_LED_CONTROLLER);
+ *
+ * The minimum, maximum, and total number of cycles of every region are kept in Profile_Regions,
+ * which can be viewed in the Expressions window of the debugger.
+ *
+ * The probes are only compiled when PROFILE_ENABLE is defined (Debug build configuration).
+ * Otherwise, the macros expand to nothing and the regions do not cost any cycles or memory.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+// Instrumented regions
+#define PROFILE_MAIN_LOOP           0
+#define PROFILE_LED_CONTROLLER      1
+#define PROFILE_PMOD_8LD_OUTPUT     2
+#define PROFILE_CLOCK_DELAY_1MS     3
+#define PROFILE_REGION_COUNT        4
+
+/**
+ * @brief Profile_Stats holds the statistics of one instrumented region.
+ *
+ *  - count:    Number of measurements
+ *  - min:      Shortest measurement in cycles
+ *  - max:      Longest measurement in cycles
+ *  - total:    Sum of all measurements in cycles, used to compute the mean
+ */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} Profile_Stats;
+
+#ifdef PROFILE_ENABLE
+
+// Statistics of every region, indexed by the PROFILE_ constants
+extern Profile_Stats Profile_Regions[PROFILE_REGION_COUNT];
+
+// Cycles taken by an empty PROFILE_START/PROFILE_STOP pair, subtracted from every measurement
+extern uint32_t Profile_Overhead;
+
+/**
+ * @brief The Profile_Record function adds one measurement to the statistics of a region.
+ *
+ * @param region    The region index (PROFILE_MAIN_LOOP to PROFILE_REGION_COUNT - 1).
+ * @param cycles    The raw number of cycles between PROFILE_START and PROFILE_STOP.
+ *
+ * @return None
+ */
+static inline void Profile_Record(uint32_t region, uint32_t cycles)
+{
+    Profile_Stats *stats = &Profile_Regions[region];
+    cycles = (cycles > Profile_Overhead) ? (cycles - Profile_Overhead) : 0;
+    stats->count = stats->count + 1;
+    stats->total = stats->total + cycles;
+    if (cycles < stats->min)
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+}
+
+#define PROFILE_START(region)   uint32_t profile_start_##region = DWT->CYCCNT
+#define PROFILE_STOP(region)    Profile_Record((region), DWT->CYCCNT - profile_start_##region)
+
+#else
+
+#define PROFILE_START(region)
+#define PROFILE_STOP(region)
+
+#endif /* PROFILE_ENABLE */
+
+/**
+ * @brief The Profile_Init function enables the DWT cycle counter and clears the statistics.
+ *
+ * This function also measures the cost of an empty probe pair, which is subtracted from every
+ * measurement. It does nothing if PROFILE_ENABLE is not defined.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Profile_Init(void);
+
+/**
+ * @brief The Profile_Reset function clears the statistics of every region.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Profile_Reset(void);
+
+/**
+ * @brief The Profile_Get_Mean function returns the mean number of cycles of a region.
+ *
+ * @param region The region index (PROFILE_MAIN_LOOP to PROFILE_REGION_COUNT - 1).
+ *
+ * @return The mean number of cycles, or 0 if the region has not been measured.
+ */
+uint32_t Profile_Get_Mean(uint32_t region);
+
+/**
+ * @brief The Profile_Measure_Delays function measures Clock_Delay1ms against the cycle counter.
+ *
+ * Clock_Delay1ms(1) is called several times and recorded in PROFILE_CLOCK_DELAY_1MS.
+ * At 48 MHz, the expected duration is 48000 cycles, so (mean - 48000) is the drift per millisecond.
+ * This function must be called after Clock_Init48MHz and Profile_Init.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Profile_Measure_Delays(void);
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,83 @@
+/**
+ * @file RGB_PWM.h
+ * @brief Header file for the RGB_PWM driver.
+ *
+ * This file contains the function definitions for driving the RGB LED (P2.0 - P2.2) with hardware PWM.
+ * The port mapping controller connects the RGB LED pins to the outputs of Timer_A0:
+ *  - RGBLED_RED      (P2.0)  <-->  TA0.1
+ *  - RGBLED_GREEN    (P2.1)  <-->  TA0.2
+ *  - RGBLED_BLUE     (P2.2)  <-->  TA0.3
+ *
+ * Timer_A0 counts SMCLK/8 (1.5 MHz after Clock_Init48MHz) in up mode with a period of 1024 counts,
+ * which gives a PWM frequency of about 1465 Hz. Each channel takes an 8-bit brightness level, which is
+ * converted to a 10-bit duty cycle by a gamma table (gamma = 2.2), so equal steps of the level appear
+ * as equal steps of brightness.
+ *
+ * Fades are advanced by the Timer_A0 CCR0 interrupt once per PWM period, so the main loop is never
+ * blocked while the brightness changes. The interrupt is only enabled while a fade is in progress.
+ *
+ * @note SMCLK stops in LPM3, so the RGB LED is off while the core sleeps in LPM3.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef RGB_PWM_H_
+#define RGB_PWM_H_
+
+#include <stdint.h>
+
+// Number of PWM periods per second, used to convert a fade duration into fade steps
+#define RGB_PWM_FREQUENCY_HZ    1465
+
+/**
+ * @brief The RGB_PWM_Init function connects the RGB LED to Timer_A0 and starts the PWM with all colors off.
+ *
+ * This function maps P2.0 - P2.2 to TA0.1 - TA0.3, selects the timer function of the pins,
+ * and starts Timer_A0. The pins must be configured as outputs with GPIO_Pins_Init before this
+ * function is called. After this function, LED2_Output no longer affects the RGB LED.
+ *
+ * @param priority The TA0_0 interrupt priority (0 is highest, 7 is lowest).
+ *
+ * @return None
+ */
+void RGB_PWM_Init(uint32_t priority);
+
+/**
+ * @brief The RGB_PWM_Set function sets the brightness of the three colors immediately.
+ *
+ * A fade in progress is cancelled. The new duty cycles take effect at the start of the next PWM period.
+ *
+ * @param red   The brightness of the red LED (0 is off, 255 is fully on).
+ * @param green The brightness of the green LED (0 is off, 255 is fully on).
+ * @param blue  The brightness of the blue LED (0 is off, 255 is fully on).
+ *
+ * @return None
+ */
+void RGB_PWM_Set(uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+ * @brief The RGB_PWM_Fade function starts a linear fade from the current brightness to a new brightness.
+ *
+ * This function returns immediately. The brightness levels are interpolated by the TA0_0 interrupt,
+ * and the fade is complete after duration_ms milliseconds. A fade in progress is replaced by the new fade,
+ * starting from the brightness reached so far.
+ *
+ * @param red           The final brightness of the red LED (0 - 255).
+ * @param green         The final brightness of the green LED (0 - 255).
+ * @param blue          The final brightness of the blue LED (0 - 255).
+ * @param duration_ms   The duration of the fade in milliseconds. A duration of 0 is the same as RGB_PWM_Set.
+ *
+ * @return None
+ */
+void RGB_PWM_Fade(uint8_t red, uint8_t green, uint8_t blue, uint16_t duration_ms);
+
+/**
+ * @brief The RGB_PWM_Is_Fading function indicates whether a fade is in progress.
+ *
+ * @param None
+ *
+ * @return 1 if a fade is in progress, 0 otherwise.
+ */
+uint8_t RGB_PWM_Is_Fading(void);
+
+#endif /* RGB_PWM_H_ */
@@ -0,0 +1,30 @@
+/**
+ * @file RamFunc.h
+ * @brief Header file for placing functions in SRAM.
+ *
+ * This file contains the RAMFUNC macro, which places a function in the .TI.ramfunc section.
+ * msp432p401r.cmd loads that section into flash (MAIN) and runs it from the SRAM_CODE alias (0x01000000).
+ * The copy is listed in the boot-time copy table (.binit), which _c_int00 processes before main is called,
+ * so no copy loop is needed in startup_msp432p401r_ccs.c.
+ *
+ * Code fetched from SRAM does not stall on the flash wait states (2 at 48 MHz), so RAMFUNC is used
+ * for the interrupt handlers and the output functions that run on every tick. SRAM_CODE and SRAM_DATA
+ * are aliases of the same 64 KB, so every RAMFUNC function also reduces the SRAM available for data.
+ *
+ * @note Define RAMFUNC_DISABLE in the project settings to run every function from flash,
+ * for example to compare the timing with the Profile driver.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef RAMFUNC_H_
+#define RAMFUNC_H_
+
+// The .TI.ramfunc output section is only defined in msp432p401r.cmd for compiler version 15.9.0 and later
+#if defined(__TI_COMPILER_VERSION__) && (__TI_COMPILER_VERSION__ >= 15009000) && !defined(RAMFUNC_DISABLE)
+#define RAMFUNC     __attribute__((ramfunc))
+#else
+#define RAMFUNC
+#endif
+
+#endif /* RAMFUNC_H_ */
@@ -0,0 +1,64 @@
+/**
+ * @file Scheduler.h
+ * @brief Header file for the Scheduler driver.
+ *
+ * This file contains the function definitions for a run-to-completion task scheduler that uses the
+ * Cortex-M4 NVIC as its dispatcher. Every task is bound to its own exception, which is pended in software
+ * by Scheduler_Post, and the task runs as the handler of that exception at the priority given to
+ * Scheduler_Add. The NVIC therefore runs the ready task with the highest priority first, and a task is
+ * preempted by the interrupt handlers and the tasks with a higher priority, but never by a task with the
+ * same or a lower priority. The code that runs in thread mode (the main loop) has the lowest priority of all.
+ *
+ * The exceptions are taken in this order by Scheduler_Add:
+ *
+ *  Task    Exception       Handler
+ *  ----    ---------       -------
+ *  0       PendSV          PendSV_Handler
+ *  1       COMP_E1         COMP_E1_IRQHandler (the comparator is not used)
+ *  2       COMP_E0         COMP_E0_IRQHandler (the comparator is not used)
+ *
+ * A task runs once after one or more posts, so a task that is posted again while it is waiting is
+ * not queued twice. A task posted while it is running runs again after it returns.
+ * No stack is allocated per task: a task runs on the main stack, nested on the code it preempts.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdint.h>
+
+// Number of tasks that can be added
+#define SCHEDULER_MAX_TASKS     3
+
+// Returned by Scheduler_Add when every exception is in use
+#define SCHEDULER_NO_TASK       0xFF
+
+/**
+ * @brief The Scheduler_Add function binds a task to the next free exception.
+ *
+ * The task must return without waiting for another task or for the main loop.
+ * Its priority should be lower (numerically higher) than the interrupt handlers that post it,
+ * so posting a task from an interrupt handler never delays that handler.
+ *
+ * @param task      A pointer to the function that runs the task.
+ * @param priority  The priority of the task (0 is highest, 7 is lowest).
+ *
+ * @return The task identifier used by Scheduler_Post, or SCHEDULER_NO_TASK if SCHEDULER_MAX_TASKS tasks were already added.
+ */
+uint8_t Scheduler_Add(void (*task)(void), uint32_t priority);
+
+/**
+ * @brief The Scheduler_Post function marks a task as ready to run.
+ *
+ * This function can be called from the main loop, from interrupt handlers, and from other tasks.
+ * The task starts as soon as no code with the same or a higher priority is running and interrupts are enabled.
+ *
+ * @param task The task identifier returned by Scheduler_Add.
+ *
+ * @return None
+ */
+void Scheduler_Post(uint8_t task);
+
+#endif /* SCHEDULER_H_ */
@@ -0,0 +1,56 @@
+/**
+ * @file SysTickInts.h
+ * @brief Header file for the SysTickInts driver.
+ *
+ * This file contains the function definitions for the SysTick periodic interrupt.
+ * The SysTick timer is used as the millisecond timebase that drives the LED pattern engine.
+ *
+ * @note The SysTick timer counts MCLK cycles. The period must be recalculated with
+ * SysTickInts_Set_Period if the clock frequency is changed after SysTickInts_Init has been called.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef SYSTICKINTS_H_
+#define SYSTICKINTS_H_
+
+#include <stdint.h>
+
+/**
+ * @brief The SysTickInts_Init function initializes the SysTick timer to request periodic interrupts.
+ *
+ * This function configures the SysTick timer to use the core clock (MCLK) and to request
+ * an interrupt every period cycles. The user task is called from SysTick_Handler at the
+ * specified priority. Interrupts must be enabled globally for the task to run.
+ *
+ * @param task      A pointer to the user function that is called on every SysTick interrupt.
+ * @param period    The interrupt period in units of MCLK cycles (24-bit, 1 to 16777216).
+ *                  For example, a period of 48000 gives a 1 ms tick with a 48 MHz clock.
+ * @param priority  The interrupt priority (0 is highest, 7 is lowest).
+ *
+ * @return None
+ */
+void SysTickInts_Init(void(*task)(void), uint32_t period, uint32_t priority);
+
+/**
+ * @brief The SysTickInts_Set_Period function changes the interrupt period without restarting the SysTick timer.
+ *
+ * The new period is loaded at the next reload, so the tick in progress completes with the remaining
+ * counts of the old period, and the tick count is not reset.
+ *
+ * @param period    The interrupt period in units of MCLK cycles (24-bit, 1 to 16777216).
+ *
+ * @return None
+ */
+void SysTickInts_Set_Period(uint32_t period);
+
+/**
+ * @brief The SysTickInts_Get_Ticks function returns the number of SysTick interrupts since initialization.
+ *
+ * @param None
+ *
+ * @return The 32-bit tick count. The count wraps around after 2^32 ticks (about 49.7 days at 1 ms).
+ */
+uint32_t SysTickInts_Get_Ticks(void);
+
+#endif /* SYSTICKINTS_H_ */
@@ -0,0 +1,159 @@
+/**
+ * @file Telemetry.h
+ * @brief Header file for the Telemetry driver.
+ *
+ * This file contains the function definitions for the binary command and telemetry channel over UART0.
+ * The host can override the user buttons and the PMOD SWT switches, which selects the LED pattern remotely,
+ * and read the Profile statistics, the Trace entries, the boot times, the status of the clock system,
+ * and the watchdog counters. The host can also write a new configuration to the configuration store in INFO flash.
+ *
+ * Every command and reply is sent as one frame:
+ *
+ *      0xA5    type    length  payload (0 - 24 bytes)  checksum
+ *
+ * The checksum is chosen so that the sum of type, length, payload, and checksum is 0 (modulo 256).
+ * Multi-byte fields of the payload are little-endian.
+ *
+ *  Command                         Payload                                 Reply
+ *  -------                         -------                                 -----
+ *  TELEMETRY_CMD_PING              None                                    ACK
+ *  TELEMETRY_CMD_OVERRIDE          mask, button_status, switch_status      ACK
+ *  TELEMETRY_CMD_GET_PROFILE       None                                    PROFILE for every region, then ACK
+ *  TELEMETRY_CMD_RESET_PROFILE     None                                    ACK
+ *  TELEMETRY_CMD_GET_TRACE         None                                    TRACE for every new entry, then TRACE_END
+ *  TELEMETRY_CMD_GET_BENCHMARK     None                                    BENCHMARK for every measured pattern, then ACK
+ *  TELEMETRY_CMD_GET_BOOT          None                                    BOOT
+ *  TELEMETRY_CMD_GET_CLOCK         None                                    CLOCK
+ *  TELEMETRY_CMD_GET_WATCHDOG      None                                    WATCHDOG
+ *  TELEMETRY_CMD_CONFIG_BEGIN      length (2)                              ACK
+ *  TELEMETRY_CMD_CONFIG_DATA       offset (2), data (16)                   ACK
+ *  TELEMETRY_CMD_CONFIG_COMMIT     None                                    ACK
+ *  TELEMETRY_CMD_GET_CONFIG        None                                    CONFIG
+ *  TELEMETRY_CMD_GET_MICROBENCH    None                                    MICROBENCH for every measured configuration, then ACK
+ *
+ *  Reply                           Payload
+ *  -----                           -------
+ *  TELEMETRY_REPLY_ACK             command, status
+ *  TELEMETRY_REPLY_PROFILE         region, count (4), min (4), max (4), mean (4)
+ *  TELEMETRY_REPLY_TRACE           sequence (4), cycles (4), event, arg, value (2)
+ *  TELEMETRY_REPLY_TRACE_END       sequence of the next entry (4)
+ *  TELEMETRY_REPLY_BENCHMARK       switch_status, samples (2), timeouts (2), min (4), mean (4), max (4), p99 (4)
+ *  TELEMETRY_REPLY_BOOT            end of every boot stage in us (4 each, BOOT_STAGE_OUTPUTS_SAFE first, see Boot.h)
+ *  TELEMETRY_REPLY_CLOCK           state, error, pcm_flags (4), hfxt_restarts (4), MCLK frequency in Hz (4) (see Clock.h)
+ *  TELEMETRY_REPLY_WATCHDOG        boot cause, watchdog_resets (4), deadline_misses (4), worst_loop_us (4),
+ *                                  deadline_misses at boot (4), worst_loop_us at boot (4) (see Watchdog.h)
+ *  TELEMETRY_REPLY_CONFIG          loaded, sequence (2), length (2), crc (4), free_offset (2), erase_count (4)
+ *                                  (see ConfigStore.h)
+ *  TELEMETRY_REPLY_MICROBENCH      MCLK frequency in MHz, wait_states, op_cycles (2 each), delay_error (2 each, signed)
+ *                                  (see Microbench.h)
+ *
+ * The mask of TELEMETRY_CMD_OVERRIDE selects the inputs that are replaced by the values of the command
+ * (TELEMETRY_OVERRIDE_BUTTONS and TELEMETRY_OVERRIDE_SWITCHES). A mask of 0 returns control to the physical inputs.
+ * TELEMETRY_CMD_GET_TRACE sends the entries recorded since the previous TELEMETRY_CMD_GET_TRACE, or the oldest
+ * entries still in the buffer if some were overwritten.
+ *
+ * A configuration is written with TELEMETRY_CMD_CONFIG_BEGIN, one TELEMETRY_CMD_CONFIG_DATA for every 16 bytes
+ * of the data in order, and TELEMETRY_CMD_CONFIG_COMMIT, which map to the functions of the ConfigStore driver.
+ * Each command is acknowledged once the flash is programmed, so the host must wait for the ACK before sending
+ * the next one. The new configuration is used after the next reset.
+ *
+ * Replies are only queued when the transmit ring buffer of UART0 has room for them, and long transfers
+ * are continued on the next call to Telemetry_Poll, so the main loop is never blocked by the host.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdint.h>
+
+// Frame synchronization byte and largest payload
+#define TELEMETRY_SYNC                  0xA5
+#define TELEMETRY_MAX_PAYLOAD           24
+
+// Commands (host to LaunchPad)
+#define TELEMETRY_CMD_PING              0x01
+#define TELEMETRY_CMD_OVERRIDE          0x02
+#define TELEMETRY_CMD_GET_PROFILE       0x03
+#define TELEMETRY_CMD_RESET_PROFILE     0x04
+#define TELEMETRY_CMD_GET_TRACE         0x05
+#define TELEMETRY_CMD_GET_BENCHMARK     0x06
+#define TELEMETRY_CMD_GET_BOOT          0x07
+#define TELEMETRY_CMD_GET_CLOCK         0x08
+#define TELEMETRY_CMD_GET_WATCHDOG      0x09
+#define TELEMETRY_CMD_CONFIG_BEGIN      0x0A
+#define TELEMETRY_CMD_CONFIG_DATA       0x0B
+#define TELEMETRY_CMD_CONFIG_COMMIT     0x0C
+#define TELEMETRY_CMD_GET_CONFIG        0x0D
+#define TELEMETRY_CMD_GET_MICROBENCH    0x0E
+
+// Replies (LaunchPad to host)
+#define TELEMETRY_REPLY_ACK             0x80
+#define TELEMETRY_REPLY_PROFILE         0x81
+#define TELEMETRY_REPLY_TRACE           0x82
+#define TELEMETRY_REPLY_TRACE_END       0x83
+#define TELEMETRY_REPLY_BENCHMARK       0x84
+#define TELEMETRY_REPLY_BOOT            0x85
+#define TELEMETRY_REPLY_CLOCK           0x86
+#define TELEMETRY_REPLY_WATCHDOG        0x87
+#define TELEMETRY_REPLY_CONFIG          0x88
+#define TELEMETRY_REPLY_MICROBENCH      0x89
+
+// Status of TELEMETRY_REPLY_ACK
+#define TELEMETRY_STATUS_OK             0x00
+#define TELEMETRY_STATUS_BAD_CHECKSUM   0x01
+#define TELEMETRY_STATUS_BAD_LENGTH     0x02
+#define TELEMETRY_STATUS_UNKNOWN        0x03
+#define TELEMETRY_STATUS_UNAVAILABLE    0x04
+#define TELEMETRY_STATUS_INVALID        0x05
+#define TELEMETRY_STATUS_FLASH_ERROR    0x06
+
+// Inputs replaced by TELEMETRY_CMD_OVERRIDE
+#define TELEMETRY_OVERRIDE_BUTTONS      0x01
+#define TELEMETRY_OVERRIDE_SWITCHES     0x02
+
+/**
+ * @brief The Telemetry_Init function initializes UART0 and clears the input overrides.
+ *
+ * @param priority The EUSCIA0 interrupt priority (0 is highest, 7 is lowest).
+ *
+ * @return None
+ */
+void Telemetry_Init(uint32_t priority);
+
+/**
+ * @brief The Telemetry_Poll function executes the received commands and continues the transfer in progress.
+ *
+ * This function must be called from the main loop. It never waits: a transfer that does not fit
+ * in the transmit ring buffer is continued on the next call, and received commands are left in the
+ * receive ring buffer until the transfer is complete.
+ *
+ * @param None
+ *
+ * @return 1 if the input overrides were changed or a configuration update dropped the patterns of the configuration store, 0 otherwise.
+ */
+uint8_t Telemetry_Poll(void);
+
+/**
+ * @brief The Telemetry_Has_Work function indicates whether Telemetry_Poll can make progress.
+ *
+ * The main loop must not sleep while this function returns 1. Otherwise, the next UART0 interrupt wakes the core.
+ *
+ * @param None
+ *
+ * @return 1 if a command or the next frame of a transfer can be processed, 0 otherwise.
+ */
+uint8_t Telemetry_Has_Work(void);
+
+/**
+ * @brief The Telemetry_Apply_Overrides function replaces the physical inputs with the values set by the host.
+ *
+ * @param button_status A pointer to the status of the user buttons, which is replaced if it is overridden.
+ * @param switch_status A pointer to the status of the PMOD SWT switches, which is replaced if it is overridden.
+ *
+ * @return None
+ */
+void Telemetry_Apply_Overrides(uint8_t *button_status, uint8_t *switch_status);
+
+#endif /* TELEMETRY_H_ */
@@ -0,0 +1,190 @@
+/**
+ * @file Trace.h
+ * @brief Header file for the Trace driver.
+ *
+ * This file contains the function definitions and the entry format of the event trace, a fixed-size
+ * ring buffer in SRAM that records timestamped events: input changes, pattern transitions, tick overruns,
+ * and clock frequency changes. The newest TRACE_SIZE entries are kept, and older entries are overwritten.
+ *
+ * Trace_Record is lock-free and can be called from the main loop and from any interrupt handler.
+ * A slot is reserved by incrementing Trace_Index with an exclusive load/store pair (LDREX/STREX).
+ * An interrupt that occurs between the two instructions clears the exclusive monitor, so the store fails
+ * and the slot is reserved again. Each slot is therefore written by exactly one caller. With the
+ * cycle counter running, a record takes about 12 cycles.
+ *
+ * The buffer can be read in two ways:
+ *  - From the debugger (GPIO.launch): add Trace_Buffer and Trace_Index to the Expressions window.
+ *    The newest entry is Trace_Buffer[(Trace_Index - 1) & (TRACE_SIZE - 1)].
+ *  - From the program: Trace_Read copies an entry by its sequence number, for example to send it over UART.
+ *
+ * The timestamp is the DWT cycle counter (CYCCNT), which counts MCLK cycles and wraps around every 89 s
+ * at 48 MHz. A TRACE_EVENT_CLOCK entry is recorded whenever MCLK changes, so the cycles between two entries
+ * can be converted to time.
+ *
+ * @note Define TRACE_DISABLE in the project settings to remove the probes from the program.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+#include "msp.h"
+
+// Number of entries kept in the trace buffer (must be a power of 2)
+#define TRACE_SIZE                  256
+
+/**
+ * Trace events
+ *
+ *  Event                       arg                             value
+ *  -----                       ---                             -----
+ *  TRACE_EVENT_BUTTONS         New button status (0x00 - 0x12) 0
+ *  TRACE_EVENT_SWITCHES        New switch status (0x00 - 0x0F) 0
+ *  TRACE_EVENT_PATTERN_EXIT    Step index of the old pattern   Elapsed time of that step in ms
+ *  TRACE_EVENT_PATTERN_ENTRY   Pattern table index             Number of steps of the new pattern
+ *  TRACE_EVENT_DELAY_OVERRUN   0                               Number of ticks processed late
+ *  TRACE_EVENT_CLOCK           0                               New MCLK frequency in MHz
+ *  TRACE_EVENT_INPUTS          0                               New debounced inputs (see InputSnapshot.h)
+ *  TRACE_EVENT_DEADLINE_MISS   0                               Time of the main loop iteration in us (see Watchdog.h)
+ *  TRACE_EVENT_WATCHDOG_RESET  0                               Number of watchdog resets since the power-up
+ *
+ * TRACE_EVENT_INPUTS is timestamped with the snapshot that completed the change, not with the time of the record.
+ */
+#define TRACE_EVENT_BUTTONS         0x01
+#define TRACE_EVENT_SWITCHES        0x02
+#define TRACE_EVENT_PATTERN_EXIT    0x03
+#define TRACE_EVENT_PATTERN_ENTRY   0x04
+#define TRACE_EVENT_DELAY_OVERRUN   0x05
+#define TRACE_EVENT_CLOCK           0x06
+#define TRACE_EVENT_INPUTS          0x07
+#define TRACE_EVENT_DEADLINE_MISS   0x08
+#define TRACE_EVENT_WATCHDOG_RESET  0x09
+
+/**
+ * @brief Trace_Entry describes one recorded event.
+ *
+ *  - cycles:   Value of the DWT cycle counter when the event was recorded
+ *  - event:    One of the TRACE_EVENT_ constants
+ *  - arg:      8-bit argument of the event
+ *  - value:    16-bit argument of the event
+ */
+typedef struct
+{
+    uint32_t cycles;
+    uint8_t event;
+    uint8_t arg;
+    uint16_t value;
+} Trace_Entry;
+
+// Exclusive load and store of a 32-bit word
+#if defined(__TI_COMPILER_VERSION__)
+#define TRACE_LOAD_EXCLUSIVE(address)           __ldrex((void *)(address))
+#define TRACE_STORE_EXCLUSIVE(value, address)   __strex((value), (void *)(address))
+#else
+#define TRACE_LOAD_EXCLUSIVE(address)           __LDREXW(address)
+#define TRACE_STORE_EXCLUSIVE(value, address)   __STREXW((value), (address))
+#endif
+
+#ifndef TRACE_DISABLE
+
+// Ring buffer of the trace entries, indexed by (sequence number & (TRACE_SIZE - 1))
+extern Trace_Entry Trace_Buffer[TRACE_SIZE];
+
+// Sequence number of the next entry, which is also the number of entries recorded since Trace_Init
+extern volatile uint32_t Trace_Index;
+
+/**
+ * @brief The Trace_Record_At function adds one entry to the trace buffer with a given timestamp.
+ *
+ * This function can be called from the main loop and from interrupt handlers of any priority.
+ *
+ * @param cycles The value of the cycle counter when the event occurred.
+ * @param event One of the TRACE_EVENT_ constants.
+ * @param arg   The 8-bit argument of the event.
+ * @param value The 16-bit argument of the event.
+ *
+ * @return None
+ */
+static inline void Trace_Record_At(uint32_t cycles, uint8_t event, uint8_t arg, uint16_t value)
+{
+    uint32_t index;
+    do
+    {
+        index = TRACE_LOAD_EXCLUSIVE(&Trace_Index);
+    } while (TRACE_STORE_EXCLUSIVE(index + 1, &Trace_Index) != 0);
+
+    Trace_Entry *entry = &Trace_Buffer[index & (TRACE_SIZE - 1)];
+    entry->cycles = cycles;
+    entry->event = event;
+    entry->arg = arg;
+    entry->value = value;
+}
+
+/**
+ * @brief The Trace_Record function adds one entry to the trace buffer, timestamped with the cycle counter.
+ *
+ * This function can be called from the main loop and from interrupt handlers of any priority.
+ *
+ * @param event One of the TRACE_EVENT_ constants.
+ * @param arg   The 8-bit argument of the event.
+ * @param value The 16-bit argument of the event.
+ *
+ * @return None
+ */
+static inline void Trace_Record(uint8_t event, uint8_t arg, uint16_t value)
+{
+    Trace_Record_At(DWT->CYCCNT, event, arg, value);
+}
+
+#else
+
+static inline void Trace_Record_At(uint32_t cycles, uint8_t event, uint8_t arg, uint16_t value)
+{
+}
+
+static inline void Trace_Record(uint8_t event, uint8_t arg, uint16_t value)
+{
+}
+
+#endif /* TRACE_DISABLE */
+
+/**
+ * @brief The Trace_Init function enables the DWT cycle counter and clears the trace buffer.
+ *
+ * The cycle counter is not reset, so it can be shared with the Profile driver.
+ * It does nothing if TRACE_DISABLE is defined.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Trace_Init(void);
+
+/**
+ * @brief The Trace_Get_Count function returns the number of entries recorded since Trace_Init was called.
+ *
+ * The sequence numbers of the entries that are still in the buffer range from
+ * (count - TRACE_SIZE) to (count - 1), or from 0 if fewer than TRACE_SIZE entries were recorded.
+ *
+ * @param None
+ *
+ * @return The sequence number of the next entry.
+ */
+uint32_t Trace_Get_Count(void);
+
+/**
+ * @brief The Trace_Read function copies an entry from the trace buffer.
+ *
+ * This function must be called from the main loop. Every entry reserved by an interrupt handler
+ * has then been completely written, and an entry that is overwritten while it is copied is discarded.
+ *
+ * @param sequence  The sequence number of the entry.
+ * @param entry     A pointer to the structure that receives the entry.
+ *
+ * @return 1 if the entry was copied, 0 if it has not been recorded yet or has been overwritten.
+ */
+uint8_t Trace_Read(uint32_t sequence, Trace_Entry *entry);
+
+#endif /* TRACE_H_ */
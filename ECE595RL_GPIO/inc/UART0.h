@@ -0,0 +1,96 @@
+/**
+ * @file UART0.h
+ * @brief Header file for the UART0 driver.
+ *
+ * This file contains the function definitions for the interrupt-driven eUSCI_A0 UART.
+ * eUSCI_A0 is connected to the XDS110 debug probe of the LaunchPad, which presents it to the host
+ * as a virtual COM port (Application/User UART):
+ *  - UCA0RXD   (P1.2)  <-->  XDS110 TXD
+ *  - UCA0TXD   (P1.3)  <-->  XDS110 RXD
+ *
+ * The UART runs at 115200 baud, 8 data bits, no parity, and 1 stop bit from SMCLK (12 MHz after Clock_Init48MHz).
+ * Received bytes are stored in a ring buffer by EUSCIA0_IRQHandler, and transmitted bytes are taken from a
+ * second ring buffer by the same handler. Both buffers have a single producer and a single consumer,
+ * so UART0_Read and UART0_Write never disable interrupts and never wait for the UART.
+ *
+ * EUSCIA0_IRQHandler overrides the weak definition found in startup_msp432p401r_ccs.c.
+ *
+ * @note SMCLK stops in LPM3, so bytes cannot be received while the core sleeps in LPM3.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef UART0_H_
+#define UART0_H_
+
+#include <stdint.h>
+
+// Number of bytes that the receive and transmit ring buffers can hold (must be powers of 2)
+#define UART0_RX_SIZE           64
+#define UART0_TX_SIZE           256
+
+/**
+ * @brief The UART0_Init function initializes eUSCI_A0 for 115200 baud and enables its receive interrupt.
+ *
+ * This function selects the UART function of P1.2 and P1.3, configures the baud rate generator for
+ * SMCLK = 12 MHz, clears both ring buffers, and enables the EUSCIA0 interrupt in the NVIC at the given priority.
+ * Clock_Init48MHz must be called before this function.
+ *
+ * @param priority The EUSCIA0 interrupt priority (0 is highest, 7 is lowest).
+ *
+ * @return None
+ */
+void UART0_Init(uint32_t priority);
+
+/**
+ * @brief The UART0_Read function removes the oldest received byte from the receive ring buffer.
+ *
+ * This function never waits. It must only be called from the main loop.
+ *
+ * @param data A pointer to the byte that receives the data.
+ *
+ * @return 1 if a byte was removed, 0 if the receive ring buffer is empty.
+ */
+uint8_t UART0_Read(uint8_t *data);
+
+/**
+ * @brief The UART0_Available function returns the number of received bytes waiting in the receive ring buffer.
+ *
+ * @param None
+ *
+ * @return The number of bytes that can be removed with UART0_Read.
+ */
+uint32_t UART0_Available(void);
+
+/**
+ * @brief The UART0_Write function adds a block of bytes to the transmit ring buffer.
+ *
+ * The block is either queued completely or not at all, so a frame is never split by a full buffer.
+ * This function never waits. It must only be called from the main loop.
+ *
+ * @param data      A pointer to the bytes to transmit.
+ * @param length    The number of bytes to transmit.
+ *
+ * @return 1 if the bytes were queued, 0 if the transmit ring buffer does not have enough free space.
+ */
+uint8_t UART0_Write(const uint8_t *data, uint32_t length);
+
+/**
+ * @brief The UART0_Get_Free function returns the free space of the transmit ring buffer.
+ *
+ * @param None
+ *
+ * @return The largest length that UART0_Write currently accepts.
+ */
+uint32_t UART0_Get_Free(void);
+
+/**
+ * @brief The UART0_Get_Overflows function returns the number of received bytes dropped because the receive ring buffer was full.
+ *
+ * @param None
+ *
+ * @return The number of dropped bytes since UART0_Init was called.
+ */
+uint32_t UART0_Get_Overflows(void);
+
+#endif /* UART0_H_ */
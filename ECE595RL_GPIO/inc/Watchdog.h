@@ -0,0 +1,102 @@
+/**
+ * @file Watchdog.h
+ * @brief Header file for the Watchdog driver.
+ *
+ * This file contains the function definitions for supervising the main loop with the watchdog timer (WDT_A).
+ * Every iteration of the main loop is enclosed by Watchdog_Loop_Start and Watchdog_Loop_End, which measures
+ * the time of the iteration with the DWT cycle counter (CYCCNT) and clears the watchdog timer. An iteration
+ * that takes longer than the budget given to Watchdog_Init is counted as a deadline miss and recorded as a
+ * TRACE_EVENT_DEADLINE_MISS entry. If the main loop stops iterating, for example because a task or an interrupt
+ * handler never returns, the watchdog timer expires after WATCHDOG_TIMEOUT_MS and resets the device.
+ *
+ * The watchdog timer is clocked by ACLK (REFOCLK, 32.768 kHz), so it keeps running in LPM0 and LPM3.
+ * The main loop wakes up at least once per tick in LPM0 and every 7.8 ms in LPM3, which is well within the timeout.
+ *
+ * The counters are placed in the .noinit section of SRAM (see msp432p401r.cmd), which is not cleared by
+ * the C startup code, so they survive a watchdog reset. They are protected by a check word, and they are
+ * cleared when the check fails, which is the case after a power-up. Watchdog_Init copies the counters found
+ * at boot to Watchdog_Boot_Counters and the cause of the reset to Watchdog_Boot_Cause, which can be added to the
+ * Expressions window of the debugger, records a TRACE_EVENT_WATCHDOG_RESET entry after a watchdog reset,
+ * and the counters can be read over UART0 with TELEMETRY_CMD_GET_WATCHDOG.
+ *
+ * The loop time includes the interrupt handlers and the tasks that preempt the main loop, but not the time
+ * spent in a low-power mode. It is converted to us at the MCLK frequency at the end of the iteration.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef WATCHDOG_H_
+#define WATCHDOG_H_
+
+#include <stdint.h>
+
+// Time without a call to Watchdog_Loop_End after which the device is reset (2^13 ACLK cycles)
+#define WATCHDOG_TIMEOUT_MS         250
+
+// Cause of the last reset, found by Watchdog_Init
+#define WATCHDOG_CAUSE_POWER_UP     0
+#define WATCHDOG_CAUSE_TIMEOUT      1
+#define WATCHDOG_CAUSE_OTHER        2
+
+/**
+ * @brief Watchdog_Counters describes the supervision of the main loop since the last power-up.
+ *
+ *  - watchdog_resets:  Number of resets caused by a watchdog timeout
+ *  - deadline_misses:  Number of iterations of the main loop that took longer than the budget
+ *  - worst_loop_us:    Longest iteration of the main loop in us
+ */
+typedef struct
+{
+    uint32_t watchdog_resets;
+    uint32_t deadline_misses;
+    uint32_t worst_loop_us;
+} Watchdog_Counters;
+
+// Counters found at boot, including the reset recorded by Watchdog_Init
+extern Watchdog_Counters Watchdog_Boot_Counters;
+
+// Cause of the last reset (WATCHDOG_CAUSE_POWER_UP, WATCHDOG_CAUSE_TIMEOUT, or WATCHDOG_CAUSE_OTHER)
+extern uint8_t Watchdog_Boot_Cause;
+
+/**
+ * @brief The Watchdog_Init function validates the retained counters and starts the watchdog timer.
+ *
+ * This function must be called once, right before the main loop is entered. SystemInit holds the
+ * watchdog timer until then, so the boot sequence is not supervised.
+ *
+ * @param budget_us The longest time of one iteration of the main loop that is not counted as a deadline miss, in us.
+ *
+ * @return None
+ */
+void Watchdog_Init(uint32_t budget_us);
+
+/**
+ * @brief The Watchdog_Loop_Start function records the start of an iteration of the main loop.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Watchdog_Loop_Start(void);
+
+/**
+ * @brief The Watchdog_Loop_End function measures the iteration of the main loop and clears the watchdog timer.
+ *
+ * This function must be called before the main loop enters a low-power mode.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Watchdog_Loop_End(void);
+
+/**
+ * @brief The Watchdog_Get_Counters function returns the current counters.
+ *
+ * @param counters A pointer to the structure that receives the counters.
+ *
+ * @return None
+ */
+void Watchdog_Get_Counters(Watchdog_Counters *counters);
+
+#endif /* WATCHDOG_H_ */
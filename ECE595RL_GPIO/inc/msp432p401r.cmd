@@ -88,6 +88,8 @@ SECTIONS
     /* INFO flash memory is intended to be used for the following            */
     /* device specific purposes:                                             */
     /* Flash mailbox for device security operations                          */
+    /* The program does not use the flash mailbox: this sector holds the     */
+    /* configuration store (see ConfigStore.h)                               */
     .flashMailbox : > 0x00200000
     /* TLV table for device identification and characterization              */
     .tlvTable     : > 0x00201000
@@ -97,6 +99,8 @@ SECTIONS
     .vtable :   > 0x20000000
     .data   :   > SRAM_DATA
     .bss    :   > SRAM_DATA
+    /* Variables retained through a reset, which are not initialized by the C startup code (see Watchdog.h) */
+    .noinit :   > SRAM_DATA, type = NOINIT
     .sysmem :   > SRAM_DATA
     .stack  :   > SRAM_DATA (HIGH)
 
@@ -0,0 +1,797 @@
+/**
+ * @file Sim.c
+ * @brief Source code for the host simulator of the GPIO program.
+ *
+ * This file contains the register memory of the simulated peripherals, the virtual clock,
+ * the NVIC model, and the CMSIS functions declared in the simulation msp.h.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include <setjmp.h>
+#include <string.h>
+#include "msp.h"
+#include "Sim.h"
+
+// Register memory of the simulated peripherals
+uint8_t Sim_DIO[0x140];
+PMAP_COMMON_Type Sim_PMAP;
+PMAP_REGISTER_Type Sim_P2MAP;
+SysTick_Type Sim_SysTick;
+SCB_Type Sim_SCB;
+DWT_Type Sim_DWT;
+CoreDebug_Type Sim_CoreDebug;
+PCM_Type Sim_PCM;
+CS_Type Sim_CS;
+FLCTL_Type Sim_FLCTL;
+Timer32_Type Sim_TIMER32_1;
+Timer32_Type Sim_TIMER32_2;
+Timer_A_Type Sim_TIMER_A[4];
+RTC_C_Type Sim_RTC_C;
+DMA_Control_Type Sim_DMA_Control;
+DMA_Channel_Type Sim_DMA_Channel;
+EUSCI_A_Type Sim_EUSCI_A0;
+WDT_A_Type Sim_WDT_A;
+RSTCTL_Type Sim_RSTCTL;
+CRC32_Type Sim_CRC32 = { .DI32 = SIM_CRC32_NO_DATA };
+uint8_t Sim_INFO_Flash[4096];
+
+// Number of calls to Sim_Access with every address of Sim_DIO (see Sim_Get_Port_Accesses)
+static uint32_t Sim_DIO_Accesses[sizeof(Sim_DIO)];
+
+// MCLK frequency, defined by system_msp432p401r.c on the device (3 MHz DCO after reset)
+uint32_t SystemCoreClock = 3000000;
+
+// Ports accessed by the simulator itself, without the Sim_Access hook
+#define SIM_P1                  ((DIO_PORT_Odd_Interruptable_Type *)&Sim_DIO[0x000])
+#define SIM_P2                  ((DIO_PORT_Even_Interruptable_Type *)&Sim_DIO[0x000])
+#define SIM_P9                  ((DIO_PORT_Odd_Type *)&Sim_DIO[0x080])
+#define SIM_P10                 ((DIO_PORT_Even_Type *)&Sim_DIO[0x080])
+
+// Write access to the registers that are read-only for the program
+#define SIM_WRITE_8(reg, value)     (*(volatile uint8_t *)&(reg) = (value))
+#define SIM_WRITE_32(reg, value)    (*(volatile uint32_t *)&(reg) = (value))
+
+// Pins driven by the scenario
+#define SIM_BUTTONS_MASK        0x12
+#define SIM_SWITCHES_MASK       0x0F
+
+// Interrupt handlers of the program. They are weak, so the handlers that are not linked are null.
+extern void PendSV_Handler(void) __attribute__((weak));
+extern void SysTick_Handler(void) __attribute__((weak));
+extern void PSS_IRQHandler(void) __attribute__((weak));
+extern void CS_IRQHandler(void) __attribute__((weak));
+extern void PCM_IRQHandler(void) __attribute__((weak));
+extern void WDT_A_IRQHandler(void) __attribute__((weak));
+extern void COMP_E0_IRQHandler(void) __attribute__((weak));
+extern void COMP_E1_IRQHandler(void) __attribute__((weak));
+extern void TA0_0_IRQHandler(void) __attribute__((weak));
+extern void TA0_N_IRQHandler(void) __attribute__((weak));
+extern void TA1_0_IRQHandler(void) __attribute__((weak));
+extern void TA1_N_IRQHandler(void) __attribute__((weak));
+extern void TA2_0_IRQHandler(void) __attribute__((weak));
+extern void TA2_N_IRQHandler(void) __attribute__((weak));
+extern void TA3_0_IRQHandler(void) __attribute__((weak));
+extern void TA3_N_IRQHandler(void) __attribute__((weak));
+extern void EUSCIA0_IRQHandler(void) __attribute__((weak));
+extern void T32_INT1_IRQHandler(void) __attribute__((weak));
+extern void T32_INT2_IRQHandler(void) __attribute__((weak));
+extern void RTC_C_IRQHandler(void) __attribute__((weak));
+extern void DMA_ERR_IRQHandler(void) __attribute__((weak));
+extern void DMA_INT3_IRQHandler(void) __attribute__((weak));
+extern void DMA_INT2_IRQHandler(void) __attribute__((weak));
+extern void DMA_INT1_IRQHandler(void) __attribute__((weak));
+extern void DMA_INT0_IRQHandler(void) __attribute__((weak));
+extern void PORT1_IRQHandler(void) __attribute__((weak));
+extern void PORT2_IRQHandler(void) __attribute__((weak));
+
+// Number of exceptions in the NVIC model: PendSV, SysTick, and the 64 device interrupts
+#define SIM_EXCEPTION_COUNT     66
+#define SIM_EXCEPTION(irq)      ((uint32_t)((int32_t)(irq) + 2))
+
+// Execution priority of the thread mode, lower than every configurable priority (0 - 7)
+#define SIM_THREAD_PRIORITY     8
+
+/**
+ * @brief Sim_Exception holds the NVIC state of one exception.
+ */
+typedef struct
+{
+    void (*handler)(void);
+    uint8_t enabled;
+    uint8_t pending;
+    uint8_t active;
+    uint8_t priority;
+} Sim_Exception_State;
+
+static Sim_Exception_State Sim_Exceptions[SIM_EXCEPTION_COUNT];
+
+// PRIMASK, and the priority of the exception that is executing
+static uint8_t Sim_Primask = 0;
+static uint8_t Sim_Execution_Priority = SIM_THREAD_PRIORITY;
+
+// Virtual time in HFXT cycles, end of the run, and the scenario
+static uint64_t Sim_Time = 0;
+static uint64_t Sim_End_Time = 0;
+static const Sim_Scenario *Sim_Current = 0;
+static jmp_buf Sim_Exit;
+
+// Counters, and the register values last published to the program (used to detect writes)
+static uint32_t SysTick_Count = 0;
+static uint32_t SysTick_Published = 0;
+static uint32_t Timer32_Count = 0;
+static uint32_t Timer32_Last_Load = 0;
+static uint32_t Timer32_Last_Control = 0;
+static uint32_t Cycle_Count = 0;
+static uint32_t Cycle_Published = 0;
+static uint32_t ICSR_Published = 0;
+
+// CRC32 signature, and the value last published to INIRES32
+static uint32_t CRC32_State = 0;
+static uint32_t CRC32_Published = 0;
+
+// HFXT start fault counter: virtual time at which it expires, or SIM_NEVER if it is not counting
+static uint64_t Hfxt_Count_End = SIM_NEVER;
+
+// Pending bit-band write: register, size, bit, and alias word
+static volatile void *Bitband_Address = 0;
+static uint32_t Bitband_Size = 0;
+static uint32_t Bitband_Bit = 0;
+static volatile uint32_t Bitband_Word = 0;
+
+// Output levels last reported to the scenario
+static Sim_Outputs Sim_Last_Outputs;
+
+/**
+ * @brief The Sim_Bitband_Flush function copies the pending bit-band write to the register.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Bitband_Flush(void)
+{
+    if (Bitband_Address == 0)
+    {
+        return;
+    }
+
+    uint32_t mask = 1UL << Bitband_Bit;
+    uint32_t set = (Bitband_Word & 0x01) ? mask : 0;
+    switch(Bitband_Size)
+    {
+        case 1:
+        {
+            volatile uint8_t *reg = (volatile uint8_t *)Bitband_Address;
+            *reg = (uint8_t)((*reg & ~mask) | set);
+        }
+        break;
+
+        case 2:
+        {
+            volatile uint16_t *reg = (volatile uint16_t *)Bitband_Address;
+            *reg = (uint16_t)((*reg & ~mask) | set);
+        }
+        break;
+
+        default:
+        {
+            volatile uint32_t *reg = (volatile uint32_t *)Bitband_Address;
+            *reg = (*reg & ~mask) | set;
+        }
+    }
+    Bitband_Address = 0;
+}
+
+/**
+ * @brief The Sim_Sync function applies the register writes of the program to the simulator state,
+ * and publishes the counter and status registers.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Sync(void)
+{
+    Sim_Bitband_Flush();
+
+    // Any write to SysTick->VAL clears the counter
+    if (Sim_SysTick.VAL != SysTick_Published)
+    {
+        SysTick_Count = 0;
+        Sim_SysTick.CTRL &= ~0x00010000;
+    }
+    Sim_SysTick.VAL = SysTick_Count;
+    SysTick_Published = SysTick_Count;
+
+    // Timer32 starts from LOAD when it is enabled, and reloads when LOAD is written
+    uint32_t control = Sim_TIMER32_1.CONTROL;
+    if (((control & 0x80) && !(Timer32_Last_Control & 0x80)) || (Sim_TIMER32_1.LOAD != Timer32_Last_Load))
+    {
+        Timer32_Count = Sim_TIMER32_1.LOAD;
+    }
+    Timer32_Last_Control = control;
+    Timer32_Last_Load = Sim_TIMER32_1.LOAD;
+    SIM_WRITE_32(Sim_TIMER32_1.VALUE, Timer32_Count);
+
+    // The program may reset the cycle counter
+    if (Sim_DWT.CYCCNT != Cycle_Published)
+    {
+        Cycle_Count = Sim_DWT.CYCCNT;
+    }
+    Sim_DWT.CYCCNT = Cycle_Count;
+    Cycle_Published = Cycle_Count;
+
+    // CS: CLRIFG clears the flags. The crystal never faults, so the HFXT start fault counter
+    // counts from the time it is enabled (or restarted with RFCNTHF) and sets FCNTHFIFG when it expires.
+    if (Sim_CS.CLRIFG != 0)
+    {
+        SIM_WRITE_32(Sim_CS.IFG, Sim_CS.IFG & ~Sim_CS.CLRIFG);
+        SIM_WRITE_32(Sim_CS.CLRIFG, 0);
+    }
+    if ((Sim_CS.CTL2 & 0x01000000) && (Sim_CS.CTL3 & 0x00000080))
+    {
+        if ((Hfxt_Count_End == SIM_NEVER) || (Sim_CS.CTL3 & 0x00000040))
+        {
+            Sim_CS.CTL3 &= ~0x00000040;
+            Hfxt_Count_End = Sim_Time + (2048UL << ((Sim_CS.CTL3 >> 4) & 0x03));
+        }
+        if (Sim_Time >= Hfxt_Count_End)
+        {
+            SIM_WRITE_32(Sim_CS.IFG, Sim_CS.IFG | 0x00000200);
+        }
+    }
+    else
+    {
+        Hfxt_Count_End = SIM_NEVER;
+    }
+
+    // CRC32: a write to INIRES32 seeds the signature, and the pending DI32 write is added to it
+    uint32_t crc = ((uint32_t)Sim_CRC32.INIRES32_HI << 16) | Sim_CRC32.INIRES32_LO;
+    if (crc != CRC32_Published)
+    {
+        CRC32_State = crc;
+    }
+    if (Sim_CRC32.DI32 != SIM_CRC32_NO_DATA)
+    {
+        uint32_t data = Sim_CRC32.DI32 & 0xFFFF;
+        CRC32_State = CRC32_State ^ data;
+        for (uint32_t bit = 0; bit < 16; bit++)
+        {
+            CRC32_State = (CRC32_State >> 1) ^ ((CRC32_State & 0x01) ? 0xEDB88320 : 0);
+        }
+        Sim_CRC32.DI32 = SIM_CRC32_NO_DATA;
+    }
+    Sim_CRC32.INIRES32_LO = (uint16_t)CRC32_State;
+    Sim_CRC32.INIRES32_HI = (uint16_t)(CRC32_State >> 16);
+    CRC32_Published = CRC32_State;
+
+    // FLCTL: a sector erase completes immediately, and CLR_STAT returns the status to idle
+    if (Sim_FLCTL.ERASE_CTLSTAT & FLCTL_ERASE_CTLSTAT_START)
+    {
+        for (uint32_t index = 0; index < sizeof(Sim_INFO_Flash); index++)
+        {
+            Sim_INFO_Flash[index] = 0xFF;
+        }
+    }
+    Sim_FLCTL.ERASE_CTLSTAT &= ~(FLCTL_ERASE_CTLSTAT_START | FLCTL_ERASE_CTLSTAT_CLR_STAT | FLCTL_ERASE_CTLSTAT_STATUS_MASK);
+
+    // Active mode requests complete immediately: CPM follows AMR
+    Sim_PCM.CTL0 = (Sim_PCM.CTL0 & ~0x00003F00) | ((Sim_PCM.CTL0 & 0x0000000F) << 8);
+
+    // ICSR: set and clear the pending state of PendSV and SysTick
+    uint32_t icsr = Sim_SCB.ICSR;
+    if (icsr != ICSR_Published)
+    {
+        if (icsr & SCB_ICSR_PENDSVSET_Msk)
+        {
+            Sim_Exceptions[SIM_EXCEPTION(PendSV_IRQn)].pending = 1;
+        }
+        if (icsr & (1UL << 27))
+        {
+            Sim_Exceptions[SIM_EXCEPTION(PendSV_IRQn)].pending = 0;
+        }
+        if (icsr & SCB_ICSR_PENDSTSET_Msk)
+        {
+            Sim_Exceptions[SIM_EXCEPTION(SysTick_IRQn)].pending = 1;
+        }
+        if (icsr & (1UL << 25))
+        {
+            Sim_Exceptions[SIM_EXCEPTION(SysTick_IRQn)].pending = 0;
+        }
+    }
+    icsr = 0;
+    if (Sim_Exceptions[SIM_EXCEPTION(PendSV_IRQn)].pending)
+    {
+        icsr |= SCB_ICSR_PENDSVSET_Msk;
+    }
+    if (Sim_Exceptions[SIM_EXCEPTION(SysTick_IRQn)].pending)
+    {
+        icsr |= SCB_ICSR_PENDSTSET_Msk;
+    }
+    Sim_SCB.ICSR = icsr;
+    ICSR_Published = icsr;
+}
+
+/**
+ * @brief The Sim_Port_Levels function sets the pending state of PORT1 and CS from their interrupt flags.
+ *
+ * These interrupts are levels: they are pended again after their handler returns while (IFG & IE) != 0.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Port_Levels(void)
+{
+    Sim_Exception_State *port = &Sim_Exceptions[SIM_EXCEPTION(PORT1_IRQn)];
+    if (!port->active && (SIM_P1->IFG & SIM_P1->IE))
+    {
+        port->pending = 1;
+    }
+
+    Sim_Exception_State *cs = &Sim_Exceptions[SIM_EXCEPTION(CS_IRQn)];
+    if (!cs->active && (Sim_CS.IFG & Sim_CS.IE))
+    {
+        cs->pending = 1;
+    }
+}
+
+/**
+ * @brief The Sim_Observe function reports the output pins to the scenario when they change.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Observe(void)
+{
+    Sim_Bitband_Flush();
+
+    Sim_Outputs outputs;
+    outputs.led1 = SIM_P1->OUT & SIM_P1->DIR & 0x01;
+    outputs.rgb = SIM_P2->OUT & SIM_P2->DIR & 0x07;
+    outputs.pmod_8ld = SIM_P9->OUT & SIM_P9->DIR;
+
+    if ((outputs.led1 != Sim_Last_Outputs.led1) || (outputs.rgb != Sim_Last_Outputs.rgb) ||
+        (outputs.pmod_8ld != Sim_Last_Outputs.pmod_8ld))
+    {
+        Sim_Last_Outputs = outputs;
+        if ((Sim_Current != 0) && (Sim_Current->output != 0))
+        {
+            Sim_Current->output(Sim_Time, &outputs);
+        }
+    }
+}
+
+/**
+ * @brief The Sim_Next_Exception function returns the pending exception with the highest priority
+ * that can preempt the current execution priority.
+ *
+ * Exceptions with the same priority are taken in the order of their exception numbers.
+ *
+ * @param None
+ *
+ * @return The index of the exception in Sim_Exceptions, or -1 if there is none.
+ */
+static int32_t Sim_Next_Exception(void)
+{
+    int32_t next = -1;
+    uint8_t priority = Sim_Execution_Priority;
+    for (int32_t index = 0; index < SIM_EXCEPTION_COUNT; index++)
+    {
+        Sim_Exception_State *exception = &Sim_Exceptions[index];
+        if (exception->pending && exception->enabled && (exception->priority < priority))
+        {
+            next = index;
+            priority = exception->priority;
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief The Sim_Dispatch function executes the pending exceptions that are allowed by PRIMASK and the priorities.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Dispatch(void)
+{
+    Sim_Sync();
+    Sim_Port_Levels();
+    Sim_Observe();
+
+    while (!Sim_Primask)
+    {
+        int32_t index = Sim_Next_Exception();
+        if (index < 0)
+        {
+            break;
+        }
+
+        Sim_Exception_State *exception = &Sim_Exceptions[index];
+        uint8_t preempted = Sim_Execution_Priority;
+        exception->pending = 0;
+        exception->active = 1;
+        Sim_Execution_Priority = exception->priority;
+        if (exception->handler != 0)
+        {
+            exception->handler();
+        }
+
+        Sim_Execution_Priority = preempted;
+        exception->active = 0;
+
+        Sim_Sync();
+        Sim_Port_Levels();
+        Sim_Observe();
+    }
+}
+
+/**
+ * @brief The Sim_Divider function returns the number of HFXT cycles per MCLK cycle.
+ *
+ * @param None
+ *
+ * @return The MCLK divider (1, 2, 4, or 16).
+ */
+static uint32_t Sim_Divider(void)
+{
+    uint32_t divider = SIM_CLOCK_HZ / SystemCoreClock;
+    return (divider == 0) ? 1 : divider;
+}
+
+/**
+ * @brief The Sim_Cycles_Until function returns the number of MCLK cycles until a virtual time.
+ *
+ * @param time The virtual time.
+ *
+ * @return The number of MCLK cycles, rounded up and saturated to UINT32_MAX, or 0 if the time has passed.
+ */
+static uint32_t Sim_Cycles_Until(uint64_t time)
+{
+    if (time <= Sim_Time)
+    {
+        return 0;
+    }
+    uint64_t divider = Sim_Divider();
+    uint64_t cycles = (time - Sim_Time + divider - 1) / divider;
+    return (cycles > UINT32_MAX) ? UINT32_MAX : (uint32_t)cycles;
+}
+
+/**
+ * @brief The Sim_Cycles_To_SysTick function returns the number of MCLK cycles until SysTick reaches 0.
+ *
+ * @param None
+ *
+ * @return The number of MCLK cycles, or UINT32_MAX if SysTick is disabled.
+ */
+static uint32_t Sim_Cycles_To_SysTick(void)
+{
+    uint32_t reload = Sim_SysTick.LOAD & 0x00FFFFFF;
+    if (!(Sim_SysTick.CTRL & 0x01) || (reload == 0))
+    {
+        return UINT32_MAX;
+    }
+    // From 0, the counter reloads on the next cycle and counts LOAD cycles down to 0
+    return (SysTick_Count == 0) ? (reload + 1) : SysTick_Count;
+}
+
+/**
+ * @brief The Sim_Step function lets MCLK cycles elapse without crossing a SysTick underflow.
+ *
+ * @param cycles The number of MCLK cycles (at most Sim_Cycles_To_SysTick()).
+ *
+ * @return None
+ */
+static void Sim_Step(uint32_t cycles)
+{
+    if (cycles == 0)
+    {
+        return;
+    }
+
+    Sim_Time = Sim_Time + ((uint64_t)cycles * Sim_Divider());
+
+    if (Sim_SysTick.CTRL & 0x01)
+    {
+        uint32_t reload = Sim_SysTick.LOAD & 0x00FFFFFF;
+        uint32_t remaining = cycles;
+        if (SysTick_Count == 0)
+        {
+            SysTick_Count = reload;
+            remaining = remaining - 1;
+        }
+        SysTick_Count = SysTick_Count - remaining;
+        if ((SysTick_Count == 0) && (reload != 0))
+        {
+            Sim_SysTick.CTRL |= 0x00010000;       // COUNTFLAG
+            if (Sim_SysTick.CTRL & 0x02)
+            {
+                Sim_Exceptions[SIM_EXCEPTION(SysTick_IRQn)].pending = 1;
+            }
+        }
+    }
+
+    if (Sim_TIMER32_1.CONTROL & 0x80)
+    {
+        Timer32_Count = Timer32_Count - cycles;
+    }
+
+    if ((Sim_CoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (Sim_DWT.CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        Cycle_Count = Cycle_Count + cycles;
+    }
+
+    Sim_Sync();
+}
+
+/**
+ * @brief The Sim_Events function applies the stimuli that are due and ends the run at its end time.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Events(void)
+{
+    while (Sim_Current->next() <= Sim_Time)
+    {
+        Sim_Current->stimulus(Sim_Time);
+    }
+    if (Sim_Time >= Sim_End_Time)
+    {
+        Sim_Observe();
+        longjmp(Sim_Exit, 1);
+    }
+}
+
+/**
+ * @brief The Sim_Cycles_To_Event function returns the number of MCLK cycles until the next SysTick underflow,
+ * expiry of the HFXT start fault counter, stimulus, or the end of the run.
+ *
+ * @param None
+ *
+ * @return The number of MCLK cycles.
+ */
+static uint32_t Sim_Cycles_To_Event(void)
+{
+    uint32_t cycles = Sim_Cycles_To_SysTick();
+    uint32_t hfxt = Sim_Cycles_Until(Hfxt_Count_End);
+    uint32_t stimulus = Sim_Cycles_Until(Sim_Current->next());
+    uint32_t end = Sim_Cycles_Until(Sim_End_Time);
+    if ((hfxt != 0) && (hfxt < cycles))
+    {
+        cycles = hfxt;
+    }
+    if (stimulus < cycles)
+    {
+        cycles = stimulus;
+    }
+    if (end < cycles)
+    {
+        cycles = end;
+    }
+    // Sim_Cycles_Until rounds up, so the event time is always reached
+    return (cycles == 0) ? 1 : cycles;
+}
+
+void Sim_Run(const Sim_Scenario *scenario, uint64_t end_time)
+{
+    Sim_Current = scenario;
+    Sim_End_Time = end_time;
+
+    static void (* const handlers[SIM_EXCEPTION_COUNT])(void) =
+    {
+        [SIM_EXCEPTION(PendSV_IRQn)] = PendSV_Handler,
+        [SIM_EXCEPTION(SysTick_IRQn)] = SysTick_Handler,
+        [SIM_EXCEPTION(PSS_IRQn)] = PSS_IRQHandler,
+        [SIM_EXCEPTION(CS_IRQn)] = CS_IRQHandler,
+        [SIM_EXCEPTION(PCM_IRQn)] = PCM_IRQHandler,
+        [SIM_EXCEPTION(WDT_A_IRQn)] = WDT_A_IRQHandler,
+        [SIM_EXCEPTION(COMP_E0_IRQn)] = COMP_E0_IRQHandler,
+        [SIM_EXCEPTION(COMP_E1_IRQn)] = COMP_E1_IRQHandler,
+        [SIM_EXCEPTION(TA0_0_IRQn)] = TA0_0_IRQHandler,
+        [SIM_EXCEPTION(TA0_N_IRQn)] = TA0_N_IRQHandler,
+        [SIM_EXCEPTION(TA1_0_IRQn)] = TA1_0_IRQHandler,
+        [SIM_EXCEPTION(TA1_N_IRQn)] = TA1_N_IRQHandler,
+        [SIM_EXCEPTION(TA2_0_IRQn)] = TA2_0_IRQHandler,
+        [SIM_EXCEPTION(TA2_N_IRQn)] = TA2_N_IRQHandler,
+        [SIM_EXCEPTION(TA3_0_IRQn)] = TA3_0_IRQHandler,
+        [SIM_EXCEPTION(TA3_N_IRQn)] = TA3_N_IRQHandler,
+        [SIM_EXCEPTION(EUSCIA0_IRQn)] = EUSCIA0_IRQHandler,
+        [SIM_EXCEPTION(T32_INT1_IRQn)] = T32_INT1_IRQHandler,
+        [SIM_EXCEPTION(T32_INT2_IRQn)] = T32_INT2_IRQHandler,
+        [SIM_EXCEPTION(RTC_C_IRQn)] = RTC_C_IRQHandler,
+        [SIM_EXCEPTION(DMA_ERR_IRQn)] = DMA_ERR_IRQHandler,
+        [SIM_EXCEPTION(DMA_INT3_IRQn)] = DMA_INT3_IRQHandler,
+        [SIM_EXCEPTION(DMA_INT2_IRQn)] = DMA_INT2_IRQHandler,
+        [SIM_EXCEPTION(DMA_INT1_IRQn)] = DMA_INT1_IRQHandler,
+        [SIM_EXCEPTION(DMA_INT0_IRQn)] = DMA_INT0_IRQHandler,
+        [SIM_EXCEPTION(PORT1_IRQn)] = PORT1_IRQHandler,
+        [SIM_EXCEPTION(PORT2_IRQn)] = PORT2_IRQHandler
+    };
+    for (uint32_t index = 0; index < SIM_EXCEPTION_COUNT; index++)
+    {
+        Sim_Exceptions[index].handler = handlers[index];
+    }
+
+    // The system exceptions cannot be disabled in the NVIC
+    Sim_Exceptions[SIM_EXCEPTION(PendSV_IRQn)].enabled = 1;
+    Sim_Exceptions[SIM_EXCEPTION(SysTick_IRQn)].enabled = 1;
+
+    // Reset values of the registers that the program reads before writing
+    Sim_PCM.CTL0 = 0xA5960000;
+    Sim_CS.CTL1 = 0x00000033;
+    for (uint32_t index = 0; index < sizeof(Sim_INFO_Flash); index++)
+    {
+        Sim_INFO_Flash[index] = 0xFF;
+    }
+    Sim_Sync();
+    Sim_Observe();
+
+    if (setjmp(Sim_Exit) == 0)
+    {
+        Sim_Events();
+        Firmware_Main();
+    }
+}
+
+void Sim_Set_Inputs(uint8_t buttons, uint8_t switches)
+{
+    uint8_t old_input = SIM_P1->IN;
+    uint8_t new_input = (old_input & ~SIM_BUTTONS_MASK) | (buttons & SIM_BUTTONS_MASK);
+    SIM_WRITE_8(SIM_P1->IN, new_input);
+    SIM_WRITE_8(SIM_P10->IN, (SIM_P10->IN & ~SIM_SWITCHES_MASK) | (switches & SIM_SWITCHES_MASK));
+
+    // IES = 1 selects the high-to-low edge, IES = 0 the low-to-high edge
+    uint8_t falling = old_input & ~new_input;
+    uint8_t rising = ~old_input & new_input;
+    SIM_P1->IFG |= (falling & SIM_P1->IES) | (rising & ~SIM_P1->IES);
+    Sim_Port_Levels();
+}
+
+void Sim_Stop(void)
+{
+    Sim_End_Time = Sim_Time;
+}
+
+uint64_t Sim_Get_Time(void)
+{
+    return Sim_Time;
+}
+
+void Sim_Advance(uint32_t cycles)
+{
+    Sim_Sync();
+    while (cycles > 0)
+    {
+        uint32_t step = Sim_Cycles_To_Event();
+        if (step > cycles)
+        {
+            step = cycles;
+        }
+        Sim_Step(step);
+        cycles = cycles - step;
+        Sim_Events();
+        Sim_Dispatch();
+    }
+}
+
+void *Sim_Access(volatile void *peripheral)
+{
+    uintptr_t offset = (uintptr_t)peripheral - (uintptr_t)Sim_DIO;
+    if (offset < sizeof(Sim_DIO))
+    {
+        Sim_DIO_Accesses[offset] = Sim_DIO_Accesses[offset] + 1;
+    }
+    Sim_Sync();
+    return (void *)peripheral;
+}
+
+uint32_t Sim_Get_Port_Accesses(volatile void *port)
+{
+    uintptr_t offset = (uintptr_t)port - (uintptr_t)Sim_DIO;
+    return (offset < sizeof(Sim_DIO)) ? Sim_DIO_Accesses[offset] : 0;
+}
+
+void Sim_Clear_Port_Accesses(void)
+{
+    memset(Sim_DIO_Accesses, 0, sizeof(Sim_DIO_Accesses));
+}
+
+volatile uint32_t *Sim_Bitband(volatile void *address, uint32_t size, uint32_t bit)
+{
+    Sim_Bitband_Flush();
+
+    uint32_t value;
+    switch(size)
+    {
+        case 1:     value = *(volatile uint8_t *)address;   break;
+        case 2:     value = *(volatile uint16_t *)address;  break;
+        default:    value = *(volatile uint32_t *)address;
+    }
+    Bitband_Address = address;
+    Bitband_Size = size;
+    Bitband_Bit = bit;
+    Bitband_Word = (value >> bit) & 0x01;
+    return &Bitband_Word;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    Sim_Exceptions[SIM_EXCEPTION(irq)].enabled = 1;
+    Sim_Dispatch();
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+    if (irq >= 0)
+    {
+        Sim_Exceptions[SIM_EXCEPTION(irq)].enabled = 0;
+    }
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type irq)
+{
+    Sim_Exceptions[SIM_EXCEPTION(irq)].pending = 1;
+    Sim_Dispatch();
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq)
+{
+    Sim_Exceptions[SIM_EXCEPTION(irq)].pending = 0;
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority)
+{
+    // Only the top three bits of the priority byte are implemented
+    Sim_Exceptions[SIM_EXCEPTION(irq)].priority = (uint8_t)(priority & 0x07);
+}
+
+void __enable_irq(void)
+{
+    Sim_Primask = 0;
+    Sim_Dispatch();
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return Sim_Primask;
+}
+
+void __set_PRIMASK(uint32_t primask)
+{
+    Sim_Primask = (uint8_t)(primask & 0x01);
+    if (!Sim_Primask)
+    {
+        Sim_Dispatch();
+    }
+}
+
+void __disable_irq(void)
+{
+    Sim_Primask = 1;
+}
+
+void __WFI(void)
+{
+    Sim_Sync();
+    Sim_Port_Levels();
+    Sim_Observe();
+
+    // WFI returns when an interrupt that could preempt is pending, even while PRIMASK is set
+    while (Sim_Next_Exception() < 0)
+    {
+        Sim_Step(Sim_Cycles_To_Event());
+        Sim_Events();
+        Sim_Port_Levels();
+    }
+    if (!Sim_Primask)
+    {
+        Sim_Dispatch();
+    }
+}
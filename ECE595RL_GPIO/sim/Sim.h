@@ -0,0 +1,197 @@
+/**
+ * @file Sim.h
+ * @brief Header file for the host simulator of the GPIO program.
+ *
+ * This file contains the function definitions of the simulator core, which runs the unmodified
+ * GPIO program (GPIO_main.c, Clock.c, and the drivers in GPIO/) on the host against in-memory registers.
+ *
+ * Time is virtual and deterministic. It is counted in HFXT cycles (48 MHz), and it only advances when
+ * the program waits: in Clock_Delay1ms and Clock_Delay1us (through Sim_Advance), and in __WFI, which
+ * skips to the next SysTick interrupt or input change. Code between two waits takes no time, so the
+ * measured latencies are set by the tick, debouncing, and pattern logic, not by the host speed.
+ *
+ * The following peripherals are simulated:
+ *  - P1, P2, P9, and P10: the input pins (buttons and switches) are driven by the scenario, the output pins
+ *    (LED1, RGB LED, and PMOD 8LD) are reported to it, and the P1 edge interrupts are generated from IES/IE
+ *  - SysTick, Timer32_1, and the DWT cycle counter, clocked by MCLK (SystemCoreClock)
+ *  - NVIC: enable, pending, and preemption priorities of SysTick, PendSV, and the device interrupts
+ *    (including COMP_E0 and COMP_E1, which the Scheduler driver pends in software),
+ *    PRIMASK (__disable_irq/__enable_irq and __get_PRIMASK/__set_PRIMASK), and __WFI
+ *  - PCM: active mode requests complete immediately
+ *  - CS: the crystal never faults, and the HFXT start fault counter raises the CS interrupt when it expires
+ *  - Bit-band writes (BITBAND_PERI)
+ *  - CRC32: the 16-bit writes to DI32 are added to the CRC-32 signature (reflected polynomial 0xEDB88320,
+ *    low byte first) in INIRES32, which is seeded by writing INIRES32_LO and INIRES32_HI
+ *  - FLCTL: a sector erase of INFO sector 0 (Sim_INFO_Flash) completes immediately
+ *
+ * The other registers (Timer_A, Timer32_2, DMA, eUSCI_A0, RTC_C, WDT_A, RSTCTL, and the flash program
+ * registers) are plain memory: the program can configure them, but they never count, transfer,
+ * compute, or raise interrupts. The simulation build therefore disables the PMOD 8LD streaming and only
+ * supports the LPM0 idle mode (see the Makefile).
+ *
+ * A run is described by a Sim_Scenario, which provides the stimuli and receives the output changes.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdint.h>
+
+// Frequency of the virtual time base (HFXT)
+#define SIM_CLOCK_HZ            48000000
+
+// Conversions between milliseconds, microseconds, and virtual time
+#define SIM_MS(ms)              ((uint64_t)(ms) * (SIM_CLOCK_HZ / 1000))
+#define SIM_US(us)              ((uint64_t)(us) * (SIM_CLOCK_HZ / 1000000))
+#define SIM_TO_NS(time)         (((time) * 1000) / (SIM_CLOCK_HZ / 1000000))
+
+// Time of a stimulus that never occurs
+#define SIM_NEVER               UINT64_MAX
+
+// Level of the user buttons (P1.1 and P1.4) when both are released (pull-up resistors)
+#define SIM_BUTTONS_RELEASED    0x12
+
+/**
+ * @brief Sim_Outputs holds the levels of the output pins.
+ *
+ *  - led1:     LED1 (P1.0)
+ *  - rgb:      RGB LED (P2.0 - P2.2)
+ *  - pmod_8ld: PMOD 8LD (P9.0 - P9.7)
+ */
+typedef struct
+{
+    uint8_t led1;
+    uint8_t rgb;
+    uint8_t pmod_8ld;
+} Sim_Outputs;
+
+/**
+ * @brief Sim_Scenario describes the stimuli of a run and receives its outputs.
+ *
+ *  - next:     Returns the virtual time of the next stimulus, or SIM_NEVER if there is none
+ *  - stimulus: Applies the stimulus that is due (usually with Sim_Set_Inputs), called at the time returned by next
+ *  - output:   Called with the virtual time and the new levels whenever an output pin changes
+ */
+typedef struct
+{
+    uint64_t (*next)(void);
+    void (*stimulus)(uint64_t time);
+    void (*output)(uint64_t time, const Sim_Outputs *outputs);
+} Sim_Scenario;
+
+/**
+ * @brief The Sim_Run function runs the GPIO program until the virtual time reaches end_time or Sim_Stop is called.
+ *
+ * The program starts from reset (time 0) with the inputs set by Sim_Set_Inputs. Because the program keeps
+ * its state in static variables, Sim_Run can only be called once per process.
+ *
+ * @param scenario  A pointer to the scenario of the run.
+ * @param end_time  The virtual time at which the run stops.
+ *
+ * @return None
+ */
+void Sim_Run(const Sim_Scenario *scenario, uint64_t end_time);
+
+/**
+ * @brief The Sim_Set_Inputs function sets the level of the user buttons and the PMOD SWT switches.
+ *
+ * The P1 interrupt flags are set for the button edges selected by P1->IES.
+ *
+ * @param buttons   The level of P1.1 and P1.4 (SIM_BUTTONS_RELEASED when no button is pressed).
+ * @param switches  The level of P10.0 - P10.3.
+ *
+ * @return None
+ */
+void Sim_Set_Inputs(uint8_t buttons, uint8_t switches);
+
+/**
+ * @brief The Sim_Stop function ends the run at the current virtual time.
+ *
+ * It can be called from the callbacks of the scenario, for example once all samples have been measured.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Sim_Stop(void);
+
+/**
+ * @brief The Sim_Get_Time function returns the current virtual time.
+ *
+ * @param None
+ *
+ * @return The number of HFXT cycles since reset.
+ */
+uint64_t Sim_Get_Time(void);
+
+/**
+ * @brief The Sim_Advance function lets the given number of MCLK cycles elapse.
+ *
+ * The counters are advanced, and the interrupts that become pending are taken when PRIMASK allows it.
+ * Clock_DelayCycles calls this function instead of spinning on Timer32_1.
+ *
+ * @param cycles The number of MCLK cycles.
+ *
+ * @return None
+ */
+void Sim_Advance(uint32_t cycles);
+
+/**
+ * @brief The Sim_Access function is called on every access to a peripheral.
+ *
+ * It applies the pending bit-band write and updates the counter and status registers from the virtual time.
+ * The accesses to the ports are counted for Sim_Get_Port_Accesses.
+ *
+ * @param peripheral A pointer to the memory of the peripheral.
+ *
+ * @return The same pointer.
+ */
+void *Sim_Access(volatile void *peripheral);
+
+/**
+ * @brief The Sim_Get_Port_Accesses function returns the number of accesses to the registers of a port.
+ *
+ * An access is one call to Sim_Access with the address of the port, so a read-modify-write of one register
+ * through a pointer that was obtained once counts as one access.
+ *
+ * @param port A pointer to the registers of the port, for example GPIO_PINS_REGISTERS(7).
+ *
+ * @return The number of accesses since the last call to Sim_Clear_Port_Accesses.
+ */
+uint32_t Sim_Get_Port_Accesses(volatile void *port);
+
+/**
+ * @brief The Sim_Clear_Port_Accesses function clears the access counts of every port.
+ *
+ * @param None
+ *
+ * @return None
+ */
+void Sim_Clear_Port_Accesses(void);
+
+/**
+ * @brief The Sim_Bitband function returns the bit-band alias of one bit of a peripheral register.
+ *
+ * The alias is a shadow word that holds the current value of the bit. A value written to it is copied
+ * to the register bit on the next peripheral access.
+ *
+ * @param address   A pointer to the register.
+ * @param size      The size of the register in bytes (1, 2, or 4).
+ * @param bit       The bit number.
+ *
+ * @return A pointer to the alias word.
+ */
+volatile uint32_t *Sim_Bitband(volatile void *address, uint32_t size, uint32_t bit);
+
+/**
+ * @brief The Firmware_Main function is the main function of GPIO_main.c, renamed by the simulation build.
+ *
+ * @param None
+ *
+ * @return Never returns.
+ */
+int Firmware_Main(void);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,617 @@
+/**
+ * @file Sim_check.c
+ * @brief Main source code for the driver checks of the host simulation.
+ *
+ * This file calls the drivers of the GPIO program directly against the simulated registers (Sim.c),
+ * without running the program, and checks the paths that the latency harness (Sim_main.c) does not reach:
+ *  - ConfigStore: the updates (ConfigStore_Begin, ConfigStore_Write, and ConfigStore_Commit), the validation
+ *    by ConfigStore_Init, the erase of a full sector, and the recovery from corrupted or unknown content
+ *  - LED_Step: the packed field layout, and the steps of the LED_Pattern_2 and LED_Pattern_3 counters generated
+ *    by LED_STEPS_256, LED_STEPS_N, and LED_STEP_COUNTER against the values of the former procedural patterns
+ *  - PMOD: the values exchanged by PMOD_Bus_Set, PMOD_Bus_Write, PMOD_Bus_Read, and PMOD_Bus_Get, and one access
+ *    per port for every write and read of the bus
+ *  - PMOD_8LD_BCM: the Timer_A2 configuration, the reload value and the P9 value of every bit plane, the on-time
+ *    of every LED over a frame, the buffer swap at the start of a frame, and the stop
+ *
+ * Usage: GPIO_check
+ *
+ * Every failed check is printed, and the program exits with status 1 if any check failed.
+ * Reads outside the simulated INFO sector are reported when the checks are built with AddressSanitizer:
+ * make check CFLAGS="-O1 -g -fsanitize=address"
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "msp.h"
+#include "Sim.h"
+#include "../inc/ConfigStore.h"
+#include "../inc/Debounce.h"
+#include "../inc/LED_Step.h"
+#include "../inc/GPIO_Pins.h"
+#include "../inc/PMOD.h"
+#include "../inc/PMOD_8LD_BCM.h"
+
+// Interrupt handler of the BCM engine, called directly since Timer_A2 is not simulated
+void TA2_0_IRQHandler(void);
+
+// Records a failure when a condition is false
+#define SIM_CHECK(condition)    Sim_Check((condition) ? 1 : 0, #condition, __LINE__)
+
+// Size of the data of the test configurations: Config_Data and two steps
+#define SIM_CONFIG_STEPS        2
+#define SIM_CONFIG_LENGTH       (sizeof(Config_Data) + (SIM_CONFIG_STEPS * sizeof(LED_Step)))
+
+// Size of a test record in the sector: header, commit word, and data padded to a flash word
+#define SIM_RECORD_SIZE         (32 + ((SIM_CONFIG_LENGTH + CONFIG_STORE_CHUNK - 1) & ~(CONFIG_STORE_CHUNK - 1)))
+
+static uint32_t Sim_Checks = 0;
+static uint32_t Sim_Failures = 0;
+
+/**
+ * @brief The Sim_Check function counts a check and prints it if it failed.
+ *
+ * @param passed    1 if the condition is true, 0 otherwise.
+ * @param condition The text of the condition.
+ * @param line      The line of the check.
+ *
+ * @return None
+ */
+static void Sim_Check(uint8_t passed, const char *condition, int line)
+{
+    Sim_Checks = Sim_Checks + 1;
+    if (!passed)
+    {
+        Sim_Failures = Sim_Failures + 1;
+        printf("FAIL Sim_check.c:%d: %s\n", line, condition);
+    }
+}
+
+/**
+ * @brief The Sim_Erase_Flash function erases the simulated INFO sector.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Erase_Flash(void)
+{
+    memset(Sim_INFO_Flash, 0xFF, sizeof(Sim_INFO_Flash));
+}
+
+/**
+ * @brief The Sim_Make_Config function fills a test configuration with one pattern of two steps.
+ *
+ * @param buffer    A buffer of at least SIM_CONFIG_LENGTH bytes, aligned to 32 bits.
+ * @param marker    The PMOD 8LD value of the first step, which identifies the configuration.
+ *
+ * @return A pointer to the configuration in the buffer.
+ */
+static Config_Data *Sim_Make_Config(uint32_t *buffer, uint8_t marker)
+{
+    Config_Data *config = (Config_Data *)buffer;
+    memset(buffer, 0, SIM_CONFIG_LENGTH);
+    config->idle_clock_hz = 12000000;
+    config->debounce_samples = 4;
+    config->pattern_count = 1;
+    config->step_count = SIM_CONFIG_STEPS;
+    config->patterns[0].switch_status = 0x05;
+    config->patterns[0].step_count = SIM_CONFIG_STEPS;
+    config->steps[0] = LED_STEP(1, 0x04, marker, 100);
+    config->steps[1] = LED_STEP(0, 0x00, 0x00, 100);
+    return config;
+}
+
+/**
+ * @brief The Sim_Update function writes a configuration with ConfigStore_Begin, ConfigStore_Write, and ConfigStore_Commit.
+ *
+ * @param data      A pointer to the data of the record.
+ * @param length    The length of the data in bytes.
+ * @param commit    1 to commit the record, 0 to leave it uncommitted.
+ *
+ * @return The result of the first call that failed, or CONFIG_STORE_OK.
+ */
+static uint8_t Sim_Update(const void *data, uint16_t length, uint8_t commit)
+{
+    uint8_t result = ConfigStore_Begin(length);
+    if (result != CONFIG_STORE_OK)
+    {
+        return result;
+    }
+
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (uint16_t offset = 0; offset < length; offset = offset + CONFIG_STORE_CHUNK)
+    {
+        uint8_t chunk[CONFIG_STORE_CHUNK];
+        memset(chunk, 0xFF, sizeof(chunk));
+        memcpy(chunk, &bytes[offset], ((length - offset) < CONFIG_STORE_CHUNK) ? (length - offset) : CONFIG_STORE_CHUNK);
+        result = ConfigStore_Write(offset, chunk);
+        if (result != CONFIG_STORE_OK)
+        {
+            return result;
+        }
+    }
+    return commit ? ConfigStore_Commit() : CONFIG_STORE_OK;
+}
+
+/**
+ * @brief The Sim_Marker function returns the PMOD 8LD value of the first step of a configuration.
+ *
+ * @param config A pointer to the configuration, or 0.
+ *
+ * @return The marker of the configuration, or -1 if config is 0.
+ */
+static int32_t Sim_Marker(const Config_Data *config)
+{
+    return (config != 0) ? LED_STEP_PMOD_8LD(config->steps[0]) : -1;
+}
+
+/**
+ * @brief The Sim_Check_CRC32 function checks the CRC32 model against the CRC-32 check value of "12345678".
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_CRC32(void)
+{
+    static const uint8_t data[8] = { '1', '2', '3', '4', '5', '6', '7', '8' };
+
+    CRC32->INIRES32_LO = 0xFFFF;
+    CRC32->INIRES32_HI = 0xFFFF;
+    for (uint32_t index = 0; index < sizeof(data); index = index + 2)
+    {
+        CRC32->DI32 = (uint16_t)(data[index] | (data[index + 1] << 8));
+    }
+    uint32_t crc = ((uint32_t)CRC32->INIRES32_HI << 16) | CRC32->INIRES32_LO;
+
+    // The CRC-32 of the data is 0x9AE0DAAF, which includes the final inversion that the module does not apply
+    SIM_CHECK(crc == 0x651F2550);
+}
+
+/**
+ * @brief The Sim_Check_Updates function checks an empty sector, committed updates, and the rejected updates.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_Updates(void)
+{
+    uint32_t buffer[64];
+    ConfigStore_Status status;
+
+    Sim_Erase_Flash();
+    SIM_CHECK(ConfigStore_Init() == 0);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.loaded == 0) && (status.sequence == 0) && (status.free_offset == 0) && (status.erase_count == 0));
+
+    // A new configuration is used after the next reset
+    Config_Data *config = Sim_Make_Config(buffer, 0x11);
+    SIM_CHECK(Sim_Update(config, SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_OK);
+    SIM_CHECK(ConfigStore_Get() == 0);
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0x11);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.loaded == 1) && (status.sequence == 1) && (status.length == SIM_CONFIG_LENGTH));
+    SIM_CHECK(status.free_offset == SIM_RECORD_SIZE);
+    SIM_CHECK(memcmp(ConfigStore_Get(), config, SIM_CONFIG_LENGTH) == 0);
+
+    // Every update is appended after the last one
+    for (uint8_t marker = 0x12; marker <= 0x14; marker++)
+    {
+        SIM_CHECK(Sim_Update(Sim_Make_Config(buffer, marker), SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_OK);
+    }
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0x14);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.sequence == 4) && (status.free_offset == (4 * SIM_RECORD_SIZE)));
+
+    // The lengths, the order of the chunks, and the state of the update are checked
+    SIM_CHECK(ConfigStore_Begin(0) == CONFIG_STORE_BAD_LENGTH);
+    SIM_CHECK(ConfigStore_Begin(SIM_CONFIG_LENGTH + 2) == CONFIG_STORE_BAD_LENGTH);
+    SIM_CHECK(ConfigStore_Begin(CONFIG_STORE_MAX_LENGTH + 4) == CONFIG_STORE_BAD_LENGTH);
+    SIM_CHECK(ConfigStore_Write(0, (const uint8_t *)buffer) == CONFIG_STORE_BAD_STATE);
+    SIM_CHECK(ConfigStore_Commit() == CONFIG_STORE_BAD_STATE);
+    SIM_CHECK(ConfigStore_Begin(SIM_CONFIG_LENGTH) == CONFIG_STORE_OK);
+    SIM_CHECK(ConfigStore_Write(CONFIG_STORE_CHUNK, (const uint8_t *)buffer) == CONFIG_STORE_BAD_LENGTH);
+    SIM_CHECK(ConfigStore_Write(0, (const uint8_t *)buffer) == CONFIG_STORE_OK);
+    SIM_CHECK(ConfigStore_Commit() == CONFIG_STORE_BAD_STATE);
+
+    // An invalid configuration is left uncommitted
+    config = Sim_Make_Config(buffer, 0x15);
+    config->patterns[0].step_count = 1;
+    SIM_CHECK(Sim_Update(config, SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_INVALID);
+    config = Sim_Make_Config(buffer, 0x16);
+    config->debounce_samples = DEBOUNCE_MAX_SAMPLES + 1;
+    SIM_CHECK(Sim_Update(config, SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_INVALID);
+    config = Sim_Make_Config(buffer, 0x17);
+    config->idle_clock_hz = 6000000;
+    SIM_CHECK(Sim_Update(config, SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_INVALID);
+
+    // An update that was not committed, for example after a reset, is skipped
+    SIM_CHECK(Sim_Update(Sim_Make_Config(buffer, 0x18), SIM_CONFIG_LENGTH, 0) == CONFIG_STORE_OK);
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0x14);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.sequence == 4) && (status.free_offset == (9 * SIM_RECORD_SIZE)));
+}
+
+/**
+ * @brief The Sim_Check_Erase function checks that a full sector is erased by the update that does not fit.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_Erase(void)
+{
+    uint32_t buffer[64];
+    ConfigStore_Status status;
+
+    Sim_Erase_Flash();
+    ConfigStore_Init();
+    uint32_t count = CONFIG_STORE_SIZE / SIM_RECORD_SIZE;
+    for (uint32_t index = 0; index < count; index++)
+    {
+        SIM_CHECK(Sim_Update(Sim_Make_Config(buffer, (uint8_t)index), SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_OK);
+    }
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == (int32_t)(count - 1));
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.erase_count == 0) && (status.free_offset == (count * SIM_RECORD_SIZE)));
+
+    // The configuration found at boot is invalidated by the erase
+    SIM_CHECK(Sim_Update(Sim_Make_Config(buffer, 0xA0), SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_OK);
+    SIM_CHECK(ConfigStore_Get() == 0);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.loaded == 0) && (status.erase_count == 1) && (status.free_offset == SIM_RECORD_SIZE));
+
+    // The sequence number and the erase count continue after the erase
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0xA0);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.sequence == (count + 1)) && (status.erase_count == 1));
+}
+
+/**
+ * @brief The Sim_Check_Corruption function checks the recovery from corrupted records and unknown content.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_Corruption(void)
+{
+    uint32_t buffer[64];
+    ConfigStore_Status status;
+
+    // A corrupted last record falls back to the record before it
+    Sim_Erase_Flash();
+    ConfigStore_Init();
+    SIM_CHECK(Sim_Update(Sim_Make_Config(buffer, 0x21), SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_OK);
+    SIM_CHECK(Sim_Update(Sim_Make_Config(buffer, 0x22), SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_OK);
+    Sim_INFO_Flash[SIM_RECORD_SIZE + 32 + 8] ^= 0x01;
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0x21);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.loaded == 1) && (status.sequence == 2) && (status.free_offset == (2 * SIM_RECORD_SIZE)));
+
+    // Unknown content after the records is kept, and the next update erases the sector.
+    // The header has a length that reaches past the sector and a valid commit word, so the records
+    // are only found if the fallback stops at the end of the valid records.
+    uint32_t garbage[8] = { 0x12345678, 0x0000FFF0, 0, 0, 0x5A5A5A5A, 0xA5A5A5A5, 0, 0 };
+    memcpy(&Sim_INFO_Flash[2 * SIM_RECORD_SIZE], garbage, sizeof(garbage));
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0x21);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.sequence == 2) && (status.free_offset == CONFIG_STORE_SIZE));
+
+    // A valid magic number with a length that does not fit is unknown content as well
+    garbage[0] = 0x31474643;
+    garbage[1] = CONFIG_STORE_MAX_LENGTH + 16;
+    memcpy(&Sim_INFO_Flash[2 * SIM_RECORD_SIZE], garbage, sizeof(garbage));
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0x21);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK(status.free_offset == CONFIG_STORE_SIZE);
+
+    SIM_CHECK(Sim_Update(Sim_Make_Config(buffer, 0x23), SIM_CONFIG_LENGTH, 1) == CONFIG_STORE_OK);
+    SIM_CHECK(Sim_Marker(ConfigStore_Init()) == 0x23);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.sequence == 3) && (status.erase_count == 1) && (status.free_offset == SIM_RECORD_SIZE));
+
+    // Without a valid record, there is no configuration
+    Sim_INFO_Flash[32 + 8] ^= 0x01;
+    SIM_CHECK(ConfigStore_Init() == 0);
+    ConfigStore_Get_Status(&status);
+    SIM_CHECK((status.loaded == 0) && (status.sequence == 3));
+}
+
+/**
+ * @brief The Sim_Check_Step_Layout function checks the packed LED_Step layout and the field accessors.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_Step_Layout(void)
+{
+    static const LED_Step steps[] =
+    {
+        LED_STEP(1, 0x5, 0xA5, 0xBEEF),
+        LED_STEP(0x03, 0x0F, 0x1FF, 0x1FFFF)
+    };
+
+    //  duration_ms (31 - 16), PMOD 8LD (15 - 8), 0 (7 - 4), RGB LED (3 - 1), LED1 (0)
+    SIM_CHECK(steps[0] == 0xBEEFA50B);
+    SIM_CHECK(LED_STEP_LED1(steps[0]) == 1);
+    SIM_CHECK(LED_STEP_RGB(steps[0]) == 0x5);
+    SIM_CHECK(LED_STEP_PMOD_8LD(steps[0]) == 0xA5);
+    SIM_CHECK(LED_STEP_DURATION_MS(steps[0]) == 0xBEEF);
+
+    // A value wider than its field does not spill into the next field
+    SIM_CHECK(steps[1] == 0xFFFFFF0F);
+    SIM_CHECK(LED_STEP_LED1(steps[1]) == 1);
+    SIM_CHECK(LED_STEP_RGB(steps[1]) == 0x7);
+    SIM_CHECK(LED_STEP_PMOD_8LD(steps[1]) == 0xFF);
+    SIM_CHECK(LED_STEP_DURATION_MS(steps[1]) == 0xFFFF);
+}
+
+/**
+ * @brief The Sim_Check_Counter function compares a generated counter with the steps of a procedural counter.
+ *
+ * @param steps         The generated steps.
+ * @param count         The number of generated steps.
+ * @param led1_value    The LED1 value of every step.
+ * @param rgb_value     The RGB LED value of every step.
+ * @param start         The first PMOD 8LD value.
+ * @param end           The last PMOD 8LD value.
+ * @param step          The difference between the PMOD 8LD values of consecutive steps.
+ * @param duration_ms   The duration of every step.
+ *
+ * @return None
+ */
+static void Sim_Check_Counter(const LED_Step *steps, uint32_t count, uint8_t led1_value, uint8_t rgb_value,
+                              int32_t start, int32_t end, int32_t step, uint16_t duration_ms)
+{
+    // The counter written as the loop of the procedural patterns
+    uint32_t index = 0;
+    uint8_t passed = 1;
+    int32_t direction = (end >= start) ? step : -step;
+    for (int32_t value = start; (direction > 0) ? (value <= end) : (value >= end); value = value + direction)
+    {
+        if ((index >= count) || (steps[index] != LED_STEP(led1_value, rgb_value, value, duration_ms)))
+        {
+            passed = 0;
+            break;
+        }
+        index = index + 1;
+    }
+    SIM_CHECK(passed);
+    SIM_CHECK(index == count);
+    SIM_CHECK(count == (uint32_t)LED_COUNTER_LENGTH(start, end, step));
+}
+
+/**
+ * @brief The Sim_Check_Step_Generators function checks the steps generated for the counter patterns.
+ *
+ * The arguments are those of LED_Pattern_2 (LED1 on, red, 0x00 up to 0xFF) and LED_Pattern_3
+ * (LED1 off, blue, 0xFF down to 0x00) in GPIO_main.c, with 100 ms per count.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_Step_Generators(void)
+{
+    static const LED_Step up_256[] = { LED_STEPS_256(LED_STEP_COUNTER, 1, 0x01, 0x00, 0xFF, 1, 100) };
+    static const LED_Step up_n[] = { LED_STEPS_N(16, 0, LED_STEP_COUNTER, 1, 0x01, 0x00, 0xFF, 1, 100) };
+    static const LED_Step down_n[] = { LED_STEPS_N(16, 0, LED_STEP_COUNTER, 0, 0x04, 0xFF, 0x00, 1, 100) };
+    static const LED_Step partial[] = { LED_STEPS_N(1, 1, LED_STEP_COUNTER, 1, 0x01, 0x10, 0x40, 3, 100) };
+    static const LED_Step rest_only[] = { LED_STEPS_N(0, 15, LED_STEP_COUNTER, 0, 0x02, 0x20, 0x12, 1, 50) };
+    static const uint8_t frames[] = { LED_STEPS_N(16, 0, LED_STEP_COUNTER_VALUE, 0xFF, 0x00, 1) };
+
+    Sim_Check_Counter(up_256, sizeof(up_256) / sizeof(LED_Step), 1, 0x01, 0x00, 0xFF, 1, 100);
+    Sim_Check_Counter(up_n, sizeof(up_n) / sizeof(LED_Step), 1, 0x01, 0x00, 0xFF, 1, 100);
+    Sim_Check_Counter(down_n, sizeof(down_n) / sizeof(LED_Step), 0, 0x04, 0xFF, 0x00, 1, 100);
+    Sim_Check_Counter(partial, sizeof(partial) / sizeof(LED_Step), 1, 0x01, 0x10, 0x40, 3, 100);
+    Sim_Check_Counter(rest_only, sizeof(rest_only) / sizeof(LED_Step), 0, 0x02, 0x20, 0x12, 1, 50);
+
+    // The streamed frames hold the PMOD 8LD values of the steps
+    uint8_t passed = (sizeof(frames) == 256);
+    for (uint32_t index = 0; passed && (index < sizeof(frames)); index++)
+    {
+        passed = (frames[index] == LED_STEP_PMOD_8LD(down_n[index]));
+    }
+    SIM_CHECK(passed);
+}
+
+/**
+ * @brief The Sim_Check_PMOD_Bus function checks the values and the register accesses of a PMOD bus.
+ *
+ * Two nibble-wide output PMODs share P7, and a nibble-wide input PMOD and a nibble-wide output PMOD share P8.
+ * P7 is written with a single store, and P8 with a read-modify-write that keeps the OUT bits of the input pins.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_PMOD_Bus(void)
+{
+    static const PMOD_Device devices[] =
+    {
+        PMOD_DEVICE_NIBBLE(7, PMOD_NIBBLE_LOW, PMOD_OUTPUT),
+        PMOD_DEVICE_NIBBLE(7, PMOD_NIBBLE_HIGH, PMOD_OUTPUT),
+        PMOD_DEVICE_NIBBLE(8, PMOD_NIBBLE_LOW, PMOD_INPUT),
+        PMOD_DEVICE_NIBBLE(8, PMOD_NIBBLE_HIGH, PMOD_OUTPUT)
+    };
+    PMOD_Bus bus;
+    DIO_PORT_Odd_Type *p7 = GPIO_PINS_REGISTERS(7);
+    DIO_PORT_Odd_Type *p8 = GPIO_PINS_REGISTERS(8);
+
+    // The pull-up resistors of the P8 inputs are selected by P8->OUT
+    p7->OUT = 0x00;
+    p8->OUT = 0x0F;
+    SIM_CHECK(PMOD_Bus_Init(&bus, devices, PMOD_DEVICE_COUNT(devices)) == 1);
+    SIM_CHECK(bus.port_count == 2);
+
+    // Every device is set, and each port is written once
+    PMOD_Bus_Set(&bus, 0, 0x0A);
+    PMOD_Bus_Set(&bus, 1, 0x05);
+    PMOD_Bus_Set(&bus, 3, 0x1C);
+    Sim_Clear_Port_Accesses();
+    PMOD_Bus_Write(&bus);
+    SIM_CHECK(Sim_Get_Port_Accesses(p7) == 1);
+    SIM_CHECK(Sim_Get_Port_Accesses(p8) == 1);
+    SIM_CHECK(p7->OUT == 0x5A);
+    SIM_CHECK(p8->OUT == 0xCF);
+
+    // Only the port with a device that was set is written
+    PMOD_Bus_Set(&bus, 1, 0x03);
+    Sim_Clear_Port_Accesses();
+    PMOD_Bus_Write(&bus);
+    SIM_CHECK(Sim_Get_Port_Accesses(p7) == 1);
+    SIM_CHECK(Sim_Get_Port_Accesses(p8) == 0);
+    SIM_CHECK(p7->OUT == 0x3A);
+
+    // Nothing is written without a new value
+    Sim_Clear_Port_Accesses();
+    PMOD_Bus_Write(&bus);
+    SIM_CHECK(Sim_Get_Port_Accesses(p7) == 0);
+    SIM_CHECK(Sim_Get_Port_Accesses(p8) == 0);
+
+    // Only the port with an input device is read, once, and the value is masked to the device
+    *(volatile uint8_t *)&p8->IN = 0xB6;
+    Sim_Clear_Port_Accesses();
+    PMOD_Bus_Read(&bus);
+    SIM_CHECK(Sim_Get_Port_Accesses(p7) == 0);
+    SIM_CHECK(Sim_Get_Port_Accesses(p8) == 1);
+    SIM_CHECK(PMOD_Bus_Get(&bus, 2) == 0x06);
+
+    // Get and Set only access the values stored in the bus
+    Sim_Clear_Port_Accesses();
+    uint8_t value = PMOD_Bus_Get(&bus, 2);
+    PMOD_Bus_Set(&bus, 0, value);
+    SIM_CHECK(Sim_Get_Port_Accesses(p7) == 0);
+    SIM_CHECK(Sim_Get_Port_Accesses(p8) == 0);
+
+    // Two devices that share a pin are rejected
+    static const PMOD_Device overlapping[] =
+    {
+        PMOD_DEVICE_8(7, PMOD_OUTPUT),
+        PMOD_DEVICE_NIBBLE(7, PMOD_NIBBLE_HIGH, PMOD_INPUT)
+    };
+    SIM_CHECK(PMOD_Bus_Init(&bus, overlapping, PMOD_DEVICE_COUNT(overlapping)) == 0);
+    SIM_CHECK(bus.port_count == 0);
+}
+
+/**
+ * @brief The Sim_BCM_Frame function runs the BCM interrupt for one frame and checks every bit plane.
+ *
+ * Every interrupt must display bit k of each brightness on P9 and load the duration of plane k (2^k units)
+ * into CCR0. The on-time of every LED is summed over the frame and must equal its brightness in units.
+ *
+ * @param brightness The brightness values that the frame must display.
+ *
+ * @return None
+ */
+static void Sim_BCM_Frame(const uint8_t brightness[8])
+{
+    uint32_t on_units[8] = { 0 };
+
+    for (uint8_t plane = 0; plane < 8; plane++)
+    {
+        TIMER_A2->CCTL[0] |= 0x0001;
+        TA2_0_IRQHandler();
+        SIM_CHECK((TIMER_A2->CCTL[0] & 0x0001) == 0);
+
+        uint32_t period = (uint32_t)TIMER_A2->CCR[0] + 1;
+        SIM_CHECK(period == ((uint32_t)PMOD_8LD_BCM_UNIT << plane));
+
+        uint8_t expected = 0;
+        for (uint8_t led = 0; led < 8; led++)
+        {
+            expected |= ((brightness[led] >> plane) & 0x01) << led;
+            if (P9->OUT & (1 << led))
+            {
+                on_units[led] = on_units[led] + (period / PMOD_8LD_BCM_UNIT);
+            }
+        }
+        SIM_CHECK(P9->OUT == expected);
+    }
+
+    for (uint8_t led = 0; led < 8; led++)
+    {
+        SIM_CHECK(on_units[led] == brightness[led]);
+    }
+}
+
+/**
+ * @brief The Sim_Check_BCM function checks the Timer_A2 configuration, the bit planes, and the buffer swap of the BCM engine.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_BCM(void)
+{
+    static const uint8_t off[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    static const uint8_t first[8] = { 0, 1, 2, 127, 128, 200, 254, 255 };
+    static const uint8_t second[8] = { 255, 128, 64, 32, 16, 8, 4, 2 };
+
+    // Stopped, SMCLK, and the duration of the first plane
+    PMOD_8LD_BCM_Init(0);
+    SIM_CHECK(TIMER_A2->CTL == 0x0204);
+    SIM_CHECK(TIMER_A2->CCR[0] == PMOD_8LD_BCM_UNIT - 1);
+    SIM_CHECK(TIMER_A2->CCTL[0] == 0x0010);
+
+    // Up mode
+    PMOD_8LD_BCM_Set(first);
+    PMOD_8LD_BCM_Start();
+    SIM_CHECK(TIMER_A2->CTL == 0x0214);
+    SIM_CHECK(TIMER_A2->CCR[0] == PMOD_8LD_BCM_UNIT - 1);
+    Sim_BCM_Frame(first);
+    Sim_BCM_Frame(first);
+
+    // A brightness set during a frame is displayed from the next frame
+    TIMER_A2->CCTL[0] |= 0x0001;
+    TA2_0_IRQHandler();
+    TA2_0_IRQHandler();
+    PMOD_8LD_BCM_Set(second);
+    for (uint8_t plane = 2; plane < 8; plane++)
+    {
+        uint8_t expected = 0;
+        for (uint8_t led = 0; led < 8; led++)
+        {
+            expected |= ((first[led] >> plane) & 0x01) << led;
+        }
+        TA2_0_IRQHandler();
+        SIM_CHECK(P9->OUT == expected);
+    }
+    Sim_BCM_Frame(second);
+
+    // The last brightness set before a frame is displayed
+    PMOD_8LD_BCM_Set(first);
+    PMOD_8LD_BCM_Set(off);
+    Sim_BCM_Frame(off);
+
+    // Stopped with every LED off, and restarted from the first plane
+    PMOD_8LD_BCM_Set(second);
+    TA2_0_IRQHandler();
+    PMOD_8LD_BCM_Stop();
+    SIM_CHECK(TIMER_A2->CTL == 0x0204);
+    SIM_CHECK(P9->OUT == 0x00);
+    PMOD_8LD_BCM_Start();
+    Sim_BCM_Frame(second);
+    PMOD_8LD_BCM_Stop();
+}
+
+int main(void)
+{
+    Sim_Check_CRC32();
+    Sim_Check_Updates();
+    Sim_Check_Erase();
+    Sim_Check_Corruption();
+    Sim_Check_Step_Layout();
+    Sim_Check_Step_Generators();
+    Sim_Check_PMOD_Bus();
+    Sim_Check_BCM();
+
+    printf("Checks: %u  Failures: %u\n", (unsigned)Sim_Checks, (unsigned)Sim_Failures);
+    return (Sim_Failures == 0) ? 0 : 1;
+}
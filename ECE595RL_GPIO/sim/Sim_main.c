@@ -0,0 +1,611 @@
+/**
+ * @file Sim_main.c
+ * @brief Main source code for the host simulation of the GPIO program.
+ *
+ * This file runs the GPIO program in the simulator (Sim.c) and measures the pattern latency: the virtual time
+ * from an input change to the moment the outputs show the first step of the pattern selected by the new inputs.
+ * The latency includes the debouncing, the wait for the tick that commits the frame, and the pattern logic.
+ *
+ * Once the first step is displayed, every later output change is checked against the step table of the pattern:
+ * it must show the next step with different outputs, exactly the sum of the durations (LED_STEP_DURATION_MS)
+ * of the steps since the last change after that change. The outputs of a held step (duration of 0) must not change.
+ * The output changes made at the same virtual time are checked together, as one change.
+ *
+ * Usage: GPIO_sim [-n samples] [-s seed] [-f file] [-m max_us] [-l]
+ *  - -n samples:   Number of random input changes, each followed by a return to the base inputs (default 1000)
+ *  - -s seed:      Seed of the random input sequence (default 1)
+ *  - -f file:      Replay the input changes of a file instead of a random sequence
+ *  - -m max_us:    Fail if a latency exceeds max_us microseconds
+ *  - -l:           Print every output change
+ *
+ * In random mode, every sample starts from the base inputs (all switches off, no button pressed), applies one
+ * of the other input combinations at a random time, and returns to the base inputs after a random hold time.
+ * Both changes are measured. A replay file contains one input change per line, in increasing order of time:
+ *
+ *      # time_ms   switches    buttons
+ *      100         0x01        0x12
+ *      350         0x00        0x10
+ *
+ * The buttons are given as the level of P1.1 and P1.4 (0x12 when no button is pressed). The program exits with
+ * status 1 if an expected pattern is not displayed within 100 ms, if a step is displayed out of sequence or at
+ * the wrong time, or if a latency exceeds max_us.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Sim.h"
+#include "../inc/LED_Step.h"
+
+// Number of the patterns that can be selected (see LED_Pattern_Table in GPIO_main.c)
+#define SIM_PATTERN_COUNT       8
+
+// Time after which an expected pattern that is not displayed is counted as a failure
+#define SIM_TIMEOUT             SIM_MS(100)
+
+// Time between reset and the first input change
+#define SIM_START_TIME          SIM_MS(100)
+
+// Random hold time of the inputs in random mode: 20 ms plus up to 100 ms
+#define SIM_HOLD_MIN            SIM_MS(20)
+#define SIM_HOLD_RANGE          SIM_MS(100)
+
+// Maximum number of input changes in a replay file and of measured samples per pattern
+#define SIM_MAX_STIMULI         65536
+#define SIM_MAX_SAMPLES         65536
+
+// Number of steps of the binary counters of Pattern_2 and Pattern_3
+#define SIM_COUNTER_STEPS       256
+
+// Expected steps of every pattern, written from the pattern descriptions in GPIO_main.c
+static const LED_Step Sim_Pattern_1_Released[] = { LED_STEP(0, 0x02, 0xFF, 0) };
+static const LED_Step Sim_Pattern_1_Button_1[] = { LED_STEP(1, 0x00, 0x55, 0) };
+static const LED_Step Sim_Pattern_1_Button_2[] = { LED_STEP(0, 0x05, 0xAA, 0) };
+static const LED_Step Sim_Pattern_1_Both[] = { LED_STEP(1, 0x04, 0x00, 500), LED_STEP(0, 0x00, 0x00, 500) };
+static const LED_Step Sim_Pattern_4[] = { LED_STEP(1, 0x02, 0xFF, 500), LED_STEP(0, 0x00, 0x00, 500) };
+static const LED_Step Sim_Pattern_5[] =
+{
+    LED_STEP(0, 0x00, 0x01, 500), LED_STEP(0, 0x00, 0x02, 500), LED_STEP(0, 0x00, 0x04, 500), LED_STEP(0, 0x00, 0x08, 500),
+    LED_STEP(0, 0x00, 0x10, 500), LED_STEP(0, 0x00, 0x20, 500), LED_STEP(0, 0x00, 0x40, 500), LED_STEP(0, 0x00, 0x80, 500)
+};
+
+// Steps of the counters, filled by main: Pattern_2 counts up from 0x00 and Pattern_3 down from 0xFF, every 100 ms
+static LED_Step Sim_Pattern_2[SIM_COUNTER_STEPS];
+static LED_Step Sim_Pattern_3[SIM_COUNTER_STEPS];
+
+/**
+ * @brief Sim_Pattern_Info describes the steps of a pattern, as they appear on the outputs.
+ */
+typedef struct
+{
+    const char *name;
+    const LED_Step *steps;
+    uint16_t step_count;
+} Sim_Pattern_Info;
+
+// Number of steps in a step table
+#define SIM_STEP_COUNT(steps)   ((uint16_t)(sizeof(steps) / sizeof(LED_Step)))
+
+static const Sim_Pattern_Info Sim_Patterns[SIM_PATTERN_COUNT] =
+{
+    { "Pattern_1 released", Sim_Pattern_1_Released, SIM_STEP_COUNT(Sim_Pattern_1_Released) },
+    { "Pattern_1 button 1", Sim_Pattern_1_Button_1, SIM_STEP_COUNT(Sim_Pattern_1_Button_1) },
+    { "Pattern_1 button 2", Sim_Pattern_1_Button_2, SIM_STEP_COUNT(Sim_Pattern_1_Button_2) },
+    { "Pattern_1 both",     Sim_Pattern_1_Both,     SIM_STEP_COUNT(Sim_Pattern_1_Both) },
+    { "Pattern_2",          Sim_Pattern_2,          SIM_COUNTER_STEPS },
+    { "Pattern_3",          Sim_Pattern_3,          SIM_COUNTER_STEPS },
+    { "Pattern_4",          Sim_Pattern_4,          SIM_STEP_COUNT(Sim_Pattern_4) },
+    { "Pattern_5",          Sim_Pattern_5,          SIM_STEP_COUNT(Sim_Pattern_5) }
+};
+
+/**
+ * @brief Sim_Stimulus describes one input change.
+ */
+typedef struct
+{
+    uint64_t time;
+    uint8_t switches;
+    uint8_t buttons;
+} Sim_Stimulus;
+
+// Input combinations applied in random mode, one per pattern other than the base pattern
+static const Sim_Stimulus Sim_Random_Targets[SIM_PATTERN_COUNT - 1] =
+{
+    { 0, 0x00, 0x10 },
+    { 0, 0x00, 0x02 },
+    { 0, 0x00, 0x00 },
+    { 0, 0x01, 0x12 },
+    { 0, 0x02, 0x12 },
+    { 0, 0x04, 0x12 },
+    { 0, 0x08, 0x12 }
+};
+
+// Inputs of the base pattern in random mode
+#define SIM_BASE_SWITCHES       0x00
+#define SIM_BASE_BUTTONS        SIM_BUTTONS_RELEASED
+
+// Input changes of a replay file, or the next input change of the random sequence
+static Sim_Stimulus *Stimuli = 0;
+static uint32_t Stimulus_Count = 0;
+static uint32_t Stimulus_Index = 0;
+static Sim_Stimulus Random_Next;
+static uint32_t Random_Remaining = 0;
+static uint8_t Random_Next_Is_Base = 0;
+static uint32_t Random_State = 1;
+
+// Pattern selected by the current inputs, and the measurement in progress: the expected pattern
+// and the time of the input change that selected it
+static int32_t Selected_Pattern = -1;
+static int32_t Expected_Pattern = -1;
+static uint64_t Expected_Since = 0;
+
+// Pattern whose steps are checked, the step that is displayed and the time it was displayed,
+// and the last output change, which is checked once the virtual time has moved past it
+static int32_t Tracked_Pattern = -1;
+static uint16_t Tracked_Step = 0;
+static uint64_t Tracked_Since = 0;
+static uint8_t Change_Pending = 0;
+static uint64_t Change_Time = 0;
+static Sim_Outputs Change_Outputs;
+static uint32_t Step_Checks = 0;
+
+// Scenario of the run
+static Sim_Scenario Scenario;
+
+// Latencies in HFXT cycles, per pattern
+static uint32_t *Samples[SIM_PATTERN_COUNT];
+static uint32_t Sample_Counts[SIM_PATTERN_COUNT];
+static uint32_t Failures = 0;
+static uint32_t Superseded = 0;
+
+// Options
+static uint8_t Log_Outputs = 0;
+
+/**
+ * @brief The Sim_Select_Pattern function returns the pattern selected by the inputs.
+ *
+ * @param switches  The level of the switches.
+ * @param buttons   The level of the buttons.
+ *
+ * @return The index of the pattern in Sim_Patterns.
+ */
+static int32_t Sim_Select_Pattern(uint8_t switches, uint8_t buttons)
+{
+    switch(switches & 0x0F)
+    {
+        case 0x01:  return 4;
+        case 0x02:  return 5;
+        case 0x04:  return 6;
+        case 0x08:  return 7;
+        default:    break;
+    }
+    switch(buttons & 0x12)
+    {
+        case 0x10:  return 1;
+        case 0x02:  return 2;
+        case 0x00:  return 3;
+        default:    return 0;
+    }
+}
+
+/**
+ * @brief The Sim_Random function returns the next value of a 32-bit xorshift generator.
+ *
+ * @param None
+ *
+ * @return A pseudo-random value.
+ */
+static uint32_t Sim_Random(void)
+{
+    uint32_t x = Random_State;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    Random_State = x;
+    return x;
+}
+
+/**
+ * @brief The Sim_Step_Matches function compares the outputs with the outputs of a step.
+ *
+ * @param step      The step, in the packed format.
+ * @param outputs   A pointer to the outputs.
+ *
+ * @return 1 if the outputs show the step, 0 otherwise.
+ */
+static uint8_t Sim_Step_Matches(LED_Step step, const Sim_Outputs *outputs)
+{
+    return (outputs->led1 == LED_STEP_LED1(step)) && (outputs->rgb == LED_STEP_RGB(step)) &&
+           (outputs->pmod_8ld == LED_STEP_PMOD_8LD(step));
+}
+
+/**
+ * @brief The Sim_Check_Step function checks the pending output change against the next step of the tracked pattern.
+ *
+ * The steps that show the same outputs as the displayed step are skipped, and their durations are added.
+ * A deviation is counted as a failure, and the pattern is no longer tracked until its first step is displayed again.
+ *
+ * @param None
+ *
+ * @return None
+ */
+static void Sim_Check_Step(void)
+{
+    if (!Change_Pending)
+    {
+        return;
+    }
+    Change_Pending = 0;
+    if (Tracked_Pattern < 0)
+    {
+        return;
+    }
+
+    const Sim_Pattern_Info *pattern = &Sim_Patterns[Tracked_Pattern];
+    LED_Step step = pattern->steps[Tracked_Step];
+    Sim_Outputs displayed = { LED_STEP_LED1(step), LED_STEP_RGB(step), LED_STEP_PMOD_8LD(step) };
+    uint16_t index = Tracked_Step;
+    uint64_t due = Tracked_Since;
+    uint16_t skipped = 0;
+    do
+    {
+        uint16_t duration_ms = LED_STEP_DURATION_MS(pattern->steps[index]);
+        if (duration_ms == 0)
+        {
+            printf("FAIL %10.3f ms: %s changed during the held step %u\n", SIM_TO_NS(Change_Time) / 1e6,
+                   pattern->name, (unsigned)index);
+            Failures = Failures + 1;
+            Tracked_Pattern = -1;
+            return;
+        }
+        due = due + SIM_MS(duration_ms);
+        index = (uint16_t)((index + 1) % pattern->step_count);
+        skipped = skipped + 1;
+    }
+    while (Sim_Step_Matches(pattern->steps[index], &displayed) && (skipped < pattern->step_count));
+
+    if (!Sim_Step_Matches(pattern->steps[index], &Change_Outputs) || (Change_Time != due))
+    {
+        printf("FAIL %10.3f ms: %s expected step %u at %.3f ms, displayed LED1 %u  RGB %u  PMOD 8LD 0x%02X\n",
+               SIM_TO_NS(Change_Time) / 1e6, pattern->name, (unsigned)index, SIM_TO_NS(due) / 1e6,
+               Change_Outputs.led1, Change_Outputs.rgb, Change_Outputs.pmod_8ld);
+        Failures = Failures + 1;
+        Tracked_Pattern = -1;
+        return;
+    }
+    Tracked_Step = index;
+    Tracked_Since = Change_Time;
+    Step_Checks = Step_Checks + 1;
+}
+
+/**
+ * @brief The Sim_Timeout function counts the expected pattern as a failure if it has not been displayed in time.
+ *
+ * @param time The current virtual time.
+ *
+ * @return None
+ */
+static void Sim_Timeout(uint64_t time)
+{
+    if ((Expected_Pattern >= 0) && ((time - Expected_Since) >= SIM_TIMEOUT))
+    {
+        printf("FAIL %10.3f ms: %s not displayed within %u ms\n", SIM_TO_NS(time) / 1e6,
+               Sim_Patterns[Expected_Pattern].name, (unsigned)(SIM_TIMEOUT / SIM_MS(1)));
+        Failures = Failures + 1;
+        Expected_Pattern = -1;
+    }
+}
+
+/**
+ * @brief The Sim_Apply function applies an input change and starts the measurement of the new pattern.
+ *
+ * @param stimulus  A pointer to the input change.
+ * @param time      The current virtual time.
+ *
+ * @return None
+ */
+static void Sim_Apply(const Sim_Stimulus *stimulus, uint64_t time)
+{
+    Sim_Timeout(time);
+
+    // An input change that does not select a different pattern is not measured
+    int32_t pattern = Sim_Select_Pattern(stimulus->switches, stimulus->buttons);
+    if (pattern != Selected_Pattern)
+    {
+        if (Expected_Pattern >= 0)
+        {
+            Superseded = Superseded + 1;
+        }
+        Selected_Pattern = pattern;
+        Expected_Pattern = pattern;
+        Expected_Since = time;
+
+        // The steps of the previous pattern are checked until the input change, and the new pattern from its first step
+        Sim_Check_Step();
+        Tracked_Pattern = -1;
+    }
+    Sim_Set_Inputs(stimulus->buttons, stimulus->switches);
+}
+
+static uint64_t Sim_Random_Next(void)
+{
+    return (Random_Remaining > 0) ? Random_Next.time : SIM_NEVER;
+}
+
+static void Sim_Random_Stimulus(uint64_t time)
+{
+    Sim_Apply(&Random_Next, time);
+
+    // Alternate between a random target and the base inputs, until all samples are applied
+    if (Random_Next_Is_Base)
+    {
+        Random_Next = Sim_Random_Targets[Sim_Random() % (SIM_PATTERN_COUNT - 1)];
+        Random_Remaining = Random_Remaining - 1;
+    }
+    else
+    {
+        Random_Next.switches = SIM_BASE_SWITCHES;
+        Random_Next.buttons = SIM_BASE_BUTTONS;
+    }
+    Random_Next_Is_Base = !Random_Next_Is_Base;
+    Random_Next.time = time + SIM_HOLD_MIN + (Sim_Random() % SIM_HOLD_RANGE);
+}
+
+static uint64_t Sim_Replay_Next(void)
+{
+    return (Stimulus_Index < Stimulus_Count) ? Stimuli[Stimulus_Index].time : SIM_NEVER;
+}
+
+static void Sim_Replay_Stimulus(uint64_t time)
+{
+    Sim_Apply(&Stimuli[Stimulus_Index], time);
+    Stimulus_Index = Stimulus_Index + 1;
+}
+
+static void Sim_Output(uint64_t time, const Sim_Outputs *outputs)
+{
+    if (Log_Outputs)
+    {
+        printf("%10.3f ms: LED1 %u  RGB %u  PMOD 8LD 0x%02X\n", SIM_TO_NS(time) / 1e6,
+               outputs->led1, outputs->rgb, outputs->pmod_8ld);
+    }
+
+    Sim_Timeout(time);
+
+    // The frame commit writes the outputs one after the other, so only the last change made at a given time is checked
+    if (Change_Pending && (time != Change_Time))
+    {
+        Sim_Check_Step();
+    }
+    if (Tracked_Pattern >= 0)
+    {
+        Change_Pending = 1;
+        Change_Time = time;
+        Change_Outputs = *outputs;
+    }
+
+    if (Expected_Pattern < 0)
+    {
+        return;
+    }
+
+    if (Sim_Step_Matches(Sim_Patterns[Expected_Pattern].steps[0], outputs))
+    {
+        Tracked_Pattern = Expected_Pattern;
+        Tracked_Step = 0;
+        Tracked_Since = time;
+
+        if (Sample_Counts[Expected_Pattern] < SIM_MAX_SAMPLES)
+        {
+            Samples[Expected_Pattern][Sample_Counts[Expected_Pattern]] = (uint32_t)(time - Expected_Since);
+            Sample_Counts[Expected_Pattern] = Sample_Counts[Expected_Pattern] + 1;
+        }
+        Expected_Pattern = -1;
+
+        // End the run once the last input change has been measured
+        if (Scenario.next() == SIM_NEVER)
+        {
+            Sim_Stop();
+        }
+    }
+}
+
+/**
+ * @brief The Sim_Load function reads the input changes of a replay file.
+ *
+ * @param path The path of the file.
+ *
+ * @return 1 on success, 0 if the file cannot be read or contains an invalid line.
+ */
+static uint8_t Sim_Load(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == 0)
+    {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 0;
+    }
+
+    char line[128];
+    uint32_t line_number = 0;
+    uint64_t last_time = 0;
+    while (fgets(line, sizeof(line), file) != 0)
+    {
+        line_number = line_number + 1;
+        char *comment = strchr(line, '#');
+        if (comment != 0)
+        {
+            *comment = '\0';
+        }
+
+        double time_ms;
+        unsigned int switches;
+        unsigned int buttons;
+        char extra;
+        int fields = sscanf(line, "%lf %i %i %c", &time_ms, &switches, &buttons, &extra);
+        if (fields <= 0)
+        {
+            continue;
+        }
+        uint64_t time = (uint64_t)(time_ms * SIM_MS(1));
+        if ((fields != 3) || (time_ms < 0) || (time < last_time) || (Stimulus_Count >= SIM_MAX_STIMULI))
+        {
+            fprintf(stderr, "%s:%u: expected \"time_ms switches buttons\" in increasing order of time\n",
+                    path, (unsigned)line_number);
+            fclose(file);
+            return 0;
+        }
+
+        Stimuli[Stimulus_Count].time = time;
+        Stimuli[Stimulus_Count].switches = (uint8_t)switches;
+        Stimuli[Stimulus_Count].buttons = (uint8_t)buttons;
+        Stimulus_Count = Stimulus_Count + 1;
+        last_time = time;
+    }
+    fclose(file);
+    return 1;
+}
+
+static int Sim_Compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief The Sim_Report function prints the latency statistics of every pattern.
+ *
+ * @param max_us The latency limit in microseconds, or 0 for none.
+ *
+ * @return The number of samples that exceed the limit.
+ */
+static uint32_t Sim_Report(uint32_t max_us)
+{
+    uint32_t violations = 0;
+    printf("%-20s %8s %10s %10s %10s %10s\n", "Pattern", "Samples", "Min (us)", "Mean (us)", "P99 (us)", "Max (us)");
+    for (int32_t pattern = 0; pattern < SIM_PATTERN_COUNT; pattern++)
+    {
+        uint32_t count = Sample_Counts[pattern];
+        if (count == 0)
+        {
+            continue;
+        }
+
+        uint32_t *samples = Samples[pattern];
+        qsort(samples, count, sizeof(uint32_t), Sim_Compare);
+        uint64_t sum = 0;
+        for (uint32_t index = 0; index < count; index++)
+        {
+            sum = sum + samples[index];
+            if ((max_us != 0) && (SIM_TO_NS((uint64_t)samples[index]) > (uint64_t)max_us * 1000))
+            {
+                violations = violations + 1;
+            }
+        }
+
+        // Nearest-rank 99th percentile
+        uint32_t rank = (uint32_t)(((uint64_t)count * 99 + 99) / 100);
+        printf("%-20s %8u %10.1f %10.1f %10.1f %10.1f\n", Sim_Patterns[pattern].name, (unsigned)count,
+               SIM_TO_NS((uint64_t)samples[0]) / 1e3, SIM_TO_NS(sum / count) / 1e3,
+               SIM_TO_NS((uint64_t)samples[rank - 1]) / 1e3, SIM_TO_NS((uint64_t)samples[count - 1]) / 1e3);
+    }
+    printf("Steps: %u  Failures: %u  Superseded: %u  Virtual time: %.3f s\n", (unsigned)Step_Checks, (unsigned)Failures,
+           (unsigned)Superseded, SIM_TO_NS(Sim_Get_Time()) / 1e9);
+    if (max_us != 0)
+    {
+        printf("Samples above %u us: %u\n", (unsigned)max_us, (unsigned)violations);
+    }
+    return violations;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t samples = 1000;
+    uint32_t seed = 1;
+    uint32_t max_us = 0;
+    const char *path = 0;
+
+    for (int index = 1; index < argc; index++)
+    {
+        if ((strcmp(argv[index], "-n") == 0) && (index + 1 < argc))
+        {
+            samples = (uint32_t)strtoul(argv[++index], 0, 0);
+        }
+        else if ((strcmp(argv[index], "-s") == 0) && (index + 1 < argc))
+        {
+            seed = (uint32_t)strtoul(argv[++index], 0, 0);
+        }
+        else if ((strcmp(argv[index], "-m") == 0) && (index + 1 < argc))
+        {
+            max_us = (uint32_t)strtoul(argv[++index], 0, 0);
+        }
+        else if ((strcmp(argv[index], "-f") == 0) && (index + 1 < argc))
+        {
+            path = argv[++index];
+        }
+        else if (strcmp(argv[index], "-l") == 0)
+        {
+            Log_Outputs = 1;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-n samples] [-s seed] [-f file] [-m max_us] [-l]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (int32_t pattern = 0; pattern < SIM_PATTERN_COUNT; pattern++)
+    {
+        Samples[pattern] = malloc(SIM_MAX_SAMPLES * sizeof(uint32_t));
+        if (Samples[pattern] == 0)
+        {
+            return 2;
+        }
+    }
+
+    for (uint32_t index = 0; index < SIM_COUNTER_STEPS; index++)
+    {
+        Sim_Pattern_2[index] = LED_STEP(1, 0x01, index, 100);
+        Sim_Pattern_3[index] = LED_STEP(0, 0x04, 0xFF - index, 100);
+    }
+
+    Scenario.output = Sim_Output;
+    uint64_t end_time;
+
+    if (path != 0)
+    {
+        Stimuli = malloc(SIM_MAX_STIMULI * sizeof(Sim_Stimulus));
+        if ((Stimuli == 0) || !Sim_Load(path))
+        {
+            return 2;
+        }
+        Scenario.next = Sim_Replay_Next;
+        Scenario.stimulus = Sim_Replay_Stimulus;
+        end_time = ((Stimulus_Count > 0) ? Stimuli[Stimulus_Count - 1].time : 0) + SIM_TIMEOUT;
+    }
+    else
+    {
+        Random_State = (seed != 0) ? seed : 1;
+        Random_Remaining = samples;
+        Random_Next = Sim_Random_Targets[Sim_Random() % (SIM_PATTERN_COUNT - 1)];
+        Random_Next.time = SIM_START_TIME;
+        Random_Next_Is_Base = 0;
+        Scenario.next = Sim_Random_Next;
+        Scenario.stimulus = Sim_Random_Stimulus;
+        end_time = SIM_START_TIME + ((uint64_t)samples * 2 * (SIM_HOLD_MIN + SIM_HOLD_RANGE)) + SIM_TIMEOUT;
+    }
+
+    // Start from the base inputs
+    Sim_Set_Inputs(SIM_BASE_BUTTONS, SIM_BASE_SWITCHES);
+    Selected_Pattern = Sim_Select_Pattern(SIM_BASE_SWITCHES, SIM_BASE_BUTTONS);
+    Sim_Run(&Scenario, end_time);
+    Sim_Check_Step();
+    Sim_Timeout(Sim_Get_Time() + SIM_TIMEOUT);
+
+    uint32_t violations = Sim_Report(max_us);
+    return ((Failures != 0) || (violations != 0)) ? 1 : 0;
+}
@@ -0,0 +1,471 @@
+/**
+ * @file msp.h
+ * @brief Host simulation replacement for the MSP432P401R device header.
+ *
+ * This file declares the subset of the MSP432P401R registers, interrupt numbers, and CMSIS functions that
+ * is used by the GPIO program, so that the sources in GPIO/ can be compiled for the host without changes.
+ * It is found before the device header because the simulation build adds sim/ to the include path.
+ *
+ * Every peripheral pointer (P1, SysTick, TIMER32_1, ...) is obtained through Sim_Access, which lets the
+ * simulator refresh the counting registers from the virtual clock and apply pending bit-band writes
+ * before the firmware reads or writes a register. The registers themselves are plain memory.
+ *
+ * @author Michael Granberry, Abdullah Hendy, Aaron Nanas
+ */
+
+#ifndef MSP_H_
+#define MSP_H_
+
+#include <stdint.h>
+#include "Sim.h"
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+
+// ------------------------------------------------------------------------------------------------
+// Digital I/O (odd ports at even addresses, even ports one byte later, as on the device)
+
+typedef struct
+{
+    __I  uint8_t IN;        uint8_t RESERVED0;
+    __IO uint8_t OUT;       uint8_t RESERVED1;
+    __IO uint8_t DIR;       uint8_t RESERVED2;
+    __IO uint8_t REN;       uint8_t RESERVED3;
+    __IO uint8_t DS;        uint8_t RESERVED4;
+    __IO uint8_t SEL0;      uint8_t RESERVED5;
+    __IO uint8_t SEL1;      uint8_t RESERVED6;
+    __I  uint16_t IV;
+    uint8_t RESERVED7[6];
+    __IO uint8_t SELC;      uint8_t RESERVED8;
+    __IO uint8_t IES;       uint8_t RESERVED9;
+    __IO uint8_t IE;        uint8_t RESERVED10;
+    __IO uint8_t IFG;       uint8_t RESERVED11;
+} DIO_PORT_Odd_Interruptable_Type;
+
+typedef struct
+{
+    uint8_t RESERVED0;      __I  uint8_t IN;
+    uint8_t RESERVED1;      __IO uint8_t OUT;
+    uint8_t RESERVED2;      __IO uint8_t DIR;
+    uint8_t RESERVED3;      __IO uint8_t REN;
+    uint8_t RESERVED4;      __IO uint8_t DS;
+    uint8_t RESERVED5;      __IO uint8_t SEL0;
+    uint8_t RESERVED6;      __IO uint8_t SEL1;
+    uint8_t RESERVED7[9];
+    __IO uint8_t SELC;      uint8_t RESERVED8;
+    __IO uint8_t IES;       uint8_t RESERVED9;
+    __IO uint8_t IE;        uint8_t RESERVED10;
+    __IO uint8_t IFG;
+    __I  uint16_t IV;
+} DIO_PORT_Even_Interruptable_Type;
+
+typedef DIO_PORT_Odd_Interruptable_Type DIO_PORT_Odd_Type;
+typedef DIO_PORT_Even_Interruptable_Type DIO_PORT_Even_Type;
+
+extern uint8_t Sim_DIO[0x140];
+
+#define P1          ((DIO_PORT_Odd_Interruptable_Type *)Sim_Access(&Sim_DIO[0x000]))
+#define P2          ((DIO_PORT_Even_Interruptable_Type *)Sim_Access(&Sim_DIO[0x000]))
+#define P3          ((DIO_PORT_Odd_Interruptable_Type *)Sim_Access(&Sim_DIO[0x020]))
+#define P4          ((DIO_PORT_Even_Interruptable_Type *)Sim_Access(&Sim_DIO[0x020]))
+#define P5          ((DIO_PORT_Odd_Interruptable_Type *)Sim_Access(&Sim_DIO[0x040]))
+#define P6          ((DIO_PORT_Even_Interruptable_Type *)Sim_Access(&Sim_DIO[0x040]))
+#define P7          ((DIO_PORT_Odd_Type *)Sim_Access(&Sim_DIO[0x060]))
+#define P8          ((DIO_PORT_Even_Type *)Sim_Access(&Sim_DIO[0x060]))
+#define P9          ((DIO_PORT_Odd_Type *)Sim_Access(&Sim_DIO[0x080]))
+#define P10         ((DIO_PORT_Even_Type *)Sim_Access(&Sim_DIO[0x080]))
+#define PJ          ((DIO_PORT_Odd_Type *)Sim_Access(&Sim_DIO[0x120]))
+
+typedef struct
+{
+    __IO uint16_t KEYID;
+    __IO uint16_t CTL;
+} PMAP_COMMON_Type;
+
+typedef struct
+{
+    __IO uint8_t PMAP_REGISTER0;
+    __IO uint8_t PMAP_REGISTER1;
+    __IO uint8_t PMAP_REGISTER2;
+    __IO uint8_t PMAP_REGISTER3;
+    __IO uint8_t PMAP_REGISTER4;
+    __IO uint8_t PMAP_REGISTER5;
+    __IO uint8_t PMAP_REGISTER6;
+    __IO uint8_t PMAP_REGISTER7;
+} PMAP_REGISTER_Type;
+
+extern PMAP_COMMON_Type Sim_PMAP;
+extern PMAP_REGISTER_Type Sim_P2MAP;
+
+#define PMAP        ((PMAP_COMMON_Type *)Sim_Access(&Sim_PMAP))
+#define P2MAP       ((PMAP_REGISTER_Type *)Sim_Access(&Sim_P2MAP))
+
+// ------------------------------------------------------------------------------------------------
+// Cortex-M4 core peripherals
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __I  uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct
+{
+    __I  uint32_t CPUID;
+    __IO uint32_t ICSR;
+    __IO uint32_t VTOR;
+    __IO uint32_t AIRCR;
+    __IO uint32_t SCR;
+    __IO uint32_t CCR;
+    __IO uint8_t  SHP[12];
+} SCB_Type;
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    __IO uint32_t DHCSR;
+    __O  uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern SysTick_Type Sim_SysTick;
+extern SCB_Type Sim_SCB;
+extern DWT_Type Sim_DWT;
+extern CoreDebug_Type Sim_CoreDebug;
+
+#define SysTick     ((SysTick_Type *)Sim_Access(&Sim_SysTick))
+#define SCB         ((SCB_Type *)Sim_Access(&Sim_SCB))
+#define DWT         ((DWT_Type *)Sim_Access(&Sim_DWT))
+#define CoreDebug   ((CoreDebug_Type *)Sim_Access(&Sim_CoreDebug))
+
+#define SCB_ICSR_PENDSTSET_Msk          (1UL << 26)
+#define SCB_ICSR_PENDSVSET_Msk          (1UL << 28)
+#define SCB_SCR_SLEEPONEXIT_Msk         (1UL << 1)
+#define SCB_SCR_SLEEPDEEP_Msk           (1UL << 2)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL << 0)
+
+// ------------------------------------------------------------------------------------------------
+// Power, clock, and flash control
+
+typedef struct
+{
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t IE;
+    __I  uint32_t IFG;
+    __O  uint32_t CLRIFG;
+} PCM_Type;
+
+typedef struct
+{
+    __IO uint32_t KEY;
+    __IO uint32_t CTL0;
+    __IO uint32_t CTL1;
+    __IO uint32_t CTL2;
+    __IO uint32_t CTL3;
+    __IO uint32_t CLKEN;
+    __I  uint32_t STAT;
+    __IO uint32_t IE;
+    __I  uint32_t IFG;
+    __O  uint32_t CLRIFG;
+    __O  uint32_t SETIFG;
+} CS_Type;
+
+typedef struct
+{
+    __I  uint32_t POWER_STAT;
+    __IO uint32_t BANK0_RDCTL;
+    __IO uint32_t BANK1_RDCTL;
+    __IO uint32_t PRG_CTLSTAT;
+    __IO uint32_t ERASE_CTLSTAT;
+    __IO uint32_t ERASE_SECTADDR;
+    __IO uint32_t BANK0_INFO_WEPROT;
+    __I  uint32_t IFG;
+    __O  uint32_t CLRIFG;
+} FLCTL_Type;
+
+extern PCM_Type Sim_PCM;
+extern CS_Type Sim_CS;
+extern FLCTL_Type Sim_FLCTL;
+
+#define PCM         ((PCM_Type *)Sim_Access(&Sim_PCM))
+#define CS          ((CS_Type *)Sim_Access(&Sim_CS))
+#define FLCTL       ((FLCTL_Type *)Sim_Access(&Sim_FLCTL))
+
+#define FLCTL_BANK0_RDCTL_WAIT_2        0x00002000
+#define FLCTL_BANK1_RDCTL_WAIT_2        0x00002000
+#define FLCTL_BANK0_RDCTL_WAIT_MASK     0x0000F000
+#define FLCTL_BANK0_RDCTL_WAIT_OFS      12
+#define FLCTL_BANK1_RDCTL_WAIT_MASK     0x0000F000
+#define FLCTL_BANK1_RDCTL_WAIT_OFS      12
+#define FLCTL_PRG_CTLSTAT_ENABLE        0x00000001
+#define FLCTL_PRG_CTLSTAT_MODE          0x00000002
+#define FLCTL_PRG_CTLSTAT_VER_PST       0x00000008
+#define FLCTL_PRG_CTLSTAT_STATUS_MASK   0x00030000
+#define FLCTL_PRG_CTLSTAT_STATUS_1      0x00010000
+#define FLCTL_PRG_CTLSTAT_STATUS_2      0x00020000
+#define FLCTL_ERASE_CTLSTAT_START       0x00000001
+#define FLCTL_ERASE_CTLSTAT_TYPE_1      0x00000004
+#define FLCTL_ERASE_CTLSTAT_STATUS_MASK 0x00030000
+#define FLCTL_ERASE_CTLSTAT_STATUS_1    0x00010000
+#define FLCTL_ERASE_CTLSTAT_STATUS_2    0x00020000
+#define FLCTL_ERASE_CTLSTAT_ADDR_ERR    0x00040000
+#define FLCTL_ERASE_CTLSTAT_CLR_STAT    0x00080000
+#define FLCTL_BANK0_INFO_WEPROT_PROT0   0x00000001
+#define FLCTL_IFG_AVPST                 0x00000004
+#define FLCTL_IFG_PRG                   0x00000008
+#define FLCTL_IFG_PRG_ERR               0x00000200
+
+// Sector 0 of INFO bank 0, read in place by the ConfigStore driver. It is erased (0xFF) by Sim_Run.
+// The program writes of the flash words go to the array directly, and a sector erase completes immediately.
+extern uint8_t Sim_INFO_Flash[4096];
+
+// ------------------------------------------------------------------------------------------------
+// CRC32 module. DI32 is 32 bits wide here, so the simulator can tell a pending data write
+// (SIM_CRC32_NO_DATA when there is none) from a repeated value.
+
+#define SIM_CRC32_NO_DATA   0xFFFFFFFF
+
+typedef struct
+{
+    __IO uint32_t DI32;
+    __IO uint16_t DIRB32;
+    uint16_t RESERVED1;
+    __IO uint16_t INIRES32_LO;
+    __IO uint16_t INIRES32_HI;
+    __IO uint16_t RESR32_LO;
+    __IO uint16_t RESR32_HI;
+} CRC32_Type;
+
+extern CRC32_Type Sim_CRC32;
+
+#define CRC32       ((CRC32_Type *)Sim_Access(&Sim_CRC32))
+
+// ------------------------------------------------------------------------------------------------
+// Timers
+
+typedef struct
+{
+    __IO uint32_t LOAD;
+    __I  uint32_t VALUE;
+    __IO uint32_t CONTROL;
+    __O  uint32_t INTCLR;
+    __I  uint32_t RIS;
+    __I  uint32_t MIS;
+    __IO uint32_t BGLOAD;
+} Timer32_Type;
+
+typedef struct
+{
+    __IO uint16_t CTL;
+    __IO uint16_t CCTL[7];
+    __IO uint16_t R;
+    __IO uint16_t CCR[7];
+    uint16_t RESERVED0;
+    __IO uint16_t EX0;
+    uint16_t RESERVED1[6];
+    __I  uint16_t IV;
+} Timer_A_Type;
+
+typedef struct
+{
+    __IO uint16_t CTL0;
+    __IO uint16_t CTL13;
+    __IO uint16_t OCAL;
+    __IO uint16_t TCMP;
+    __IO uint16_t PS0CTL;
+    __IO uint16_t PS1CTL;
+    __IO uint16_t PS;
+    __I  uint16_t IV;
+} RTC_C_Type;
+
+extern Timer32_Type Sim_TIMER32_1;
+extern Timer32_Type Sim_TIMER32_2;
+extern Timer_A_Type Sim_TIMER_A[4];
+extern RTC_C_Type Sim_RTC_C;
+
+#define TIMER32_1   ((Timer32_Type *)Sim_Access(&Sim_TIMER32_1))
+#define TIMER32_2   ((Timer32_Type *)Sim_Access(&Sim_TIMER32_2))
+#define TIMER_A0    ((Timer_A_Type *)Sim_Access(&Sim_TIMER_A[0]))
+#define TIMER_A1    ((Timer_A_Type *)Sim_Access(&Sim_TIMER_A[1]))
+#define TIMER_A2    ((Timer_A_Type *)Sim_Access(&Sim_TIMER_A[2]))
+#define TIMER_A3    ((Timer_A_Type *)Sim_Access(&Sim_TIMER_A[3]))
+#define RTC_C       ((RTC_C_Type *)Sim_Access(&Sim_RTC_C))
+
+// ------------------------------------------------------------------------------------------------
+// DMA controller and eUSCI_A0 (registers only, the transfers are not simulated)
+
+typedef struct
+{
+    __I  uint32_t STAT;
+    __O  uint32_t CFG;
+    __IO uint32_t CTLBASE;
+    __I  uint32_t ALTBASE;
+    __I  uint32_t WAITSTAT;
+    __O  uint32_t SWREQ;
+    __IO uint32_t USEBURSTSET;
+    __O  uint32_t USEBURSTCLR;
+    __IO uint32_t REQMASKSET;
+    __O  uint32_t REQMASKCLR;
+    __IO uint32_t ENASET;
+    __O  uint32_t ENACLR;
+    __IO uint32_t ALTSET;
+    __O  uint32_t ALTCLR;
+    __IO uint32_t PRIOSET;
+    __O  uint32_t PRIOCLR;
+    uint32_t RESERVED0[3];
+    __IO uint32_t ERRCLR;
+} DMA_Control_Type;
+
+typedef struct
+{
+    __I  uint32_t DEVICE_CFG;
+    __IO uint32_t SW_CHTRIG;
+    uint32_t RESERVED0[2];
+    __IO uint32_t CH_SRCCFG[32];
+    uint32_t RESERVED1[28];
+    __IO uint32_t INT1_SRCCFG;
+    __IO uint32_t INT2_SRCCFG;
+    __IO uint32_t INT3_SRCCFG;
+    uint32_t RESERVED2;
+    __I  uint32_t INT0_SRCFLG;
+    __O  uint32_t INT0_CLRFLG;
+} DMA_Channel_Type;
+
+typedef struct
+{
+    __IO uint16_t CTLW0;
+    __IO uint16_t CTLW1;
+    uint16_t RESERVED0;
+    __IO uint16_t BRW;
+    __IO uint16_t MCTLW;
+    __IO uint16_t STATW;
+    __I  uint16_t RXBUF;
+    __IO uint16_t TXBUF;
+    __IO uint16_t ABCTL;
+    __IO uint16_t IRCTL;
+    uint16_t RESERVED1[3];
+    __IO uint16_t IE;
+    __IO uint16_t IFG;
+    __I  uint16_t IV;
+} EUSCI_A_Type;
+
+extern DMA_Control_Type Sim_DMA_Control;
+extern DMA_Channel_Type Sim_DMA_Channel;
+extern EUSCI_A_Type Sim_EUSCI_A0;
+
+#define DMA_Control ((DMA_Control_Type *)Sim_Access(&Sim_DMA_Control))
+#define DMA_Channel ((DMA_Channel_Type *)Sim_Access(&Sim_DMA_Channel))
+#define EUSCI_A0    ((EUSCI_A_Type *)Sim_Access(&Sim_EUSCI_A0))
+
+// ------------------------------------------------------------------------------------------------
+// Watchdog timer and reset controller (registers only, the watchdog never expires)
+
+typedef struct
+{
+    uint16_t RESERVED0[6];
+    __IO uint16_t CTL;
+} WDT_A_Type;
+
+typedef struct
+{
+    __IO uint32_t RESET_REQ;
+    __I  uint32_t HARDRESET_STAT;
+    __IO uint32_t HARDRESET_CLR;
+    __IO uint32_t HARDRESET_SET;
+    __I  uint32_t SOFTRESET_STAT;
+    __IO uint32_t SOFTRESET_CLR;
+    __IO uint32_t SOFTRESET_SET;
+} RSTCTL_Type;
+
+extern WDT_A_Type Sim_WDT_A;
+extern RSTCTL_Type Sim_RSTCTL;
+
+#define WDT_A       ((WDT_A_Type *)Sim_Access(&Sim_WDT_A))
+#define RSTCTL      ((RSTCTL_Type *)Sim_Access(&Sim_RSTCTL))
+
+#define WDT_A_CTL_PW                    0x5A00
+#define WDT_A_CTL_SSEL__ACLK            0x0020
+#define WDT_A_CTL_CNTCL                 0x0008
+#define WDT_A_CTL_HOLD                  0x0080
+#define WDT_A_CTL_IS_5                  0x0005
+#define RSTCTL_HARDRESET_STAT_SRC1      0x00000002
+#define RSTCTL_SOFTRESET_STAT_SRC1      0x00000002
+
+// ------------------------------------------------------------------------------------------------
+// Bit-band alias of a peripheral register bit, backed by a shadow word that is written back on the next access
+
+#define BITBAND_PERI(x, b)  (*Sim_Bitband(&(x), sizeof(x), (b)))
+
+// ------------------------------------------------------------------------------------------------
+// Interrupts and CMSIS functions
+
+typedef enum
+{
+    PendSV_IRQn     = -2,
+    SysTick_IRQn    = -1,
+    PSS_IRQn        = 0,
+    CS_IRQn         = 1,
+    PCM_IRQn        = 2,
+    WDT_A_IRQn      = 3,
+    COMP_E0_IRQn    = 6,
+    COMP_E1_IRQn    = 7,
+    TA0_0_IRQn      = 8,
+    TA0_N_IRQn      = 9,
+    TA1_0_IRQn      = 10,
+    TA1_N_IRQn      = 11,
+    TA2_0_IRQn      = 12,
+    TA2_N_IRQn      = 13,
+    TA3_0_IRQn      = 14,
+    TA3_N_IRQn      = 15,
+    EUSCIA0_IRQn    = 16,
+    T32_INT1_IRQn   = 25,
+    T32_INT2_IRQn   = 26,
+    RTC_C_IRQn      = 29,
+    DMA_ERR_IRQn    = 30,
+    DMA_INT3_IRQn   = 31,
+    DMA_INT2_IRQn   = 32,
+    DMA_INT1_IRQn   = 33,
+    DMA_INT0_IRQn   = 34,
+    PORT1_IRQn      = 35,
+    PORT2_IRQn      = 36
+} IRQn_Type;
+
+extern uint32_t SystemCoreClock;
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+
+void __enable_irq(void);
+void __disable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __WFI(void);
+
+// The simulated core is single-threaded and only takes interrupts at the simulator hooks,
+// so an exclusive store never fails
+static inline uint32_t __LDREXW(volatile uint32_t *address)
+{
+    return *address;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *address)
+{
+    *address = value;
+    return 0;
+}
+
+#endif /* MSP_H_ */